@@ -37,10 +37,17 @@
 #ifndef logger_h_
 #define logger_h_
 
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "../log-sink.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 #ifdef _WIN32
 
 void enable_virtual_terminal_processing(void);
@@ -67,6 +74,43 @@ enum calc_limit {
     CALCULATION_MINIMUM = 1   /* If a calculation is below this amount, trigger an event */
 };
 
+/**
+ * @brief Thresholds a result can cross, used to index per-threshold statistics
+ */
+enum log_threshold
+{
+    LOG_THRESHOLD_MAXIMUM = 0, /* Result above the maximum, CALCULATION_MAXIMUM by default */
+    LOG_THRESHOLD_MINIMUM,     /* Result below the minimum, CALCULATION_MINIMUM by default */
+    LOG_THRESHOLD_COUNT
+};
+
+#define LOG_THRESHOLD_NONE (-1) /* Result within both thresholds */
+
+/**
+ * @brief When threshold events are fired
+ */
+enum log_trigger
+{
+    LOG_TRIGGER_LEVEL = 0, /* On every result beyond a threshold, as with the compile-time limits */
+    LOG_TRIGGER_EDGE       /* Only when a result moves into a different band */
+};
+
+/**
+ * @brief Per-module thresholds, attached through log_module.thresholds
+ *
+ * The limits may be changed at any time with log_thresholds_set(). A result leaves a band it is in
+ * only once it is hysteresis back inside the threshold, so a noisy signal sitting on a boundary
+ * stays in one band instead of flipping on every sample.
+ */
+struct log_thresholds
+{
+    long long maximum;        /* Results above this are beyond LOG_THRESHOLD_MAXIMUM */
+    long long minimum;        /* Results below this are beyond LOG_THRESHOLD_MINIMUM */
+    long long hysteresis;     /* Width of the band that must be cleared to leave a threshold, 0 for none */
+    enum log_trigger trigger; /* Level or edge triggered events */
+    int state;                /* Band of the last result: a log_threshold or LOG_THRESHOLD_NONE */
+};
+
 #define BBLK "\x1B[1;30m"
 #define BRED "\x1B[1;31m"
 #define BGRN "\x1B[1;32m"
@@ -91,13 +135,42 @@ static const char *INFO_MSG = BBLU "LOG" RESET_TEXT;
 
 #pragma GCC diagnostic pop
 
-// Define log macros
-#define LOG_MSG(label, message) \
-    printf("%s %s: " BWHT "%s" RESET_TEXT "\n", label, INFO_MSG, message)
-#define LOG_ERROR(label, message) \
-    printf("%s %s: " BWHT "%s" RESET_TEXT "\n", label, ERROR_MSG, message)
-#define LOG_WARNING(label, message) \
-    printf("%s %s: " BWHT "%s" RESET_TEXT "\n", label, WARNING_MSG, message)
+// Define log macros; records go to the active log sink (stdout by default), in the lane of their severity
+#define LOG_MSG_UNPROFILED(label, message) \
+    log_printf_level(LOG_LEVEL_INFO, "%s %s: " BWHT "%s" RESET_TEXT "\n", label, INFO_MSG, message)
+#define LOG_ERROR_UNPROFILED(label, message) \
+    log_printf_level(LOG_LEVEL_CRITICAL, "%s %s: " BWHT "%s" RESET_TEXT "\n", label, ERROR_MSG, message)
+#define LOG_WARNING_UNPROFILED(label, message) \
+    log_printf_level(LOG_LEVEL_WARNING, "%s %s: " BWHT "%s" RESET_TEXT "\n", label, WARNING_MSG, message)
+
+#ifdef EATL_LOG_SAMPLING
+
+#include "../log-sample.h"
+
+/* Hot sites drop to 1-in-N once they exceed the sampling budget; errors are always logged */
+#undef LOG_MSG_UNPROFILED
+#undef LOG_WARNING_UNPROFILED
+#define LOG_MSG_UNPROFILED(label, message) LOG_MSG_SAMPLED(label, message)
+#define LOG_WARNING_UNPROFILED(label, message) LOG_WARNING_SAMPLED(label, message)
+
+#endif /* EATL_LOG_SAMPLING */
+
+#ifdef EATL_DWT_PROFILE
+
+#include "../dwt-profile.h"
+
+/* Every call site gets its own cycle statistics, keyed by file and line */
+#define LOG_MSG(label, message) DWT_PROFILE(DWT_PROFILE_HERE, LOG_MSG_UNPROFILED(label, message))
+#define LOG_ERROR(label, message) DWT_PROFILE(DWT_PROFILE_HERE, LOG_ERROR_UNPROFILED(label, message))
+#define LOG_WARNING(label, message) DWT_PROFILE(DWT_PROFILE_HERE, LOG_WARNING_UNPROFILED(label, message))
+
+#else
+
+#define LOG_MSG(label, message) LOG_MSG_UNPROFILED(label, message)
+#define LOG_ERROR(label, message) LOG_ERROR_UNPROFILED(label, message)
+#define LOG_WARNING(label, message) LOG_WARNING_UNPROFILED(label, message)
+
+#endif /* EATL_DWT_PROFILE */
 
 // Define packed attribute for structs
 #define PACKED __attribute__((packed))
@@ -105,6 +178,8 @@ static const char *INFO_MSG = BBLU "LOG" RESET_TEXT;
 // Define a callback type for logging functions
 typedef void (*logcallback)(const char *);
 
+struct log_aggregate;
+
 /**
  * @brief Holds the logger module's information
  * 
@@ -119,6 +194,9 @@ struct log_module
 {
     const char *module_name;
     logcallback callback;
+    struct log_aggregate *aggregate;    /* Optional; when set, results are summarized per window (log-aggregate.h) */
+    struct log_thresholds *thresholds;  /* Optional; NULL uses CALCULATION_MINIMUM/MAXIMUM, level triggered */
+    uint32_t sample_budget;             /* Optional; events per second per thread before they are sampled (log-sample.h) */
 
     /* In production environments, the programmer may add more callback functions to handle multiple events. */
 } PACKED;
@@ -171,12 +249,26 @@ struct log_message
  */
 static void event_occured(struct log_module *module, const char *message);
 
+/**
+ * @brief Delivers an event to a module the way perform_calculation() does
+ *
+ * Applies the module's sample_budget, tagging sampled events "[sampled 1/N]", records the event in
+ * a trace when tracing is on, and hands it to the callback, or logs the module name without one.
+ * Also the event path of the C++ front end, eatl::event().
+ *
+ * @param module Module containing the module name and callback function(s)
+ * @param message Message to be passed onto the registered callback function
+ * @return int | 0 for success -1 for failure
+ */
+int log_event(const struct log_module *module, const char *message);
+
 /**
  * @brief Performs a calculation
  * 
  * This function performs a calculation and compares it to two thresholds CALCULATION_MINIMUM 
  * & CALCULATION_MAXIMUM to assess if any bounds are crossed. If any bounds are crossed, it calls the event_occured
- * function to handle it accordingly.
+ * function to handle it accordingly. A module with its own log_thresholds is compared against those
+ * instead, and in LOG_TRIGGER_EDGE mode only changes of band are reported.
  * 
  * @param module Module containing the log name and callback function(s)
  * @param a      First element to be multiplied
@@ -185,4 +277,34 @@ static void event_occured(struct log_module *module, const char *message);
  */
 long long perform_calculation(struct log_module *module, long long a, long long b);
 
+/**
+ * @brief Prepares thresholds for a module, starting within both of them
+ *
+ * @param thresholds Thresholds to initialize
+ * @param minimum    Lower threshold
+ * @param maximum    Upper threshold, not below minimum
+ * @param hysteresis Band that must be cleared to leave a threshold, not negative
+ * @param trigger    Level or edge triggered events
+ * @return int | 0 for success -1 for failure
+ */
+int log_thresholds_init(struct log_thresholds *thresholds, long long minimum, long long maximum, long long hysteresis,
+                        enum log_trigger trigger);
+
+/**
+ * @brief Changes the limits of a module at runtime
+ *
+ * The current band is kept; the next result is classified against the new limits.
+ *
+ * @param module     Module with attached thresholds
+ * @param minimum    Lower threshold
+ * @param maximum    Upper threshold, not below minimum
+ * @param hysteresis Band that must be cleared to leave a threshold, not negative
+ * @return int | 0 for success -1 for failure
+ */
+int log_thresholds_set(struct log_module *module, long long minimum, long long maximum, long long hysteresis);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* logger_h_ */
\ No newline at end of file
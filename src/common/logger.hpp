@@ -0,0 +1,858 @@
+/**
+ * @file logger.hpp
+ * @brief C++20 logger front end with compile-time format checking
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef logger_hpp_
+#define logger_hpp_
+
+#if __cplusplus < 202002L
+#error "logger.hpp needs C++20 (consteval and class type template parameters)"
+#endif
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "logger.h"
+
+/**
+ * @brief C++ front end for the logger
+ *
+ * The format string is a template argument, parsed once by the compiler:
+ *
+ *     eatl::log<"sensor %s read %.2f after %u retries\n">(name, value, retries);
+ *
+ * Placeholders are checked against the argument types at compile time, and a mismatch fails the
+ * build. Each call site gets its own serializer, unrolled from the parsed placeholders, which writes
+ * into a stack buffer whose size is fixed at compile time. Nothing is parsed at run time and nothing
+ * is allocated. Records go through log_record_level(), so sinks, staging, severity lanes and the C
+ * macros are shared.
+ *
+ * Supported: flags '-' and '0', a width, a precision for f and s, the length modifiers hh, h, l,
+ * ll and z, and the conversions d i u x X f s c p and %%. %f is the one conversion handed to
+ * snprintf, with a spec string that is itself assembled at compile time.
+ */
+namespace eatl
+{
+
+/**
+ * @brief A string literal usable as a template argument
+ */
+template <std::size_t N>
+struct format_string
+{
+    char text[N]{};
+
+    consteval format_string(const char (&literal)[N])
+    {
+        for (std::size_t i = 0; i < N; i++)
+        {
+            text[i] = literal[i];
+        }
+    }
+
+    constexpr std::size_t length() const
+    {
+        return N - 1;
+    }
+};
+
+namespace detail
+{
+
+/* Never defined: reaching it while the compiler evaluates a format is the compile error */
+void format_error(const char *reason);
+
+enum class conversion : unsigned char
+{
+    signed_integer,
+    unsigned_integer,
+    hex_lower,
+    hex_upper,
+    floating,
+    string,
+    character,
+    pointer
+};
+
+enum class length_modifier : unsigned char
+{
+    none,
+    hh,
+    h,
+    l,
+    ll,
+    z
+};
+
+struct placeholder
+{
+    conversion kind = conversion::signed_integer;
+    length_modifier length = length_modifier::none;
+    bool left_align = false;
+    bool zero_pad = false;
+    unsigned width = 0;
+    int precision = -1;           /* -1 when not given */
+    std::size_t literal_end = 0;  /* Literal bytes written before this placeholder */
+};
+
+template <std::size_t Placeholders, std::size_t Literal>
+struct parsed_format
+{
+    std::array<placeholder, Placeholders> placeholders{};
+    std::array<char, Literal> literal{}; /* Text between the placeholders, with %% unescaped */
+    std::size_t literal_length = 0;
+};
+
+template <std::size_t N>
+consteval std::size_t count_placeholders(const format_string<N> &format)
+{
+    std::size_t count = 0;
+
+    for (std::size_t i = 0; i < format.length(); i++)
+    {
+        if (format.text[i] != '%')
+        {
+            continue;
+        }
+        if (i + 1 >= format.length())
+        {
+            format_error("format ends with a lone '%'");
+        }
+        if (format.text[i + 1] == '%')
+        {
+            i++;
+            continue;
+        }
+        count++;
+    }
+    return count;
+}
+
+template <std::size_t Placeholders, std::size_t N>
+consteval parsed_format<Placeholders, N> parse_format(const format_string<N> &format)
+{
+    parsed_format<Placeholders, N> result;
+    std::size_t next = 0;
+    std::size_t i = 0;
+
+    while (i < format.length())
+    {
+        char c = format.text[i++];
+        if (c != '%')
+        {
+            result.literal[result.literal_length++] = c;
+            continue;
+        }
+        if (format.text[i] == '%')
+        {
+            result.literal[result.literal_length++] = '%';
+            i++;
+            continue;
+        }
+
+        placeholder item;
+        for (;; i++)
+        {
+            if (format.text[i] == '-')
+            {
+                item.left_align = true;
+            }
+            else if (format.text[i] == '0')
+            {
+                item.zero_pad = true;
+            }
+            else
+            {
+                break;
+            }
+        }
+        while (format.text[i] >= '0' && format.text[i] <= '9')
+        {
+            item.width = item.width * 10 + (unsigned)(format.text[i++] - '0');
+        }
+        if (format.text[i] == '.')
+        {
+            i++;
+            item.precision = 0;
+            while (format.text[i] >= '0' && format.text[i] <= '9')
+            {
+                item.precision = item.precision * 10 + (format.text[i++] - '0');
+            }
+        }
+        if (format.text[i] == '*')
+        {
+            format_error("'*' widths and precisions are not supported");
+        }
+
+        if (format.text[i] == 'h')
+        {
+            i++;
+            item.length = length_modifier::h;
+            if (format.text[i] == 'h')
+            {
+                i++;
+                item.length = length_modifier::hh;
+            }
+        }
+        else if (format.text[i] == 'l')
+        {
+            i++;
+            item.length = length_modifier::l;
+            if (format.text[i] == 'l')
+            {
+                i++;
+                item.length = length_modifier::ll;
+            }
+        }
+        else if (format.text[i] == 'z')
+        {
+            i++;
+            item.length = length_modifier::z;
+        }
+
+        switch (format.text[i++])
+        {
+        case 'd':
+        case 'i':
+            item.kind = conversion::signed_integer;
+            break;
+        case 'u':
+            item.kind = conversion::unsigned_integer;
+            break;
+        case 'x':
+            item.kind = conversion::hex_lower;
+            break;
+        case 'X':
+            item.kind = conversion::hex_upper;
+            break;
+        case 'f':
+            item.kind = conversion::floating;
+            break;
+        case 's':
+            item.kind = conversion::string;
+            break;
+        case 'c':
+            item.kind = conversion::character;
+            break;
+        case 'p':
+            item.kind = conversion::pointer;
+            break;
+        default:
+            format_error("unsupported conversion");
+        }
+
+        if (item.precision >= 0 && item.kind != conversion::floating && item.kind != conversion::string)
+        {
+            format_error("a precision is only supported for %f and %s");
+        }
+        if (item.length != length_modifier::none && item.kind != conversion::signed_integer &&
+            item.kind != conversion::unsigned_integer && item.kind != conversion::hex_lower &&
+            item.kind != conversion::hex_upper && !(item.kind == conversion::floating && item.length == length_modifier::l))
+        {
+            format_error("length modifier on a conversion that does not take one");
+        }
+        if (item.kind == conversion::floating && item.precision > 30)
+        {
+            format_error("%f precision above 30");
+        }
+
+        item.literal_end = result.literal_length;
+        result.placeholders[next++] = item;
+    }
+    return result;
+}
+
+template <format_string Format>
+struct compiled
+{
+    static constexpr std::size_t placeholder_count = count_placeholders(Format);
+    static constexpr auto table = parse_format<placeholder_count>(Format);
+};
+
+template <typename T>
+inline constexpr bool is_string_argument =
+    std::is_convertible_v<const T &, std::string_view> || std::is_same_v<std::decay_t<T>, const char *> ||
+    std::is_same_v<std::decay_t<T>, char *>;
+
+constexpr std::size_t modifier_size(length_modifier length)
+{
+    switch (length)
+    {
+    case length_modifier::hh:
+    case length_modifier::h:
+    case length_modifier::none:
+        return sizeof(int);
+    case length_modifier::l:
+        return sizeof(long);
+    case length_modifier::ll:
+        return sizeof(long long);
+    case length_modifier::z:
+        return sizeof(std::size_t);
+    }
+    return 0;
+}
+
+template <typename T>
+consteval void check_argument(const placeholder &item)
+{
+    switch (item.kind)
+    {
+    case conversion::signed_integer:
+    case conversion::unsigned_integer:
+    case conversion::hex_lower:
+    case conversion::hex_upper:
+        if constexpr (!std::is_integral_v<T> && !std::is_enum_v<T>)
+        {
+            format_error("integer placeholder given a non-integer argument");
+        }
+        else if (item.length == length_modifier::none || item.length == length_modifier::h ||
+                 item.length == length_modifier::hh)
+        {
+            if (sizeof(T) > sizeof(int))
+            {
+                format_error("argument is wider than int; add an l, ll or z length modifier");
+            }
+        }
+        else if (sizeof(T) != modifier_size(item.length))
+        {
+            format_error("argument size does not match the length modifier");
+        }
+        break;
+    case conversion::floating:
+        if constexpr (!std::is_same_v<T, double> && !std::is_same_v<T, float>)
+        {
+            format_error("%f placeholder given an argument that is not float or double");
+        }
+        break;
+    case conversion::string:
+        if constexpr (!is_string_argument<T>)
+        {
+            format_error("%s placeholder given an argument that is not a string");
+        }
+        break;
+    case conversion::character:
+        if constexpr (!std::is_integral_v<T>)
+        {
+            format_error("%c placeholder given a non-integer argument");
+        }
+        else if (sizeof(T) > sizeof(int))
+        {
+            format_error("%c argument is wider than int");
+        }
+        break;
+    case conversion::pointer:
+        if constexpr (!std::is_pointer_v<T> && !std::is_null_pointer_v<T>)
+        {
+            format_error("%p placeholder given a non-pointer argument");
+        }
+        break;
+    }
+}
+
+template <format_string Format, typename... Args>
+consteval bool check_arguments()
+{
+    constexpr const auto &table = compiled<Format>::table;
+    std::size_t next = 0;
+
+    if (sizeof...(Args) != table.placeholders.size())
+    {
+        format_error("number of arguments does not match the placeholders");
+    }
+    (check_argument<std::remove_cvref_t<Args>>(table.placeholders[next++]), ...);
+    return true;
+}
+
+/* Decimal digits of the widest value of a given byte size */
+constexpr std::size_t decimal_digits(std::size_t bytes)
+{
+    return bytes <= 1 ? 3 : bytes <= 2 ? 5 : bytes <= 4 ? 10 : 20;
+}
+
+/* Longest rendering of one placeholder, 0 for strings without a precision, which have no bound */
+template <typename T>
+constexpr std::size_t placeholder_bound(const placeholder &item)
+{
+    std::size_t bound = 0;
+
+    switch (item.kind)
+    {
+    case conversion::signed_integer:
+    case conversion::unsigned_integer:
+        bound = 1 + decimal_digits(modifier_size(item.length));
+        break;
+    case conversion::hex_lower:
+    case conversion::hex_upper:
+        bound = 2 * modifier_size(item.length);
+        break;
+    case conversion::floating:
+        /* Sign, every integer digit of DBL_MAX, point and fraction */
+        bound = 1 + std::numeric_limits<double>::max_exponent10 + 1 + 1 +
+                (std::size_t)(item.precision < 0 ? 6 : item.precision);
+        break;
+    case conversion::string:
+        if (item.precision < 0)
+        {
+            return 0;
+        }
+        bound = (std::size_t)item.precision;
+        break;
+    case conversion::character:
+        bound = 1;
+        break;
+    case conversion::pointer:
+        bound = 2 + 2 * sizeof(void *);
+        break;
+    }
+    return bound > item.width ? bound : item.width;
+}
+
+template <format_string Format, typename... Args>
+consteval std::size_t record_bound()
+{
+    constexpr const auto &table = compiled<Format>::table;
+    std::size_t bound = table.literal_length;
+    [[maybe_unused]] std::size_t next = 0; /* Untouched by a format without placeholders */
+    bool bounded = true;
+
+    (
+        [&]
+        {
+            std::size_t item = placeholder_bound<std::remove_cvref_t<Args>>(table.placeholders[next++]);
+            bounded = bounded && item > 0;
+            bound += item;
+        }(),
+        ...);
+    return bounded ? bound : 0;
+}
+
+/* Bounded output; past the capacity it only counts, so the same code measures and writes */
+struct writer
+{
+    char *data;
+    std::size_t capacity;
+    std::size_t length;
+
+    constexpr void put(char c)
+    {
+        if (length < capacity)
+        {
+            data[length] = c;
+        }
+        length++;
+    }
+
+    constexpr void put(const char *text, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            put(text[i]);
+        }
+    }
+
+    constexpr void pad(char c, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; i++)
+        {
+            put(c);
+        }
+    }
+};
+
+/* Writes text with the width and alignment of a placeholder; digits_begin is where zero padding goes */
+constexpr void put_field(writer &out, const placeholder &item, const char *text, std::size_t length,
+                         std::size_t digits_begin)
+{
+    std::size_t padding = item.width > length ? item.width - length : 0;
+
+    if (item.left_align)
+    {
+        out.put(text, length);
+        out.pad(' ', padding);
+    }
+    else if (item.zero_pad && item.kind != conversion::string && item.kind != conversion::character)
+    {
+        out.put(text, digits_begin);
+        out.pad('0', padding);
+        out.put(text + digits_begin, length - digits_begin);
+    }
+    else
+    {
+        out.pad(' ', padding);
+        out.put(text, length);
+    }
+}
+
+template <length_modifier Length>
+constexpr long long to_signed(long long value)
+{
+    if constexpr (Length == length_modifier::hh)
+    {
+        return static_cast<signed char>(value);
+    }
+    else if constexpr (Length == length_modifier::h)
+    {
+        return static_cast<short>(value);
+    }
+    else if constexpr (Length == length_modifier::none)
+    {
+        return static_cast<int>(value);
+    }
+    else
+    {
+        return value;
+    }
+}
+
+template <length_modifier Length>
+constexpr unsigned long long to_unsigned(unsigned long long value)
+{
+    if constexpr (Length == length_modifier::hh)
+    {
+        return static_cast<unsigned char>(value);
+    }
+    else if constexpr (Length == length_modifier::h)
+    {
+        return static_cast<unsigned short>(value);
+    }
+    else if constexpr (Length == length_modifier::none)
+    {
+        return static_cast<unsigned int>(value);
+    }
+    else if constexpr (Length == length_modifier::z)
+    {
+        return static_cast<std::size_t>(value);
+    }
+    else
+    {
+        return value;
+    }
+}
+
+/* printf spec of a %f placeholder, e.g. "%-08.3f"; a constant of each call site */
+template <placeholder Item>
+consteval std::array<char, 24> make_float_spec()
+{
+    std::array<char, 24> text{};
+    std::size_t length = 0;
+    char reversed[12]{};
+    std::size_t digits = 0;
+
+    text[length++] = '%';
+    if (Item.left_align)
+    {
+        text[length++] = '-';
+    }
+    if (Item.zero_pad)
+    {
+        text[length++] = '0';
+    }
+    for (unsigned width = Item.width; width != 0; width /= 10)
+    {
+        reversed[digits++] = (char)('0' + width % 10);
+    }
+    while (digits > 0)
+    {
+        text[length++] = reversed[--digits];
+    }
+    if (Item.precision >= 0)
+    {
+        text[length++] = '.';
+        if (Item.precision >= 10)
+        {
+            text[length++] = (char)('0' + Item.precision / 10);
+        }
+        text[length++] = (char)('0' + Item.precision % 10);
+    }
+    text[length++] = 'f';
+    return text;
+}
+
+template <placeholder Item>
+inline constexpr std::array<char, 24> float_spec = make_float_spec<Item>();
+
+template <placeholder Item, typename T>
+constexpr void put_argument(writer &out, const T &value)
+{
+    if constexpr (Item.kind == conversion::signed_integer || Item.kind == conversion::unsigned_integer ||
+                  Item.kind == conversion::hex_lower || Item.kind == conversion::hex_upper)
+    {
+        char digits[24];
+        std::size_t position = sizeof(digits);
+        bool negative = false;
+        unsigned long long magnitude;
+
+        if constexpr (Item.kind == conversion::signed_integer)
+        {
+            long long converted = to_signed<Item.length>(static_cast<long long>(value));
+            negative = converted < 0;
+            magnitude = negative ? 0ull - static_cast<unsigned long long>(converted)
+                                 : static_cast<unsigned long long>(converted);
+        }
+        else
+        {
+            magnitude = to_unsigned<Item.length>(static_cast<unsigned long long>(value));
+        }
+
+        if constexpr (Item.kind == conversion::hex_lower || Item.kind == conversion::hex_upper)
+        {
+            const char *alphabet = Item.kind == conversion::hex_lower ? "0123456789abcdef" : "0123456789ABCDEF";
+            do
+            {
+                digits[--position] = alphabet[magnitude & 0xF];
+                magnitude >>= 4;
+            } while (magnitude != 0);
+        }
+        else
+        {
+            do
+            {
+                digits[--position] = (char)('0' + magnitude % 10);
+                magnitude /= 10;
+            } while (magnitude != 0);
+        }
+        if (negative)
+        {
+            digits[--position] = '-';
+        }
+        put_field(out, Item, digits + position, sizeof(digits) - position, negative ? 1 : 0);
+    }
+    else if constexpr (Item.kind == conversion::floating)
+    {
+        char text[placeholder_bound<double>(Item) + 1];
+        int length = std::snprintf(text, sizeof(text), float_spec<Item>.data(), static_cast<double>(value));
+        if (length > 0)
+        {
+            out.put(text, (std::size_t)length < sizeof(text) ? (std::size_t)length : sizeof(text) - 1);
+        }
+    }
+    else if constexpr (Item.kind == conversion::string)
+    {
+        std::string_view text;
+        if constexpr (std::is_pointer_v<T>)
+        {
+            text = value != nullptr ? std::string_view(value) : std::string_view("(null)");
+        }
+        else
+        {
+            text = value;
+        }
+        if (Item.precision >= 0 && text.size() > (std::size_t)Item.precision)
+        {
+            text = text.substr(0, (std::size_t)Item.precision);
+        }
+        put_field(out, Item, text.data(), text.size(), 0);
+    }
+    else if constexpr (Item.kind == conversion::character)
+    {
+        char c = static_cast<char>(value);
+        put_field(out, Item, &c, 1, 0);
+    }
+    else
+    {
+        char digits[2 + 2 * sizeof(void *)];
+        std::size_t position = sizeof(digits);
+        auto address = reinterpret_cast<std::uintptr_t>(value);
+        do
+        {
+            digits[--position] = "0123456789abcdef"[address & 0xF];
+            address >>= 4;
+        } while (address != 0);
+        digits[--position] = 'x';
+        digits[--position] = '0';
+        put_field(out, Item, digits + position, sizeof(digits) - position, 2);
+    }
+}
+
+template <format_string Format, std::size_t... Index, typename... Args>
+constexpr std::size_t render(writer &out, std::index_sequence<Index...>, const Args &...args)
+{
+    constexpr const auto &table = compiled<Format>::table;
+    std::size_t literal = 0;
+
+    (
+        [&]
+        {
+            constexpr placeholder item = table.placeholders[Index];
+            out.put(table.literal.data() + literal, item.literal_end - literal);
+            literal = item.literal_end;
+            put_argument<item>(out, args);
+        }(),
+        ...);
+    out.put(table.literal.data() + literal, table.literal_length - literal);
+    return out.length;
+}
+
+template <std::size_t... N>
+consteval auto concat(const format_string<N> &...parts)
+{
+    char text[(N + ...) - sizeof...(N) + 1]{};
+    std::size_t length = 0;
+
+    (
+        [&]
+        {
+            for (std::size_t i = 0; i < parts.length(); i++)
+            {
+                text[length++] = parts.text[i];
+            }
+        }(),
+        ...);
+    return format_string<sizeof(text)>(text);
+}
+
+} /* namespace detail */
+
+/**
+ * @brief Compile-time upper bound of a record, 0 when a %s without precision leaves it unbounded
+ */
+template <format_string Format, typename... Args>
+inline constexpr std::size_t record_bound = detail::record_bound<Format, Args...>();
+
+/**
+ * @brief Exact length of the record a call would produce
+ *
+ * A constant expression whenever the arguments are and no %f is involved.
+ */
+template <format_string Format, typename... Args>
+constexpr std::size_t record_size(const Args &...args)
+{
+    static_assert(detail::check_arguments<Format, Args...>());
+    detail::writer out{nullptr, 0, 0};
+    return detail::render<Format>(out, std::index_sequence_for<Args...>{}, args...);
+}
+
+/**
+ * @brief Formats into a caller buffer, truncating at capacity
+ *
+ * @return std::size_t Length of the complete record, which may exceed capacity
+ */
+template <format_string Format, typename... Args>
+constexpr std::size_t format_to(char *buffer, std::size_t capacity, const Args &...args)
+{
+    static_assert(detail::check_arguments<Format, Args...>());
+    detail::writer out{buffer, capacity, 0};
+    return detail::render<Format>(out, std::index_sequence_for<Args...>{}, args...);
+}
+
+/**
+ * @brief Formats one record and hands it to the lane of a severity, like log_printf_level()
+ *
+ * The stack buffer is exactly record_bound bytes, or LOG_SINK_MAX_RECORD when the record is
+ * unbounded or longer; truncated records keep their final newline, as with log_printf().
+ *
+ * @return int | 0 for success -1 for failure
+ */
+template <log_level Level, format_string Format, typename... Args>
+int log_at(const Args &...args)
+{
+    static_assert(detail::check_arguments<Format, Args...>());
+    constexpr std::size_t bound = record_bound<Format, Args...>;
+    constexpr std::size_t capacity = bound > 0 && bound < LOG_SINK_MAX_RECORD ? bound : LOG_SINK_MAX_RECORD;
+    char record[capacity];
+
+    std::size_t length = format_to<Format>(record, capacity, args...);
+    if (length > capacity)
+    {
+        length = capacity;
+        record[length - 1] = '\n';
+    }
+    return log_record_level(Level, record, length);
+}
+
+/**
+ * @brief Formats one INFO record and hands it to the active sink, like log_printf()
+ *
+ * @return int | 0 for success -1 for failure
+ */
+template <format_string Format, typename... Args>
+int log(const Args &...args)
+{
+    return log_at<LOG_LEVEL_INFO, Format>(args...);
+}
+
+/**
+ * @brief C++ counterparts of LOG_MSG, LOG_WARNING and LOG_ERROR, e.g. eatl::message<"x=%d">(INFO, x)
+ */
+template <format_string Format, typename... Args>
+int message(const char *label, const Args &...args)
+{
+    return log_at<LOG_LEVEL_INFO, detail::concat(format_string("%s " BBLU "LOG" RESET_TEXT ": " BWHT), Format,
+                                                 format_string(RESET_TEXT "\n"))>(label, args...);
+}
+
+template <format_string Format, typename... Args>
+int warning(const char *label, const Args &...args)
+{
+    return log_at<LOG_LEVEL_WARNING, detail::concat(format_string("%s " BYEL "LOG" RESET_TEXT ": " BWHT), Format,
+                                                    format_string(RESET_TEXT "\n"))>(label, args...);
+}
+
+template <format_string Format, typename... Args>
+int error(const char *label, const Args &...args)
+{
+    return log_at<LOG_LEVEL_CRITICAL, detail::concat(format_string("%s " BRED "LOG" RESET_TEXT ": " BWHT), Format,
+                                                     format_string(RESET_TEXT "\n"))>(label, args...);
+}
+
+/**
+ * @brief Formats a message and delivers it through log_event(), as perform_calculation() does
+ *
+ * Sampling, tracing and the fallback for a module without a callback are those of the C event path.
+ *
+ * @return int | 0 for success -1 for failure
+ */
+template <format_string Format, typename... Args>
+int event(const struct log_module *module, const Args &...args)
+{
+    static_assert(detail::check_arguments<Format, Args...>());
+    constexpr std::size_t bound = record_bound<Format, Args...>;
+    constexpr std::size_t capacity = bound > 0 && bound < MAX_LOG_MESSAGE_LENGTH ? bound + 1 : MAX_LOG_MESSAGE_LENGTH;
+    char text[capacity];
+
+    std::size_t length = format_to<Format>(text, capacity - 1, args...);
+    text[length < capacity - 1 ? length : capacity - 1] = '\0';
+    return log_event(module, text);
+}
+
+} /* namespace eatl */
+
+#endif /* logger_hpp_ */
@@ -0,0 +1,149 @@
+/**
+ * @file cpu-features.c
+ * @brief CPU instruction set feature detection definitions
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* System includes */
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <cpuid.h>
+
+#endif
+
+/* Local includes */
+#include "cpu-features.h"
+
+/* CPUID leaf 1 ECX */
+#define CPUID_1_ECX_SSE42 (1u << 20)
+#define CPUID_1_ECX_OSXSAVE (1u << 27)
+#define CPUID_1_ECX_AVX (1u << 28)
+/* CPUID leaf 1 EDX */
+#define CPUID_1_EDX_SSE2 (1u << 26)
+/* CPUID leaf 7 sub-leaf 0 EBX */
+#define CPUID_7_EBX_AVX2 (1u << 5)
+#define CPUID_7_EBX_BMI2 (1u << 8)
+#define CPUID_7_EBX_AVX512F (1u << 16)
+#define CPUID_7_EBX_AVX512BW (1u << 30)
+
+/* XCR0 state components the OS must enable */
+#define XCR0_AVX_STATE 0x06u    /* SSE and AVX registers */
+#define XCR0_AVX512_STATE 0xE0u /* Opmask, ZMM0-15 upper halves, ZMM16-31 */
+
+static struct cpu_features features;
+static int features_ready;
+
+#if defined(__x86_64__) || defined(__i386__)
+
+static unsigned int read_xcr0(void)
+{
+    unsigned int eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return eax;
+}
+
+static void detect_features(struct cpu_features *out)
+{
+    unsigned int eax, ebx, ecx, edx;
+    unsigned int xcr0 = 0;
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    {
+        return;
+    }
+    out->sse2 = (edx & CPUID_1_EDX_SSE2) != 0;
+    out->sse42 = (ecx & CPUID_1_ECX_SSE42) != 0;
+
+    if ((ecx & CPUID_1_ECX_OSXSAVE) != 0)
+    {
+        xcr0 = read_xcr0();
+    }
+    int os_avx = (ecx & CPUID_1_ECX_AVX) != 0 && (xcr0 & XCR0_AVX_STATE) == XCR0_AVX_STATE;
+    int os_avx512 = os_avx && (xcr0 & XCR0_AVX512_STATE) == XCR0_AVX512_STATE;
+
+    if (__get_cpuid_max(0, NULL) >= 7)
+    {
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+        out->avx2 = os_avx && (ebx & CPUID_7_EBX_AVX2) != 0;
+        out->bmi2 = (ebx & CPUID_7_EBX_BMI2) != 0;
+        out->avx512f = os_avx512 && (ebx & CPUID_7_EBX_AVX512F) != 0;
+        out->avx512bw = out->avx512f && (ebx & CPUID_7_EBX_AVX512BW) != 0;
+    }
+}
+
+#else
+
+static void detect_features(struct cpu_features *out)
+{
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    out->neon = 1;
+#else
+    (void)out;
+#endif
+}
+
+#endif /* x86 */
+
+const struct cpu_features *get_cpu_features(void)
+{
+    /* Detection is idempotent, so a racing first call only repeats the same stores */
+    if (!features_ready)
+    {
+        detect_features(&features);
+        features_ready = 1;
+    }
+    return &features;
+}
+
+int cpu_features_string(char *buffer, int length)
+{
+    const struct cpu_features *f = get_cpu_features();
+
+    int written = snprintf(buffer, (size_t)length, "%s%s%s%s%s%s%s",
+                           f->sse2 ? "sse2 " : "",
+                           f->sse42 ? "sse4.2 " : "",
+                           f->avx2 ? "avx2 " : "",
+                           f->bmi2 ? "bmi2 " : "",
+                           f->avx512f ? "avx512f " : "",
+                           f->avx512bw ? "avx512bw " : "",
+                           f->neon ? "neon " : "");
+    if (written > 0 && written < length)
+    {
+        buffer[--written] = '\0'; /* Drop the trailing space */
+    }
+    return written;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file cpu-features.h
+ * @brief CPU instruction set feature detection declarations
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef cpu_features_h_
+#define cpu_features_h_
+
+/**
+ * @brief Instruction set extensions usable by the current process
+ *
+ * A feature is only reported when both the CPU advertises it through CPUID and the operating
+ * system saves the register state it needs (XCR0), so every flag here is safe to execute.
+ */
+struct cpu_features
+{
+    unsigned int sse2 : 1;     /**< SSE2 */
+    unsigned int sse42 : 1;    /**< SSE4.2, including the CRC32 instruction */
+    unsigned int avx2 : 1;     /**< AVX2 */
+    unsigned int bmi2 : 1;     /**< BMI2 (PDEP/PEXT) */
+    unsigned int avx512f : 1;  /**< AVX-512 Foundation */
+    unsigned int avx512bw : 1; /**< AVX-512 Byte and Word */
+    unsigned int neon : 1;     /**< ARM Advanced SIMD */
+};
+
+/**
+ * @brief Returns the instruction set extensions of the running CPU
+ *
+ * CPUID is executed once on first use; later calls return the cached result.
+ *
+ * @return const struct cpu_features*
+ */
+const struct cpu_features *get_cpu_features(void);
+
+/**
+ * @brief Writes the detected features as a space separated list
+ *
+ * @param[out] buffer Buffer to write to
+ * @param[in]  length Size of the buffer
+ * @return int Number of characters written, excluding the null terminator
+ */
+int cpu_features_string(char *buffer, int length);
+
+#endif /* cpu_features_h_ */
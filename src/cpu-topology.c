@@ -0,0 +1,486 @@
+/**
+ * @file cpu-topology.c
+ * @brief CPU topology discovery definitions
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <cpuid.h>
+
+#endif
+
+/* Local includes */
+#include "cpu-topology.h"
+
+#define SYSFS_CPU_PATH "/sys/devices/system/cpu"
+#define SYSFS_NODE_PATH "/sys/devices/system/node"
+
+static struct cpu_topology topology;
+
+#if defined(__x86_64__) || defined(__i386__)
+
+/* Same leaves src/cpu-info-x86.asm queries: 0 for the vendor, 0x80000002-4 for the brand */
+static void read_cpuid_strings(struct cpu_topology *topo)
+{
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+
+    if (__get_cpuid(0, &eax, &ebx, &ecx, &edx))
+    {
+        memcpy(topo->vendor, &ebx, 4);
+        memcpy(topo->vendor + 4, &edx, 4);
+        memcpy(topo->vendor + 8, &ecx, 4);
+        topo->vendor[12] = '\0';
+    }
+
+    if (__get_cpuid_max(0x80000000, NULL) >= 0x80000004)
+    {
+        for (unsigned int leaf = 0; leaf < 3; leaf++)
+        {
+            __get_cpuid(0x80000002 + leaf, &eax, &ebx, &ecx, &edx);
+            memcpy(topo->brand + leaf * 16, &eax, 4);
+            memcpy(topo->brand + leaf * 16 + 4, &ebx, 4);
+            memcpy(topo->brand + leaf * 16 + 8, &ecx, 4);
+            memcpy(topo->brand + leaf * 16 + 12, &edx, 4);
+        }
+        topo->brand[48] = '\0';
+    }
+
+    /* CLFLUSH line size is reported in 8 byte units in EBX[15:8] of leaf 1 */
+    if (topo->cache_line_size == 0 && __get_cpuid(1, &eax, &ebx, &ecx, &edx))
+    {
+        topo->cache_line_size = (int)((ebx >> 8) & 0xFF) * 8;
+    }
+}
+
+#else
+
+static void read_cpuid_strings(struct cpu_topology *topo)
+{
+    (void)topo;
+}
+
+#endif /* x86 */
+
+#ifdef __linux__
+
+static int read_sysfs_string(const char *path, char *buffer, size_t length)
+{
+    FILE *file = fopen(path, "r");
+    if (file == NULL)
+    {
+        return -1;
+    }
+    if (fgets(buffer, (int)length, file) == NULL)
+    {
+        fclose(file);
+        return -1;
+    }
+    fclose(file);
+    buffer[strcspn(buffer, "\n")] = '\0';
+    return 0;
+}
+
+static long read_sysfs_long(const char *path, long fallback)
+{
+    char buffer[64];
+    if (read_sysfs_string(path, buffer, sizeof(buffer)) != 0)
+    {
+        return fallback;
+    }
+    return strtol(buffer, NULL, 10);
+}
+
+/* Parses sysfs sizes such as "32K" or "8M" */
+static uint32_t parse_size(const char *text)
+{
+    char *end;
+    unsigned long value = strtoul(text, &end, 10);
+
+    switch (*end)
+    {
+    case 'K':
+        return (uint32_t)(value << 10);
+    case 'M':
+        return (uint32_t)(value << 20);
+    case 'G':
+        return (uint32_t)(value << 30);
+    default:
+        return (uint32_t)value;
+    }
+}
+
+/*
+ * Walks a kernel cpulist such as "0-3,8,10-11" and calls visit() for every CPU in it.
+ * Returns the number of CPUs visited.
+ */
+static int parse_cpulist(const char *list, void (*visit)(int cpu, void *ctx), void *ctx)
+{
+    int count = 0;
+    const char *p = list;
+
+    while (*p != '\0')
+    {
+        char *end;
+        long first = strtol(p, &end, 10);
+        long last = first;
+
+        if (end == p)
+        {
+            break;
+        }
+        if (*end == '-')
+        {
+            p = end + 1;
+            last = strtol(p, &end, 10);
+        }
+        for (long cpu = first; cpu <= last; cpu++)
+        {
+            if (visit != NULL && cpu >= 0 && cpu < CPU_TOPOLOGY_MAX_CPUS)
+            {
+                visit((int)cpu, ctx);
+            }
+            count++;
+        }
+        if (*end != ',')
+        {
+            break;
+        }
+        p = end + 1;
+    }
+    return count;
+}
+
+static void mark_online(int cpu, void *ctx)
+{
+    struct cpu_topology *topo = ctx;
+    topo->cpus[cpu].online = 1;
+    topo->logical_cpus++;
+    if (cpu > topo->max_cpu_id)
+    {
+        topo->max_cpu_id = cpu;
+    }
+}
+
+struct node_visit
+{
+    struct cpu_topology *topo;
+    int node;
+};
+
+static void mark_node(int cpu, void *ctx)
+{
+    struct node_visit *visit = ctx;
+    visit->topo->cpus[cpu].node_id = (int16_t)visit->node;
+}
+
+static void mark_possible(int cpu, void *ctx)
+{
+    struct cpu_topology *topo = ctx;
+    if (cpu + 1 > topo->possible_cpus)
+    {
+        topo->possible_cpus = cpu + 1;
+    }
+}
+
+static void discover_cpus(struct cpu_topology *topo)
+{
+    char path[128];
+    char list[1024];
+
+    if (read_sysfs_string(SYSFS_CPU_PATH "/online", list, sizeof(list)) != 0 ||
+        parse_cpulist(list, mark_online, topo) == 0)
+    {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        if (online < 1)
+        {
+            online = 1;
+        }
+        for (long cpu = 0; cpu < online && cpu < CPU_TOPOLOGY_MAX_CPUS; cpu++)
+        {
+            mark_online((int)cpu, topo);
+        }
+    }
+
+    /* Hotplug can bring CPUs online later; per-CPU data is sized for all of them */
+    if (read_sysfs_string(SYSFS_CPU_PATH "/possible", list, sizeof(list)) == 0)
+    {
+        parse_cpulist(list, mark_possible, topo);
+    }
+    if (topo->possible_cpus <= topo->max_cpu_id)
+    {
+        topo->possible_cpus = topo->max_cpu_id + 1;
+    }
+
+    int packages = 0;
+    int smt_max = 1;
+
+    for (int cpu = 0; cpu <= topo->max_cpu_id; cpu++)
+    {
+        struct cpu_logical_info *info = &topo->cpus[cpu];
+        if (!info->online)
+        {
+            continue;
+        }
+
+        snprintf(path, sizeof(path), SYSFS_CPU_PATH "/cpu%d/topology/core_id", cpu);
+        info->core_id = (int16_t)read_sysfs_long(path, cpu);
+        snprintf(path, sizeof(path), SYSFS_CPU_PATH "/cpu%d/topology/physical_package_id", cpu);
+        info->package_id = (int16_t)read_sysfs_long(path, 0);
+
+        if (info->package_id + 1 > packages)
+        {
+            packages = info->package_id + 1;
+        }
+
+        /* A CPU is the first thread of its core unless an earlier CPU shares (package, core) */
+        int siblings = 0;
+        for (int prev = 0; prev < cpu; prev++)
+        {
+            if (topo->cpus[prev].online &&
+                topo->cpus[prev].core_id == info->core_id &&
+                topo->cpus[prev].package_id == info->package_id)
+            {
+                siblings++;
+            }
+        }
+        info->smt_index = (int16_t)siblings;
+        if (siblings == 0)
+        {
+            topo->physical_cores++;
+        }
+        if (siblings + 1 > smt_max)
+        {
+            smt_max = siblings + 1;
+        }
+    }
+
+    topo->packages = packages > 0 ? packages : 1;
+    topo->smt_per_core = smt_max;
+}
+
+static void discover_caches(struct cpu_topology *topo)
+{
+    char path[128];
+    char text[1024];
+
+    for (int index = 0; index < CPU_TOPOLOGY_MAX_CACHES; index++)
+    {
+        struct cpu_cache_info *cache = &topo->caches[topo->num_caches];
+
+        snprintf(path, sizeof(path), SYSFS_CPU_PATH "/cpu0/cache/index%d/level", index);
+        long level = read_sysfs_long(path, -1);
+        if (level < 0)
+        {
+            break;
+        }
+        cache->level = (uint8_t)level;
+
+        snprintf(path, sizeof(path), SYSFS_CPU_PATH "/cpu0/cache/index%d/type", index);
+        cache->type = read_sysfs_string(path, text, sizeof(text)) == 0 ? text[0] : 'U';
+
+        snprintf(path, sizeof(path), SYSFS_CPU_PATH "/cpu0/cache/index%d/size", index);
+        cache->size_bytes = read_sysfs_string(path, text, sizeof(text)) == 0 ? parse_size(text) : 0;
+
+        snprintf(path, sizeof(path), SYSFS_CPU_PATH "/cpu0/cache/index%d/coherency_line_size", index);
+        cache->line_size = (uint32_t)read_sysfs_long(path, 0);
+
+        snprintf(path, sizeof(path), SYSFS_CPU_PATH "/cpu0/cache/index%d/shared_cpu_list", index);
+        cache->shared_cpus = read_sysfs_string(path, text, sizeof(text)) == 0
+                                 ? (uint16_t)parse_cpulist(text, NULL, NULL)
+                                 : 1;
+
+        if (cache->level == 1 && cache->type == 'D' && cache->line_size > 0)
+        {
+            topo->cache_line_size = (int)cache->line_size;
+        }
+        topo->num_caches++;
+    }
+}
+
+static void discover_nodes(struct cpu_topology *topo)
+{
+    char path[128];
+    char list[1024];
+    struct node_visit visit = {.topo = topo};
+
+    for (int node = 0; node < CPU_TOPOLOGY_MAX_NODES; node++)
+    {
+        snprintf(path, sizeof(path), SYSFS_NODE_PATH "/node%d/cpulist", node);
+        if (read_sysfs_string(path, list, sizeof(list)) != 0)
+        {
+            continue;
+        }
+        visit.node = node;
+        if (parse_cpulist(list, mark_node, &visit) > 0)
+        {
+            topo->numa_nodes++;
+        }
+    }
+}
+
+static void discover_topology(void)
+{
+    struct cpu_topology *topo = &topology;
+
+    topo->max_cpu_id = 0;
+    discover_cpus(topo);
+    discover_caches(topo);
+    discover_nodes(topo);
+    read_cpuid_strings(topo);
+
+    if (topo->numa_nodes == 0)
+    {
+        topo->numa_nodes = 1;
+    }
+    if (topo->physical_cores == 0)
+    {
+        topo->physical_cores = topo->logical_cpus;
+    }
+    if (topo->cache_line_size == 0)
+    {
+        long line = sysconf(_SC_LEVEL1_DCACHE_LINESIZE);
+        topo->cache_line_size = line > 0 ? (int)line : CPU_TOPOLOGY_DEFAULT_LINE_SIZE;
+    }
+}
+
+static pthread_once_t topology_once = PTHREAD_ONCE_INIT;
+
+const struct cpu_topology *get_cpu_topology(void)
+{
+    pthread_once(&topology_once, discover_topology);
+    return &topology;
+}
+
+int cpu_topology_pin_self(int cpu)
+{
+    cpu_set_t set;
+
+    if (cpu < 0 || cpu >= CPU_TOPOLOGY_MAX_CPUS)
+    {
+        return -1;
+    }
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0 ? 0 : -1;
+}
+
+#else /* If linux is not found */
+
+static int topology_ready;
+
+const struct cpu_topology *get_cpu_topology(void)
+{
+    if (!topology_ready)
+    {
+        topology.logical_cpus = 1;
+        topology.possible_cpus = 1;
+        topology.physical_cores = 1;
+        topology.packages = 1;
+        topology.smt_per_core = 1;
+        topology.numa_nodes = 1;
+        topology.cpus[0].online = 1;
+        read_cpuid_strings(&topology);
+        if (topology.cache_line_size == 0)
+        {
+            topology.cache_line_size = CPU_TOPOLOGY_DEFAULT_LINE_SIZE;
+        }
+        topology_ready = 1;
+    }
+    return &topology;
+}
+
+int cpu_topology_pin_self(int cpu)
+{
+    (void)cpu;
+    return -1;
+}
+
+#endif /* __linux__ */
+
+uint32_t cpu_topology_cache_per_cpu(int level)
+{
+    const struct cpu_topology *topo = get_cpu_topology();
+
+    for (int i = 0; i < topo->num_caches; i++)
+    {
+        const struct cpu_cache_info *cache = &topo->caches[i];
+        if (cache->level == level && cache->type != 'I')
+        {
+            return cache->size_bytes / (cache->shared_cpus > 0 ? cache->shared_cpus : 1);
+        }
+    }
+    return 0;
+}
+
+int cpu_topology_drain_cpu(void)
+{
+    const struct cpu_topology *topo = get_cpu_topology();
+    int last_node = 0;
+
+    for (int cpu = 0; cpu <= topo->max_cpu_id; cpu++)
+    {
+        if (topo->cpus[cpu].online && topo->cpus[cpu].node_id > last_node)
+        {
+            last_node = topo->cpus[cpu].node_id;
+        }
+    }
+
+    for (int cpu = topo->max_cpu_id; cpu >= 0; cpu--)
+    {
+        const struct cpu_logical_info *info = &topo->cpus[cpu];
+        if (info->online && info->smt_index == 0 && info->node_id == last_node)
+        {
+            return cpu;
+        }
+    }
+    return 0;
+}
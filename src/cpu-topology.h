@@ -0,0 +1,133 @@
+/**
+ * @file cpu-topology.h
+ * @brief CPU topology discovery declarations
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef cpu_topology_h_
+#define cpu_topology_h_
+
+#include <stdint.h>
+
+#define CPU_TOPOLOGY_MAX_CPUS 256
+#define CPU_TOPOLOGY_MAX_CACHES 8
+#define CPU_TOPOLOGY_MAX_NODES 64
+#define CPU_TOPOLOGY_DEFAULT_LINE_SIZE 64
+
+/**
+ * @brief Describes one level of the cache hierarchy seen by CPU 0
+ */
+struct cpu_cache_info
+{
+    uint8_t level;        /**< Cache level (1, 2, 3...) */
+    char type;            /**< 'D'ata, 'I'nstruction or 'U'nified */
+    uint32_t size_bytes;  /**< Total size of one instance of the cache */
+    uint32_t line_size;   /**< Coherency line size in bytes */
+    uint16_t shared_cpus; /**< Number of logical CPUs sharing one instance */
+};
+
+/**
+ * @brief Placement of one logical CPU
+ */
+struct cpu_logical_info
+{
+    int16_t online;     /**< 1 if the CPU is online */
+    int16_t core_id;    /**< Physical core id within the package */
+    int16_t package_id; /**< Physical package (socket) id */
+    int16_t node_id;    /**< NUMA node the CPU belongs to */
+    int16_t smt_index;  /**< Position of this thread among its core's SMT siblings */
+};
+
+/**
+ * @brief Immutable snapshot of the machine's CPU topology
+ *
+ * Discovered once by get_cpu_topology() and never modified afterwards, so any thread may read it
+ * without locking. Per-CPU arrays are indexed by the kernel's logical CPU number.
+ */
+struct cpu_topology
+{
+    int logical_cpus;    /**< Number of online logical CPUs */
+    int max_cpu_id;      /**< Highest online logical CPU number */
+    int possible_cpus;   /**< Highest CPU number that may ever come online, plus one */
+    int physical_cores;  /**< Number of distinct (package, core) pairs */
+    int packages;        /**< Number of physical packages */
+    int smt_per_core;    /**< Hardware threads per core */
+    int numa_nodes;      /**< Number of NUMA nodes with CPUs */
+    int cache_line_size; /**< L1 data cache line size in bytes */
+    int num_caches;      /**< Number of entries in caches */
+    struct cpu_cache_info caches[CPU_TOPOLOGY_MAX_CACHES];
+    struct cpu_logical_info cpus[CPU_TOPOLOGY_MAX_CPUS];
+    char vendor[13]; /**< CPUID vendor string, empty when unavailable */
+    char brand[49];  /**< CPUID brand string, empty when unavailable */
+};
+
+/**
+ * @brief Returns the CPU topology, discovering it on first use
+ *
+ * The first call reads sysfs (and CPUID on x86) and publishes the result. Every later call is a
+ * lock-free read of the published pointer. Never returns NULL; when nothing can be discovered the
+ * topology describes a single CPU with a 64 byte cache line.
+ *
+ * @return const struct cpu_topology*
+ */
+const struct cpu_topology *get_cpu_topology(void);
+
+/**
+ * @brief Returns the bytes of one cache level each logical CPU has to itself
+ *
+ * The data or unified cache at that level, divided by the number of CPUs sharing one instance.
+ *
+ * @param[in] level Cache level, e.g. 2
+ * @return uint32_t 0 when the level was not discovered
+ */
+uint32_t cpu_topology_cache_per_cpu(int level);
+
+/**
+ * @brief Picks a logical CPU for a background drain thread
+ *
+ * Prefers the first hardware thread of the last physical core on the last NUMA node so the drain
+ * stays away from CPU 0, which usually services interrupts, and from the producers' SMT siblings.
+ *
+ * @return int Logical CPU number
+ */
+int cpu_topology_drain_cpu(void);
+
+/**
+ * @brief Pins the calling thread to a logical CPU
+ *
+ * @param[in] cpu Logical CPU number
+ * @return int | 0 for success -1 for failure
+ */
+int cpu_topology_pin_self(int cpu);
+
+#endif /* cpu_topology_h_ */
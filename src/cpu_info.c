@@ -1,62 +1,47 @@
 #include "cpu_info.h"
+#include "cpu-features.h"
+#include "cpu-topology.h"
+#include "log-kernels.h"
+#include "log-stage.h"
+#include "mem-sample.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
 #ifdef __linux__
 
-#include<unistd.h>
-#include<fcntl.h>
-
 long get_program_size(void) {
-    char buffer[64] = {0};
-    int fd = open("LIN_nrf-event-driven", O_RDONLY); // Replace "filename" with the actual filename or pass it as a parameter
-    if (fd == -1) {
-        perror("open");
+    /* Sampled through persistent /proc/self descriptors rather than reading a file per call */
+    struct mem_sample sample;
+    if (mem_sample_read(&sample) != 0) {
         return -1;
     }
 
-    ssize_t bytes_read = read(fd, buffer, sizeof(buffer) - 1); // -1 to leave space for null terminator
-    if (bytes_read == -1) {
-        perror("read");
-        close(fd);
-        return -1;
-    }
-
-    close(fd);
-
-    // Ensure buffer is null-terminated
-    buffer[bytes_read] = '\0';
+    printf("Virtual memory size: %llu bytes\n", (unsigned long long)sample.vsz_bytes);
+    printf("Resident set size: %llu bytes\n", (unsigned long long)sample.rss_bytes);
 
-    // Convert ASCII to integer
-    long program_size = atol(buffer);
-    return program_size;
+    return (long)sample.vsz_bytes;
 }
 
 long get_cpu_info(void) {
-    FILE* cpuinfo = fopen("/proc/cpuinfo", "r");
-    if (cpuinfo == NULL) {
-        perror("fopen");
-        return -1;
-    }
+    /* Discovered once and cached; later calls do not touch /proc or sysfs again */
+    const struct cpu_topology *topology = get_cpu_topology();
 
-    char buffer[1024];
-    long numOfProcessors = 0;
-    long numOfCores = 0;
-    while (fgets(buffer, sizeof(buffer), cpuinfo)) {
-        if (strncmp(buffer, "processor", 9) == 0) {
-            numOfProcessors++;
-        }
-        if (strncmp(buffer, "cpu cores", 9) == 0) {
-            numOfCores = strtol(buffer + 11, NULL, 10);
-        }
-    }
-    fclose(cpuinfo);
+    printf("Number of logical processors: %d\n", topology->logical_cpus);
+    printf("Number of physical cores: %d\n", topology->physical_cores);
+    printf("Number of NUMA nodes: %d\n", topology->numa_nodes);
+    printf("Cache line size: %d bytes\n", topology->cache_line_size);
+
+    char features[128];
+    cpu_features_string(features, sizeof(features));
+    printf("CPU features: %s (logger kernels: %s)\n", features, log_kernels->name);
 
-    printf("Number of logical processors: %ld\n", numOfProcessors);
-    printf("Number of physical cores: %ld\n", numOfCores);
+    size_t shard_bytes;
+    const char *shard_method;
+    int shards = log_stage_shard_geometry(&shard_bytes, &shard_method);
+    printf("Log shards: %d x 2 x %zu bytes (%s)\n", shards, shard_bytes, shard_method);
 
-    return numOfProcessors;
+    return topology->logical_cpus;
 }
 
 #endif 
@@ -0,0 +1,226 @@
+/**
+ * @file dwt-profile.c
+ * @brief Cortex-M33 DWT cycle counter profiling definitions
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#if defined(__linux__)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+/* System includes */
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__ZEPHYR__)
+
+#include <zephyr/kernel.h>
+
+#elif defined(__linux__)
+
+#include <time.h>
+
+#endif
+
+/* Local includes */
+#include "dwt-profile.h"
+
+#if defined(__ARM_ARCH_8M_MAIN__) || defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+#define DWT_HAS_CORE_DEBUG 1
+#endif
+
+#define REG32(addr) (*(volatile uint32_t *)(addr))
+
+static struct dwt_profile_site sites[DWT_PROFILE_MAX_SITES];
+static int num_sites;
+static enum dwt_profile_source source;
+
+uint32_t dwt_profile_cycles(void)
+{
+    switch (source)
+    {
+#ifdef DWT_HAS_CORE_DEBUG
+    case DWT_SOURCE_CYCCNT:
+        return REG32(DWT_CYCCNT_ADDR);
+#endif
+#if defined(__ZEPHYR__)
+    case DWT_SOURCE_KERNEL:
+        return k_cycle_get_32();
+#endif
+#if defined(__linux__)
+    case DWT_SOURCE_HOST:
+    {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        return (uint32_t)((uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec);
+    }
+#endif
+    default:
+        return 0;
+    }
+}
+
+enum dwt_profile_source dwt_profile_init(void)
+{
+    memset(sites, 0, sizeof(sites));
+    num_sites = 0;
+    source = DWT_SOURCE_NONE;
+
+#ifdef DWT_HAS_CORE_DEBUG
+    uint32_t cpuid = REG32(SCB_CPUID_ADDR);
+    uint32_t dhcsr = REG32(CORE_DEBUG_DHCSR_ADDR);
+
+    printf("CPUID: 0x%08lx (part 0x%03lx), debugger %s\n",
+           (unsigned long)cpuid, (unsigned long)((cpuid >> 4) & 0xFFF),
+           (dhcsr & DHCSR_C_DEBUGEN) ? "attached" : "not attached");
+
+    /* TRCENA powers the DWT; CYCCNT then runs with or without a debugger attached */
+    REG32(CORE_DEBUG_DEMCR_ADDR) |= DEMCR_TRCENA;
+    if ((REG32(DWT_CTRL_ADDR) & DWT_CTRL_NOCYCCNT) == 0)
+    {
+        REG32(DWT_CYCCNT_ADDR) = 0;
+        REG32(DWT_CTRL_ADDR) |= DWT_CTRL_CYCCNTENA;
+
+        uint32_t first = REG32(DWT_CYCCNT_ADDR);
+        for (volatile int spin = 0; spin < 16; spin++)
+        {
+        }
+        if (REG32(DWT_CYCCNT_ADDR) != first)
+        {
+            source = DWT_SOURCE_CYCCNT;
+        }
+    }
+#endif
+
+#if defined(__ZEPHYR__)
+    if (source == DWT_SOURCE_NONE)
+    {
+        source = DWT_SOURCE_KERNEL;
+    }
+#elif defined(__linux__)
+    source = DWT_SOURCE_HOST;
+#endif
+
+    return source;
+}
+
+struct dwt_profile_site *dwt_profile_site(const char *name)
+{
+    /* Call sites pass string literals, so a pointer match is the common case */
+    for (int i = 0; i < num_sites; i++)
+    {
+        if (sites[i].name == name)
+        {
+            return &sites[i];
+        }
+    }
+    for (int i = 0; i < num_sites; i++)
+    {
+        if (strcmp(sites[i].name, name) == 0)
+        {
+            return &sites[i];
+        }
+    }
+    if (num_sites == DWT_PROFILE_MAX_SITES)
+    {
+        return NULL;
+    }
+
+    struct dwt_profile_site *site = &sites[num_sites++];
+    site->name = name;
+    site->min_cycles = UINT32_MAX;
+    return site;
+}
+
+void dwt_profile_record(struct dwt_profile_site *site, uint32_t cycles)
+{
+    if (site == NULL)
+    {
+        return;
+    }
+
+    int bucket = cycles == 0 ? 0 : 31 - __builtin_clz(cycles);
+    if (bucket >= DWT_PROFILE_BUCKETS)
+    {
+        bucket = DWT_PROFILE_BUCKETS - 1;
+    }
+
+    site->calls++;
+    site->total_cycles += cycles;
+    site->histogram[bucket]++;
+    if (cycles < site->min_cycles)
+    {
+        site->min_cycles = cycles;
+    }
+    if (cycles > site->max_cycles)
+    {
+        site->max_cycles = cycles;
+    }
+}
+
+void dwt_profile_report(void)
+{
+    static const char *source_names[] = {"none", "DWT CYCCNT", "k_cycle_get_32", "CLOCK_MONOTONIC ns"};
+
+    printf("Cycle profile (source: %s)\n", source_names[source]);
+    for (int i = 0; i < num_sites; i++)
+    {
+        const struct dwt_profile_site *site = &sites[i];
+        if (site->calls == 0)
+        {
+            continue;
+        }
+
+        printf("%s: calls=%lu min=%lu mean=%lu max=%lu\n", site->name,
+               (unsigned long)site->calls, (unsigned long)site->min_cycles,
+               (unsigned long)(site->total_cycles / site->calls), (unsigned long)site->max_cycles);
+
+        for (int bucket = 0; bucket < DWT_PROFILE_BUCKETS; bucket++)
+        {
+            if (site->histogram[bucket] == 0)
+            {
+                continue;
+            }
+            unsigned long low = bucket == 0 ? 0 : 1UL << bucket;
+            if (bucket == DWT_PROFILE_BUCKETS - 1)
+            {
+                printf("    [%lu, inf): %lu\n", low, (unsigned long)site->histogram[bucket]);
+            }
+            else
+            {
+                printf("    [%lu, %lu): %lu\n", low, 1UL << (bucket + 1), (unsigned long)site->histogram[bucket]);
+            }
+        }
+    }
+}
@@ -0,0 +1,136 @@
+/**
+ * @file dwt-profile.h
+ * @brief Cortex-M33 DWT cycle counter profiling declarations
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef dwt_profile_h_
+#define dwt_profile_h_
+
+#include <stdint.h>
+
+/* Core debug and DWT registers (ARMv8-M, same addresses read by src/cpu-info-ctx-m33.asm) */
+#define SCB_CPUID_ADDR 0xE000ED00u
+#define CORE_DEBUG_DHCSR_ADDR 0xE000EDF0u
+#define CORE_DEBUG_DEMCR_ADDR 0xE000EDFCu
+#define DWT_CTRL_ADDR 0xE0001000u
+#define DWT_CYCCNT_ADDR 0xE0001004u
+
+#define DEMCR_TRCENA (1u << 24)     /* Enables the DWT and ITM units */
+#define DWT_CTRL_CYCCNTENA (1u << 0) /* Starts the cycle counter */
+#define DWT_CTRL_NOCYCCNT (1u << 25) /* Set when the cycle counter is not implemented */
+#define DHCSR_C_DEBUGEN (1u << 0)    /* Set while a debugger is attached */
+
+#define DWT_PROFILE_MAX_SITES 32
+#define DWT_PROFILE_BUCKETS 16 /* Power of two buckets: [0, 2), [2, 4) ... [2^15, inf) cycles */
+
+/**
+ * @brief Where cycle counts are read from
+ */
+enum dwt_profile_source
+{
+    DWT_SOURCE_NONE = 0, /**< dwt_profile_init() has not run */
+    DWT_SOURCE_CYCCNT,   /**< DWT cycle counter on the core */
+    DWT_SOURCE_KERNEL,   /**< Zephyr k_cycle_get_32(), used when CYCCNT is absent (e.g. QEMU) */
+    DWT_SOURCE_HOST      /**< CLOCK_MONOTONIC nanoseconds on a host build */
+};
+
+/**
+ * @brief Per call site statistics, kept in a fixed RAM table
+ */
+struct dwt_profile_site
+{
+    const char *name;          /**< Call site or module name */
+    uint32_t calls;            /**< Number of measured calls */
+    uint32_t min_cycles;       /**< Fastest call */
+    uint32_t max_cycles;       /**< Slowest call */
+    uint64_t total_cycles;     /**< Sum of all calls, for the mean */
+    uint32_t histogram[DWT_PROFILE_BUCKETS];
+};
+
+/**
+ * @brief Enables the cycle counter and clears the site table
+ *
+ * Sets DEMCR.TRCENA and DWT_CTRL.CYCCNTENA, then checks that CYCCNT actually advances. Emulators
+ * such as QEMU's mps2-an505 model leave the DWT unimplemented, in which case the kernel's cycle
+ * counter is used instead.
+ *
+ * @return enum dwt_profile_source Counter selected
+ */
+enum dwt_profile_source dwt_profile_init(void);
+
+/**
+ * @brief Reads the selected cycle counter
+ *
+ * @return uint32_t Free-running cycle count, wraps at 2^32
+ */
+uint32_t dwt_profile_cycles(void);
+
+/**
+ * @brief Finds or registers the table entry for a call site
+ *
+ * @param[in] name Site name; the pointer is stored, so it must outlive the table
+ * @return struct dwt_profile_site* NULL once DWT_PROFILE_MAX_SITES sites are registered
+ */
+struct dwt_profile_site *dwt_profile_site(const char *name);
+
+/**
+ * @brief Adds one measurement to a site
+ *
+ * @param[in] site   Site returned by dwt_profile_site()
+ * @param[in] cycles Cycles spent in the call
+ */
+void dwt_profile_record(struct dwt_profile_site *site, uint32_t cycles);
+
+/**
+ * @brief Prints the min/mean/max and histogram of every registered site
+ */
+void dwt_profile_report(void);
+
+#define DWT_PROFILE_STRINGIFY_(x) #x
+#define DWT_PROFILE_STRINGIFY(x) DWT_PROFILE_STRINGIFY_(x)
+#define DWT_PROFILE_HERE __FILE__ ":" DWT_PROFILE_STRINGIFY(__LINE__)
+
+/**
+ * @brief Measures the cycles spent in a statement and records them under a site name
+ */
+#define DWT_PROFILE(site_name, statement)                                \
+    do                                                                   \
+    {                                                                    \
+        struct dwt_profile_site *dwt_site_ = dwt_profile_site(site_name); \
+        uint32_t dwt_start_ = dwt_profile_cycles();                      \
+        statement;                                                       \
+        dwt_profile_record(dwt_site_, dwt_profile_cycles() - dwt_start_); \
+    } while (0)
+
+#endif /* dwt_profile_h_ */
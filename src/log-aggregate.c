@@ -0,0 +1,282 @@
+/**
+ * @file log-aggregate.c
+ * @brief Windowed aggregation of log_module results definitions
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+/* System includes */
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef __linux__
+
+#include <time.h>
+
+#endif
+
+/* Local includes */
+#include "log-aggregate.h"
+
+static const char *const threshold_names[LOG_THRESHOLD_COUNT] = {"above", "below"};
+
+#ifdef __linux__
+
+uint64_t log_aggregate_clock_ns(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+}
+
+#endif
+
+static void reset_window(struct log_aggregate *aggregate)
+{
+    memset(&aggregate->current, 0, sizeof(aggregate->current));
+    aggregate->sum = 0.0;
+}
+
+int log_aggregate_init(struct log_aggregate *aggregate, uint32_t window_samples, uint64_t window_ticks,
+                       uint64_t (*clock)(void), log_aggregate_callback callback, void *context)
+{
+    if (aggregate == NULL)
+    {
+        return -1;
+    }
+#ifdef __linux__
+    if (clock == NULL)
+    {
+        clock = log_aggregate_clock_ns;
+    }
+#endif
+    if (window_ticks > 0 && clock == NULL)
+    {
+        fprintf(stderr, "Time windows need a clock on this target.\n");
+        return -1;
+    }
+
+    aggregate->window_samples = window_samples;
+    aggregate->window_ticks = window_ticks;
+    aggregate->clock = clock;
+    aggregate->callback = callback;
+    aggregate->context = context;
+    reset_window(aggregate);
+    return 0;
+}
+
+/* Bucket of a magnitude of at least 1 on the positive side, 1 to LOG_AGGREGATE_SIDE_BUCKETS */
+static int magnitude_bucket(unsigned long long magnitude)
+{
+    int exponent = 63 - __builtin_clzll(magnitude);
+    unsigned sub_bucket;
+    if (exponent >= LOG_AGGREGATE_SUB_BUCKET_BITS)
+    {
+        sub_bucket = (unsigned)(magnitude >> (exponent - LOG_AGGREGATE_SUB_BUCKET_BITS));
+    }
+    else
+    {
+        sub_bucket = (unsigned)(magnitude << (LOG_AGGREGATE_SUB_BUCKET_BITS - exponent));
+    }
+    int bucket = 1 + exponent * LOG_AGGREGATE_SUB_BUCKETS + (int)(sub_bucket & (LOG_AGGREGATE_SUB_BUCKETS - 1));
+    /* Only the magnitude of LLONG_MIN reaches 2^63; it shares the outermost bucket */
+    return bucket < LOG_AGGREGATE_SIDE_BUCKETS ? bucket : LOG_AGGREGATE_SIDE_BUCKETS;
+}
+
+/* Smallest magnitude of a positive side bucket */
+static unsigned long long magnitude_floor(int bucket)
+{
+    int exponent = (bucket - 1) / LOG_AGGREGATE_SUB_BUCKETS;
+    unsigned long long sub_bucket = (unsigned long long)((bucket - 1) % LOG_AGGREGATE_SUB_BUCKETS);
+    unsigned long long floor = 1ull << exponent;
+    if (exponent >= LOG_AGGREGATE_SUB_BUCKET_BITS)
+    {
+        floor |= sub_bucket << (exponent - LOG_AGGREGATE_SUB_BUCKET_BITS);
+    }
+    else
+    {
+        floor |= sub_bucket >> (LOG_AGGREGATE_SUB_BUCKET_BITS - exponent);
+    }
+    return floor;
+}
+
+int log_aggregate_bucket(long long value)
+{
+    if (value == 0)
+    {
+        return LOG_AGGREGATE_ZERO_BUCKET;
+    }
+    if (value > 0)
+    {
+        return LOG_AGGREGATE_ZERO_BUCKET + magnitude_bucket((unsigned long long)value);
+    }
+    return LOG_AGGREGATE_ZERO_BUCKET - magnitude_bucket(0ull - (unsigned long long)value);
+}
+
+long long log_aggregate_bucket_floor(int bucket)
+{
+    if (bucket == LOG_AGGREGATE_ZERO_BUCKET)
+    {
+        return 0;
+    }
+    if (bucket > LOG_AGGREGATE_ZERO_BUCKET)
+    {
+        return (long long)magnitude_floor(bucket - LOG_AGGREGATE_ZERO_BUCKET);
+    }
+    /* A negative bucket starts at the largest of its magnitudes; the outermost one also holds LLONG_MIN */
+    int side = LOG_AGGREGATE_ZERO_BUCKET - bucket;
+    if (side >= LOG_AGGREGATE_SIDE_BUCKETS)
+    {
+        return LLONG_MIN;
+    }
+    int exponent = (side - 1) / LOG_AGGREGATE_SUB_BUCKETS;
+    unsigned long long width = exponent > LOG_AGGREGATE_SUB_BUCKET_BITS ? 1ull << (exponent - LOG_AGGREGATE_SUB_BUCKET_BITS) : 1;
+    return -(long long)(magnitude_floor(side) + width - 1);
+}
+
+long long log_aggregate_percentile(const struct log_aggregate_summary *summary, double percent)
+{
+    if (summary->count == 0)
+    {
+        return 0;
+    }
+
+    uint64_t target = (uint64_t)(percent / 100.0 * summary->count + 0.5);
+    uint64_t seen = 0;
+    long long value = summary->max;
+    if (target == 0)
+    {
+        target = 1;
+    }
+    for (int bucket = 0; bucket < LOG_AGGREGATE_BUCKETS; bucket++)
+    {
+        seen += summary->histogram[bucket];
+        if (seen >= target)
+        {
+            value = log_aggregate_bucket_floor(bucket);
+            break;
+        }
+    }
+    if (value < summary->min)
+    {
+        value = summary->min;
+    }
+    if (value > summary->max)
+    {
+        value = summary->max;
+    }
+    return value;
+}
+
+static void emit_summary(const struct log_module *module, struct log_aggregate *aggregate)
+{
+    struct log_aggregate_summary *summary = &aggregate->current;
+
+    summary->mean = aggregate->sum / summary->count;
+    if (aggregate->callback != NULL)
+    {
+        aggregate->callback(module, summary, aggregate->context);
+        return;
+    }
+
+    char crossings[64];
+    size_t used = 0;
+    for (int threshold = 0; threshold < LOG_THRESHOLD_COUNT; threshold++)
+    {
+        used += (size_t)snprintf(crossings + used, sizeof(crossings) - used, " %s %u", threshold_names[threshold],
+                                 (unsigned)summary->crossings[threshold]);
+    }
+    log_printf("%s: %u samples min %lld max %lld mean %.2f p50 %lld p99 %lld%s\n", module->module_name,
+               (unsigned)summary->count, summary->min, summary->max, summary->mean,
+               log_aggregate_percentile(summary, 50.0), log_aggregate_percentile(summary, 99.0), crossings);
+}
+
+void log_aggregate_flush(struct log_module *module)
+{
+    struct log_aggregate *aggregate = module->aggregate;
+
+    if (aggregate == NULL || aggregate->current.count == 0)
+    {
+        return;
+    }
+    emit_summary(module, aggregate);
+    reset_window(aggregate);
+}
+
+int log_aggregate_add(struct log_module *module, long long value, int threshold)
+{
+    struct log_aggregate *aggregate = module->aggregate;
+    struct log_aggregate_summary *summary = &aggregate->current;
+    uint64_t now = aggregate->clock != NULL ? aggregate->clock() : 0;
+
+    if (aggregate->window_ticks > 0 && summary->count > 0 && now - summary->window_start >= aggregate->window_ticks)
+    {
+        log_aggregate_flush(module);
+    }
+
+    if (summary->count == 0)
+    {
+        summary->window_start = now;
+        summary->min = value;
+        summary->max = value;
+    }
+    else if (value < summary->min)
+    {
+        summary->min = value;
+    }
+    else if (value > summary->max)
+    {
+        summary->max = value;
+    }
+    summary->window_end = now;
+    summary->count++;
+    summary->histogram[log_aggregate_bucket(value)]++;
+    aggregate->sum += (double)value;
+
+    int first_crossing = 0;
+    if (threshold >= 0 && threshold < LOG_THRESHOLD_COUNT)
+    {
+        first_crossing = ++summary->crossings[threshold] == 1;
+    }
+
+    if (aggregate->window_samples > 0 && summary->count >= aggregate->window_samples)
+    {
+        log_aggregate_flush(module);
+    }
+    return first_crossing;
+}
@@ -0,0 +1,173 @@
+/**
+ * @file log-aggregate.h
+ * @brief Windowed aggregation of log_module results declarations
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef log_aggregate_h_
+#define log_aggregate_h_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common/logger.h"
+
+#ifndef LOG_AGGREGATE_SUB_BUCKET_BITS
+#define LOG_AGGREGATE_SUB_BUCKET_BITS 2 /* Each power of two is split in 4, so buckets are within 25% */
+#endif
+#define LOG_AGGREGATE_SUB_BUCKETS (1 << LOG_AGGREGATE_SUB_BUCKET_BITS)
+#define LOG_AGGREGATE_SIDE_BUCKETS (63 * LOG_AGGREGATE_SUB_BUCKETS) /* Buckets on each side of zero */
+#define LOG_AGGREGATE_ZERO_BUCKET LOG_AGGREGATE_SIDE_BUCKETS         /* Negative buckets below, positive above */
+#define LOG_AGGREGATE_BUCKETS (2 * LOG_AGGREGATE_SIDE_BUCKETS + 1)
+
+/**
+ * @brief Statistics of one closed window
+ */
+struct log_aggregate_summary
+{
+    uint64_t window_start;                       /**< Clock at the first sample, 0 without a clock */
+    uint64_t window_end;                         /**< Clock at the last sample, 0 without a clock */
+    uint32_t count;                              /**< Samples in the window */
+    long long min;                               /**< Smallest result */
+    long long max;                               /**< Largest result */
+    double mean;                                 /**< Arithmetic mean of the results */
+    uint32_t crossings[LOG_THRESHOLD_COUNT];     /**< Samples beyond each threshold */
+    uint32_t histogram[LOG_AGGREGATE_BUCKETS];   /**< Log-linear histogram, see log_aggregate_bucket() */
+};
+
+/**
+ * @brief Receives the summary of every closed window
+ *
+ * @param[in] module  Module the window belongs to
+ * @param[in] summary Window statistics, valid only for the duration of the call
+ * @param[in] context Pointer given to log_aggregate_init()
+ */
+typedef void (*log_aggregate_callback)(const struct log_module *module, const struct log_aggregate_summary *summary,
+                                       void *context);
+
+/**
+ * @brief Aggregation state of one log_module
+ *
+ * Attached through log_module.aggregate. While attached, perform_calculation() no longer fires an
+ * event per sample: results are folded into the current window, only the first crossing of each
+ * threshold in a window fires its event, and one summary is emitted when the window closes.
+ * Updates are not locked; a module is expected to be fed from one thread.
+ */
+struct log_aggregate
+{
+    uint32_t window_samples;         /**< Close after this many samples, 0 for no count limit */
+    uint64_t window_ticks;           /**< Close once this much clock time has passed, 0 for no time limit */
+    uint64_t (*clock)(void);         /**< Time source for window_ticks */
+    log_aggregate_callback callback; /**< Summary receiver, NULL to log the summary as a record */
+    void *context;
+    double sum;
+    struct log_aggregate_summary current;
+};
+
+/**
+ * @brief Prepares an aggregation window
+ *
+ * @param[out] aggregate      State to initialize
+ * @param[in]  window_samples Samples per window, 0 for no count limit
+ * @param[in]  window_ticks   Clock ticks per window, 0 for no time limit
+ * @param[in]  clock          Time source; NULL uses log_aggregate_clock_ns() where it exists
+ * @param[in]  callback       Summary receiver, NULL to log summaries through log_printf()
+ * @param[in]  context        Passed through to the callback
+ * @return int | 0 for success -1 for failure
+ */
+int log_aggregate_init(struct log_aggregate *aggregate, uint32_t window_samples, uint64_t window_ticks,
+                       uint64_t (*clock)(void), log_aggregate_callback callback, void *context);
+
+/**
+ * @brief Folds one result into the module's window, closing the window when it is due
+ *
+ * A time window is closed by the first sample that arrives after it has expired, or by
+ * log_aggregate_flush().
+ *
+ * @param[in] module    Module with an attached aggregate
+ * @param[in] value     Result to record
+ * @param[in] threshold Threshold the result crossed, or LOG_THRESHOLD_NONE
+ * @return int | 1 if this is the first crossing of threshold in the window, 0 otherwise
+ */
+int log_aggregate_add(struct log_module *module, long long value, int threshold);
+
+/**
+ * @brief Emits the summary of the current window, if it holds any samples, and starts a new one
+ *
+ * @param[in] module Module with an attached aggregate
+ */
+void log_aggregate_flush(struct log_module *module);
+
+/**
+ * @brief Returns the histogram bucket of a value
+ *
+ * Every power of two is split into LOG_AGGREGATE_SUB_BUCKETS equal buckets, as in HdrHistogram.
+ * Negative values mirror the positive ones below LOG_AGGREGATE_ZERO_BUCKET, which holds only 0, so
+ * results below a threshold of 1 are resolved as finely as those above. Buckets are in value order.
+ * Magnitudes below LOG_AGGREGATE_SUB_BUCKETS are exact, leaving a few buckets of the first octaves
+ * unused.
+ *
+ * @param[in] value Value to place
+ * @return int Bucket index, 0 to LOG_AGGREGATE_BUCKETS - 1
+ */
+int log_aggregate_bucket(long long value);
+
+/**
+ * @brief Returns the smallest value that falls into a bucket
+ *
+ * @param[in] bucket Bucket index
+ * @return long long Lower bound, the most negative value for a bucket below LOG_AGGREGATE_ZERO_BUCKET
+ */
+long long log_aggregate_bucket_floor(int bucket);
+
+/**
+ * @brief Estimates a percentile from the histogram of a summary
+ *
+ * @param[in] summary Window statistics
+ * @param[in] percent Percentile, 0 to 100
+ * @return long long Lower bound of the bucket holding the percentile, clamped to [min, max]
+ */
+long long log_aggregate_percentile(const struct log_aggregate_summary *summary, double percent);
+
+#ifdef __linux__
+
+/**
+ * @brief CLOCK_MONOTONIC in nanoseconds, the default clock on Linux
+ *
+ * @return uint64_t
+ */
+uint64_t log_aggregate_clock_ns(void);
+
+#endif
+
+#endif /* log_aggregate_h_ */
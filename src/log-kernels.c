@@ -0,0 +1,515 @@
+/**
+ * @file log-kernels.c
+ * @brief Runtime dispatched logger kernel definitions
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* System includes */
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+
+#include <immintrin.h>
+
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+
+#include <arm_neon.h>
+
+#endif
+
+/* Local includes */
+#include "cpu-features.h"
+#include "log-kernels.h"
+
+#define CRC32C_POLY 0x82F63B78u /* Castagnoli polynomial, reflected */
+
+static const char digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static uint32_t crc32c_table[256];
+
+static void build_crc32c_table(void)
+{
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; bit++)
+        {
+            crc = (crc >> 1) ^ (CRC32C_POLY & (0u - (crc & 1)));
+        }
+        crc32c_table[i] = crc;
+    }
+}
+
+/* Portable kernels */
+
+static void *copy_generic(void *dst, const void *src, size_t length)
+{
+    return memcpy(dst, src, length);
+}
+
+static uint32_t crc32c_generic(uint32_t crc, const void *data, size_t length)
+{
+    const unsigned char *p = data;
+
+    /* Entry 1 is never zero once built; covers calls made before log_kernels_init() */
+    if (crc32c_table[1] == 0)
+    {
+        build_crc32c_table();
+    }
+
+    crc = ~crc;
+    while (length--)
+    {
+        crc = crc32c_table[(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+static size_t format_u64_generic(char *dst, uint64_t value)
+{
+    char digits[LOG_U64_MAX_DIGITS];
+    char *p = digits + sizeof(digits);
+
+    /* Two digits per division */
+    while (value >= 100)
+    {
+        unsigned int pair = (unsigned int)(value % 100) * 2;
+        value /= 100;
+        *--p = digit_pairs[pair + 1];
+        *--p = digit_pairs[pair];
+    }
+    if (value >= 10)
+    {
+        unsigned int pair = (unsigned int)value * 2;
+        *--p = digit_pairs[pair + 1];
+        *--p = digit_pairs[pair];
+    }
+    else
+    {
+        *--p = (char)('0' + value);
+    }
+
+    size_t length = (size_t)(digits + sizeof(digits) - p);
+    memcpy(dst, p, length);
+    return length;
+}
+
+static size_t find_marker_generic(const char *data, size_t length)
+{
+    size_t i = 0;
+
+    while (i + LOG_MARKER_LENGTH <= length)
+    {
+        const char *candidate = memchr(data + i, LOG_MARKER[0], length - i - (LOG_MARKER_LENGTH - 1));
+        if (candidate == NULL)
+        {
+            break;
+        }
+
+        i = (size_t)(candidate - data);
+        if (candidate[1] == LOG_MARKER[1] && candidate[2] == LOG_MARKER[2])
+        {
+            return i;
+        }
+        i++;
+    }
+    return length;
+}
+
+static size_t find_pattern_generic(const char *data, size_t length, const char *pattern, size_t pattern_length)
+{
+    if (pattern_length == 0)
+    {
+        return 0;
+    }
+
+    size_t i = 0;
+    while (i + pattern_length <= length)
+    {
+        const char *candidate = memchr(data + i, pattern[0], length - i - (pattern_length - 1));
+        if (candidate == NULL)
+        {
+            break;
+        }
+
+        i = (size_t)(candidate - data);
+        if (memcmp(candidate + 1, pattern + 1, pattern_length - 1) == 0)
+        {
+            return i;
+        }
+        i++;
+    }
+    return length;
+}
+
+static const struct log_kernels generic_kernels = {
+    .name = "generic",
+    .copy = copy_generic,
+    .crc32c = crc32c_generic,
+    .format_u64 = format_u64_generic,
+    .find_marker = find_marker_generic,
+    .find_pattern = find_pattern_generic,
+};
+
+const struct log_kernels *log_kernels = &generic_kernels;
+
+#if defined(__x86_64__)
+
+/*
+ * Marker scans compare a block against the marker's first byte and the block shifted by one against
+ * its second byte; only positions where both match have their third byte checked. Loops stop early
+ * enough that the third byte of every candidate is in bounds, and the scalar kernel takes the tail.
+ */
+
+static size_t find_marker_tail(const char *data, size_t length, size_t i)
+{
+    return i + find_marker_generic(data + i, length - i);
+}
+
+/* SSE2 tier: part of the x86-64 baseline, so always available */
+
+static size_t find_marker_sse2(const char *data, size_t length)
+{
+    const __m128i first = _mm_set1_epi8(LOG_MARKER[0]);
+    const __m128i second = _mm_set1_epi8(LOG_MARKER[1]);
+    size_t i = 0;
+
+    while (i + 16 + LOG_MARKER_LENGTH - 1 <= length)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i *)(data + i));
+        __m128i shifted = _mm_loadu_si128((const __m128i *)(data + i + 1));
+        unsigned mask = (unsigned)_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(block, first), _mm_cmpeq_epi8(shifted, second)));
+
+        while (mask != 0)
+        {
+            unsigned bit = (unsigned)__builtin_ctz(mask);
+            if (data[i + bit + 2] == LOG_MARKER[2])
+            {
+                return i + bit;
+            }
+            mask &= mask - 1;
+        }
+        i += 16;
+    }
+    return find_marker_tail(data, length, i);
+}
+
+static size_t find_pattern_sse2(const char *data, size_t length, const char *pattern, size_t pattern_length)
+{
+    if (pattern_length < 2)
+    {
+        return find_pattern_generic(data, length, pattern, pattern_length);
+    }
+
+    const __m128i first = _mm_set1_epi8(pattern[0]);
+    const __m128i last = _mm_set1_epi8(pattern[pattern_length - 1]);
+    size_t i = 0;
+
+    while (i + 16 + pattern_length - 1 <= length)
+    {
+        __m128i head = _mm_loadu_si128((const __m128i *)(data + i));
+        __m128i tail = _mm_loadu_si128((const __m128i *)(data + i + pattern_length - 1));
+        unsigned mask = (unsigned)_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(head, first), _mm_cmpeq_epi8(tail, last)));
+
+        while (mask != 0)
+        {
+            unsigned bit = (unsigned)__builtin_ctz(mask);
+            if (memcmp(data + i + bit + 1, pattern + 1, pattern_length - 2) == 0)
+            {
+                return i + bit;
+            }
+            mask &= mask - 1;
+        }
+        i += 16;
+    }
+    return i + find_pattern_generic(data + i, length - i, pattern, pattern_length);
+}
+
+/* SSE4.2 tier: hardware CRC32C */
+
+__attribute__((target("sse4.2"))) static uint32_t crc32c_sse42(uint32_t crc, const void *data, size_t length)
+{
+    const unsigned char *p = data;
+    uint64_t crc64 = ~crc;
+
+    while (length >= 8)
+    {
+        uint64_t chunk;
+        memcpy(&chunk, p, sizeof(chunk));
+        crc64 = _mm_crc32_u64(crc64, chunk);
+        p += 8;
+        length -= 8;
+    }
+
+    uint32_t crc32 = (uint32_t)crc64;
+    while (length--)
+    {
+        crc32 = _mm_crc32_u8(crc32, *p++);
+    }
+    return ~crc32;
+}
+
+/* AVX2 tier: 32 byte copies for large records; small ones stay on libc's memcpy */
+
+__attribute__((target("avx2"))) static void *copy_avx2(void *dst, const void *src, size_t length)
+{
+    unsigned char *d = dst;
+    const unsigned char *s = src;
+
+    if (length < 256)
+    {
+        return memcpy(dst, src, length);
+    }
+    while (length >= 128)
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i *)s);
+        __m256i b = _mm256_loadu_si256((const __m256i *)(s + 32));
+        __m256i c = _mm256_loadu_si256((const __m256i *)(s + 64));
+        __m256i e = _mm256_loadu_si256((const __m256i *)(s + 96));
+        _mm256_storeu_si256((__m256i *)d, a);
+        _mm256_storeu_si256((__m256i *)(d + 32), b);
+        _mm256_storeu_si256((__m256i *)(d + 64), c);
+        _mm256_storeu_si256((__m256i *)(d + 96), e);
+        s += 128;
+        d += 128;
+        length -= 128;
+    }
+    memcpy(d, s, length);
+    return dst;
+}
+
+/* AVX-512 tier: 64 byte copies with a masked tail */
+
+__attribute__((target("avx512f,avx512bw"))) static void *copy_avx512(void *dst, const void *src, size_t length)
+{
+    unsigned char *d = dst;
+    const unsigned char *s = src;
+
+    if (length < 256)
+    {
+        return memcpy(dst, src, length);
+    }
+    while (length >= 64)
+    {
+        _mm512_storeu_si512((void *)d, _mm512_loadu_si512((const void *)s));
+        s += 64;
+        d += 64;
+        length -= 64;
+    }
+    if (length > 0)
+    {
+        __mmask64 mask = (__mmask64)((1ULL << length) - 1);
+        _mm512_mask_storeu_epi8(d, mask, _mm512_maskz_loadu_epi8(mask, s));
+    }
+    return dst;
+}
+
+__attribute__((target("avx2"))) static size_t find_marker_avx2(const char *data, size_t length)
+{
+    const __m256i first = _mm256_set1_epi8(LOG_MARKER[0]);
+    const __m256i second = _mm256_set1_epi8(LOG_MARKER[1]);
+    size_t i = 0;
+
+    while (i + 32 + LOG_MARKER_LENGTH - 1 <= length)
+    {
+        __m256i block = _mm256_loadu_si256((const __m256i *)(data + i));
+        __m256i shifted = _mm256_loadu_si256((const __m256i *)(data + i + 1));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(block, first), _mm256_cmpeq_epi8(shifted, second)));
+
+        while (mask != 0)
+        {
+            unsigned bit = (unsigned)__builtin_ctz(mask);
+            if (data[i + bit + 2] == LOG_MARKER[2])
+            {
+                return i + bit;
+            }
+            mask &= mask - 1;
+        }
+        i += 32;
+    }
+    return find_marker_tail(data, length, i);
+}
+
+__attribute__((target("avx2"))) static size_t find_pattern_avx2(const char *data, size_t length,
+                                                                  const char *pattern, size_t pattern_length)
+{
+    if (pattern_length < 2)
+    {
+        return find_pattern_generic(data, length, pattern, pattern_length);
+    }
+
+    const __m256i first = _mm256_set1_epi8(pattern[0]);
+    const __m256i last = _mm256_set1_epi8(pattern[pattern_length - 1]);
+    size_t i = 0;
+
+    while (i + 32 + pattern_length - 1 <= length)
+    {
+        __m256i head = _mm256_loadu_si256((const __m256i *)(data + i));
+        __m256i tail = _mm256_loadu_si256((const __m256i *)(data + i + pattern_length - 1));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(head, first), _mm256_cmpeq_epi8(tail, last)));
+
+        while (mask != 0)
+        {
+            unsigned bit = (unsigned)__builtin_ctz(mask);
+            if (memcmp(data + i + bit + 1, pattern + 1, pattern_length - 2) == 0)
+            {
+                return i + bit;
+            }
+            mask &= mask - 1;
+        }
+        i += 32;
+    }
+    return i + find_pattern_generic(data + i, length - i, pattern, pattern_length);
+}
+
+static struct log_kernels x86_kernels;
+
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+
+/* NEON tier: narrowing shift packs the 16 byte compare into a 64-bit mask, four bits per byte */
+
+static size_t find_marker_neon(const char *data, size_t length)
+{
+    const uint8x16_t first = vdupq_n_u8((uint8_t)LOG_MARKER[0]);
+    const uint8x16_t second = vdupq_n_u8((uint8_t)LOG_MARKER[1]);
+    size_t i = 0;
+
+    while (i + 16 + LOG_MARKER_LENGTH - 1 <= length)
+    {
+        uint8x16_t block = vld1q_u8((const uint8_t *)data + i);
+        uint8x16_t shifted = vld1q_u8((const uint8_t *)data + i + 1);
+        uint8x16_t match = vandq_u8(vceqq_u8(block, first), vceqq_u8(shifted, second));
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(match), 4)), 0);
+
+        while (mask != 0)
+        {
+            unsigned bit = (unsigned)__builtin_ctzll(mask) / 4;
+            if (data[i + bit + 2] == LOG_MARKER[2])
+            {
+                return i + bit;
+            }
+            mask &= ~(0xFULL << (bit * 4));
+        }
+        i += 16;
+    }
+    return i + find_marker_generic(data + i, length - i);
+}
+
+static size_t find_pattern_neon(const char *data, size_t length, const char *pattern, size_t pattern_length)
+{
+    if (pattern_length < 2)
+    {
+        return find_pattern_generic(data, length, pattern, pattern_length);
+    }
+
+    const uint8x16_t first = vdupq_n_u8((uint8_t)pattern[0]);
+    const uint8x16_t last = vdupq_n_u8((uint8_t)pattern[pattern_length - 1]);
+    size_t i = 0;
+
+    while (i + 16 + pattern_length - 1 <= length)
+    {
+        uint8x16_t head = vld1q_u8((const uint8_t *)data + i);
+        uint8x16_t tail = vld1q_u8((const uint8_t *)data + i + pattern_length - 1);
+        uint8x16_t match = vandq_u8(vceqq_u8(head, first), vceqq_u8(tail, last));
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(match), 4)), 0);
+
+        while (mask != 0)
+        {
+            unsigned bit = (unsigned)__builtin_ctzll(mask) / 4;
+            if (memcmp(data + i + bit + 1, pattern + 1, pattern_length - 2) == 0)
+            {
+                return i + bit;
+            }
+            mask &= ~(0xFULL << (bit * 4));
+        }
+        i += 16;
+    }
+    return i + find_pattern_generic(data + i, length - i, pattern, pattern_length);
+}
+
+static struct log_kernels arm_kernels;
+
+#endif /* __x86_64__ */
+
+__attribute__((constructor)) void log_kernels_init(void)
+{
+    build_crc32c_table();
+
+#if defined(__x86_64__)
+    const struct cpu_features *features = get_cpu_features();
+
+    /* Each kernel is picked independently so partial feature sets still get what they support */
+    x86_kernels = generic_kernels;
+    x86_kernels.find_marker = find_marker_sse2;
+    x86_kernels.find_pattern = find_pattern_sse2;
+    if (features->sse42)
+    {
+        x86_kernels.name = "sse4.2";
+        x86_kernels.crc32c = crc32c_sse42;
+    }
+    if (features->avx2)
+    {
+        x86_kernels.name = "avx2";
+        x86_kernels.copy = copy_avx2;
+        x86_kernels.find_marker = find_marker_avx2;
+        x86_kernels.find_pattern = find_pattern_avx2;
+    }
+    if (features->avx512bw)
+    {
+        x86_kernels.name = "avx512";
+        x86_kernels.copy = copy_avx512;
+    }
+    log_kernels = &x86_kernels;
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    arm_kernels = generic_kernels;
+    arm_kernels.name = "neon";
+    arm_kernels.find_marker = find_marker_neon;
+    arm_kernels.find_pattern = find_pattern_neon;
+    log_kernels = &arm_kernels;
+#endif
+}
@@ -0,0 +1,110 @@
+/**
+ * @file log-kernels.h
+ * @brief Runtime dispatched logger kernel declarations
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef log_kernels_h_
+#define log_kernels_h_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define LOG_U64_MAX_DIGITS 20
+
+#define LOG_MARKER "[*]" /* Frames records in RAM-FS files */
+#define LOG_MARKER_LENGTH 3
+
+/**
+ * @brief Table of the logger's hot kernels
+ *
+ * One table exists per instruction set tier. The best table for the running CPU is selected once at
+ * startup, so a single binary runs the widest kernels available on every machine it is deployed to.
+ */
+struct log_kernels
+{
+    const char *name; /**< Tier name, e.g. "generic" or "avx2" */
+
+    /**
+     * @brief Copies a formatted record into a transport buffer
+     */
+    void *(*copy)(void *dst, const void *src, size_t length);
+
+    /**
+     * @brief Updates a CRC-32C (Castagnoli) checksum
+     *
+     * Start with crc = 0. The returned value can be passed back in to checksum data in pieces.
+     */
+    uint32_t (*crc32c)(uint32_t crc, const void *data, size_t length);
+
+    /**
+     * @brief Formats an unsigned integer in decimal without a null terminator
+     *
+     * @return size_t Number of characters written, at most LOG_U64_MAX_DIGITS
+     */
+    size_t (*format_u64)(char *dst, uint64_t value);
+
+    /**
+     * @brief Finds the first LOG_MARKER in a buffer
+     *
+     * @return size_t Offset of the marker, or length if there is none
+     */
+    size_t (*find_marker)(const char *data, size_t length);
+
+    /**
+     * @brief Finds the first occurrence of a pattern in a buffer
+     *
+     * The wide tiers prefilter candidates on the pattern's first and last byte and only compare the
+     * bytes in between at positions where both match.
+     *
+     * @return size_t Offset of the match, or length if there is none. An empty pattern matches at 0.
+     */
+    size_t (*find_pattern)(const char *data, size_t length, const char *pattern, size_t pattern_length);
+};
+
+/**
+ * @brief Kernels selected for the running CPU
+ *
+ * Points at the portable implementations until startup selection runs, so it is always safe to call
+ * through.
+ */
+extern const struct log_kernels *log_kernels;
+
+/**
+ * @brief Selects the kernels for the running CPU
+ *
+ * Runs automatically before main(). Calling it again is harmless.
+ */
+void log_kernels_init(void);
+
+#endif /* log_kernels_h_ */
@@ -0,0 +1,389 @@
+/**
+ * @file log-ring.c
+ * @brief Crash-safe memory mapped ring log definitions
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#endif
+
+/* Local includes */
+#include "log-kernels.h"
+#include "log-ring.h"
+
+#ifdef __linux__
+
+#define RING_DATA_OFFSET 4096 /* The header gets its own page; records start on the next one */
+#define RING_ALIGN_UP(n) (((n) + LOG_RING_ALIGN - 1) & ~(size_t)(LOG_RING_ALIGN - 1))
+
+struct ring_entry
+{
+    uint64_t sequence;
+    uint64_t offset;
+};
+
+struct ring_state
+{
+    struct log_sink sink;
+    int fd;
+    size_t map_size;
+    struct log_ring_header *header;
+    unsigned char *area;
+};
+
+static uint32_t record_crc(uint64_t sequence, uint32_t length, const void *payload)
+{
+    uint32_t crc = log_kernels->crc32c(0, &sequence, sizeof(sequence));
+    crc = log_kernels->crc32c(crc, &length, sizeof(length));
+    return log_kernels->crc32c(crc, payload, length);
+}
+
+/* Returns the payload length if a valid record starts at offset, -1 otherwise */
+static long record_at(const unsigned char *area, uint64_t capacity, uint64_t offset)
+{
+    struct log_ring_record record;
+
+    if (offset + sizeof(record) > capacity)
+    {
+        return -1;
+    }
+    memcpy(&record, area + offset, sizeof(record));
+    if (record.magic != LOG_RING_RECORD_MAGIC || record.length > capacity - offset - sizeof(record))
+    {
+        return -1;
+    }
+    if (record_crc(record.sequence, record.length, area + offset + sizeof(record)) != record.crc)
+    {
+        return -1;
+    }
+    return (long)record.length;
+}
+
+static int compare_entries(const void *a, const void *b)
+{
+    const struct ring_entry *left = a;
+    const struct ring_entry *right = b;
+
+    return (left->sequence > right->sequence) - (left->sequence < right->sequence);
+}
+
+/**
+ * Walks the record area and collects every valid record, sorted by sequence. On a bad record the
+ * walk resyncs on the next LOG_RING_ALIGN boundary. *entries must be freed by the caller.
+ */
+static long ring_scan(const unsigned char *area, uint64_t capacity, struct ring_entry **entries)
+{
+    size_t limit = capacity / (sizeof(struct log_ring_record) + LOG_RING_ALIGN) + 1;
+    long count = 0;
+
+    *entries = malloc(limit * sizeof(struct ring_entry));
+    if (*entries == NULL)
+    {
+        fprintf(stderr, "Memory allocation failed.\n");
+        return -1;
+    }
+
+    uint64_t offset = 0;
+    while (offset + sizeof(struct log_ring_record) <= capacity)
+    {
+        long length = record_at(area, capacity, offset);
+        if (length < 0)
+        {
+            offset += LOG_RING_ALIGN;
+            continue;
+        }
+
+        const struct log_ring_record *record = (const struct log_ring_record *)(area + offset);
+        (*entries)[count].sequence = record->sequence;
+        (*entries)[count].offset = offset;
+        count++;
+        offset += RING_ALIGN_UP(sizeof(struct log_ring_record) + (size_t)length);
+    }
+
+    qsort(*entries, (size_t)count, sizeof(struct ring_entry), compare_entries);
+    return count;
+}
+
+static int ring_header_valid(const struct log_ring_header *header, size_t file_size)
+{
+    return header->magic == LOG_RING_MAGIC && header->version == LOG_RING_VERSION &&
+           header->capacity >= LOG_RING_MIN_BYTES && header->capacity <= file_size - RING_DATA_OFFSET;
+}
+
+/* Hot path: a copy and a CRC into the shared mapping, no syscalls */
+static int ring_write(struct log_sink *sink, const char *data, size_t length)
+{
+    struct ring_state *state = sink->context;
+    struct log_ring_header *header = state->header;
+    size_t total = RING_ALIGN_UP(sizeof(struct log_ring_record) + length);
+
+    if (total > header->capacity)
+    {
+        return -1;
+    }
+    if (header->write_index + total > header->capacity)
+    {
+        header->write_index = 0;
+        header->wrap_count++;
+    }
+
+    unsigned char *slot = state->area + header->write_index;
+    struct log_ring_record *record = (struct log_ring_record *)slot;
+    uint64_t sequence = header->next_sequence;
+
+    /* Clear the magic first so a crash mid-copy leaves no header in front of a torn payload */
+    __atomic_store_n(&record->magic, 0, __ATOMIC_RELAXED);
+    log_kernels->copy(slot + sizeof(struct log_ring_record), data, length);
+    record->length = (uint32_t)length;
+    record->sequence = sequence;
+    record->crc = record_crc(sequence, (uint32_t)length, data);
+    record->reserved = 0;
+    __atomic_store_n(&record->magic, LOG_RING_RECORD_MAGIC, __ATOMIC_RELEASE);
+
+    header->write_index += total;
+    header->next_sequence = sequence + 1;
+    return 0;
+}
+
+/* The pages already belong to the kernel; flushing only starts writeback early */
+static int ring_flush(struct log_sink *sink)
+{
+    struct ring_state *state = sink->context;
+
+    return msync(state->header, state->map_size, MS_ASYNC);
+}
+
+static void ring_close(struct log_sink *sink)
+{
+    struct ring_state *state = sink->context;
+
+    msync(state->header, state->map_size, MS_SYNC);
+    munmap(state->header, state->map_size);
+    close(state->fd);
+    free(state);
+}
+
+/* Continues after the newest valid record of an existing ring */
+static int ring_resume(struct ring_state *state)
+{
+    struct log_ring_header *header = state->header;
+    struct ring_entry *entries;
+
+    long count = ring_scan(state->area, header->capacity, &entries);
+    if (count < 0)
+    {
+        return -1;
+    }
+    if (count > 0)
+    {
+        const struct ring_entry *newest = &entries[count - 1];
+        const struct log_ring_record *record = (const struct log_ring_record *)(state->area + newest->offset);
+
+        header->write_index = newest->offset + RING_ALIGN_UP(sizeof(struct log_ring_record) + record->length);
+        header->next_sequence = newest->sequence + 1;
+    }
+    free(entries);
+    return 0;
+}
+
+struct log_sink *log_sink_mmap_ring(const char *path, size_t bytes)
+{
+    struct stat info;
+
+    int fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd == -1)
+    {
+        perror("open");
+        return NULL;
+    }
+    if (fstat(fd, &info) == -1)
+    {
+        perror("fstat");
+        close(fd);
+        return NULL;
+    }
+
+    int fresh = info.st_size < RING_DATA_OFFSET;
+    size_t map_size = (size_t)info.st_size;
+    if (fresh)
+    {
+        if (bytes < LOG_RING_MIN_BYTES)
+        {
+            bytes = LOG_RING_MIN_BYTES;
+        }
+        bytes = RING_ALIGN_UP(bytes);
+        map_size = RING_DATA_OFFSET + bytes;
+
+        /* Reserve the blocks now so a full disk cannot SIGBUS a store later */
+        int error = posix_fallocate(fd, 0, (off_t)map_size);
+        if (error != 0)
+        {
+            fprintf(stderr, "posix_fallocate: %s\n", strerror(error));
+            close(fd);
+            return NULL;
+        }
+    }
+
+    void *map = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED)
+    {
+        perror("mmap");
+        close(fd);
+        return NULL;
+    }
+
+    struct ring_state *state = malloc(sizeof(struct ring_state));
+    if (state == NULL)
+    {
+        fprintf(stderr, "Memory allocation failed.\n");
+        munmap(map, map_size);
+        close(fd);
+        return NULL;
+    }
+    state->fd = fd;
+    state->map_size = map_size;
+    state->header = map;
+    state->area = (unsigned char *)map + RING_DATA_OFFSET;
+    state->sink.context = state;
+
+    struct log_ring_header *header = state->header;
+    if (fresh)
+    {
+        header->version = LOG_RING_VERSION;
+        header->capacity = bytes;
+        header->write_index = 0;
+        header->wrap_count = 0;
+        header->next_sequence = 0;
+        __atomic_store_n(&header->magic, LOG_RING_MAGIC, __ATOMIC_RELEASE);
+    }
+    else if (!ring_header_valid(header, map_size) || ring_resume(state) == -1)
+    {
+        fprintf(stderr, "%s is not a usable log ring\n", path);
+        ring_close(&state->sink);
+        return NULL;
+    }
+
+    state->sink.name = "mmap-ring";
+    state->sink.write = ring_write;
+    state->sink.write_level = NULL;
+    state->sink.flush = ring_flush;
+    state->sink.close = ring_close;
+    state->sink.colorize = 0;
+    return &state->sink;
+}
+
+int log_ring_recover(const char *path, log_ring_callback callback, void *context)
+{
+    struct stat info;
+    struct ring_entry *entries;
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+    {
+        perror("open");
+        return -1;
+    }
+    if (fstat(fd, &info) == -1 || info.st_size < RING_DATA_OFFSET)
+    {
+        fprintf(stderr, "%s is not a log ring\n", path);
+        close(fd);
+        return -1;
+    }
+
+    size_t map_size = (size_t)info.st_size;
+    void *map = mmap(NULL, map_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        perror("mmap");
+        return -1;
+    }
+
+    const struct log_ring_header *header = map;
+    const unsigned char *area = (const unsigned char *)map + RING_DATA_OFFSET;
+    if (!ring_header_valid(header, map_size))
+    {
+        fprintf(stderr, "%s is not a log ring\n", path);
+        munmap(map, map_size);
+        return -1;
+    }
+
+    long count = ring_scan(area, header->capacity, &entries);
+    for (long i = 0; i < count; i++)
+    {
+        const struct log_ring_record *record = (const struct log_ring_record *)(area + entries[i].offset);
+        callback(record->sequence, (const char *)(record + 1), record->length, context);
+    }
+
+    if (count >= 0)
+    {
+        free(entries);
+    }
+    munmap(map, map_size);
+    return count < 0 ? -1 : (int)count;
+}
+
+#else /* If linux is not found */
+
+struct log_sink *log_sink_mmap_ring(const char *path, size_t bytes)
+{
+    (void)path;
+    (void)bytes;
+    return NULL;
+}
+
+int log_ring_recover(const char *path, log_ring_callback callback, void *context)
+{
+    (void)path;
+    (void)callback;
+    (void)context;
+    return -1;
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,116 @@
+/**
+ * @file log-ring.h
+ * @brief Crash-safe memory mapped ring log declarations
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef log_ring_h_
+#define log_ring_h_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "log-sink.h"
+
+#define LOG_RING_MAGIC 0x474E5241u        /* "ARNG", file header */
+#define LOG_RING_RECORD_MAGIC 0x52474F4Cu /* "LOGR", start of every record */
+#define LOG_RING_VERSION 1
+#define LOG_RING_ALIGN 8                  /* Records start on 8 byte boundaries so recovery can resync */
+#define LOG_RING_MIN_BYTES (64 * 1024)
+
+/**
+ * @brief Header at the start of the ring file
+ *
+ * write_index and wrap_count are hints: recovery trusts only records whose checksum matches, so a
+ * crash between writing a record and updating the header loses nothing.
+ */
+struct log_ring_header
+{
+    uint32_t magic;         /**< LOG_RING_MAGIC */
+    uint32_t version;       /**< LOG_RING_VERSION */
+    uint64_t capacity;      /**< Bytes in the record area following the header */
+    uint64_t write_index;   /**< Offset of the next record in the record area */
+    uint64_t wrap_count;    /**< Times the writer has wrapped back to offset 0 */
+    uint64_t next_sequence; /**< Sequence number of the next record */
+};
+
+/**
+ * @brief Header in front of each record's payload
+ */
+struct log_ring_record
+{
+    uint32_t magic;    /**< LOG_RING_RECORD_MAGIC */
+    uint32_t length;   /**< Payload bytes, excluding this header and padding */
+    uint64_t sequence; /**< Monotonic across wraps and restarts */
+    uint32_t crc;      /**< CRC32C of sequence, length and payload */
+    uint32_t reserved;
+};
+
+/**
+ * @brief Receives one recovered record
+ *
+ * @param[in] sequence Record sequence number
+ * @param[in] data     Payload, not NUL terminated; only valid during the call
+ * @param[in] length   Payload bytes
+ * @param[in] context  Pointer passed to log_ring_recover()
+ */
+typedef void (*log_ring_callback)(uint64_t sequence, const char *data, size_t length, void *context);
+
+/**
+ * @brief Opens a sink that writes into a preallocated, memory mapped ring file
+ *
+ * The file is created and sized on first use. Writing a record is a copy into the shared mapping plus
+ * a CRC, with no syscall, and the kernel keeps the pages even if the process crashes. An existing ring
+ * is recovered so sequence numbers continue after the newest valid record. Linux only.
+ *
+ * @param[in] path  Ring file
+ * @param[in] bytes Size of the record area, at least LOG_RING_MIN_BYTES; ignored for an existing ring
+ * @return struct log_sink* NULL on failure
+ */
+struct log_sink *log_sink_mmap_ring(const char *path, size_t bytes);
+
+/**
+ * @brief Scans a ring file and hands back its valid records, oldest first
+ *
+ * The record area is walked on LOG_RING_ALIGN boundaries. Anything that does not carry the record
+ * magic and a matching CRC, such as a record torn by a crash or partly overwritten after a wrap, is
+ * skipped and the scan resyncs on the next boundary.
+ *
+ * @param[in] path     Ring file
+ * @param[in] callback Called for each valid record in sequence order
+ * @param[in] context  Passed through to the callback
+ * @return int Number of records recovered, -1 for failure
+ */
+int log_ring_recover(const char *path, log_ring_callback callback, void *context);
+
+#endif /* log_ring_h_ */
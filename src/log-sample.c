@@ -0,0 +1,193 @@
+/**
+ * @file log-sample.c
+ * @brief Adaptive sampling of hot log sites definitions
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef __linux__
+
+#include <time.h>
+
+#endif
+
+/* Local includes */
+#include "log-sample.h"
+
+#ifdef __linux__
+
+uint64_t log_sample_clock_ns(void)
+{
+    struct timespec now;
+
+    /* Read through the vDSO, and only on emitted calls or every LOG_SAMPLE_CHECK_CALLS calls */
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+static uint64_t (*sample_clock)(void) = log_sample_clock_ns;
+static uint64_t sample_ticks_per_second = 1000000000ULL;
+
+#else
+
+static uint64_t (*sample_clock)(void);
+static uint64_t sample_ticks_per_second;
+
+#endif
+
+static uint32_t sample_budget = LOG_SAMPLE_DEFAULT_BUDGET;
+static uint32_t sample_window_ms = LOG_SAMPLE_DEFAULT_WINDOW_MS;
+
+struct module_site
+{
+    const void *module;
+    struct log_sample_site site;
+};
+
+static LOG_SAMPLE_THREAD_LOCAL struct module_site module_sites[LOG_SAMPLE_MODULE_SITES];
+
+int log_sample_configure(uint32_t budget, uint32_t window_ms, uint64_t (*clock)(void), uint64_t ticks_per_second)
+{
+    if (clock != NULL && ticks_per_second == 0)
+    {
+        fprintf(stderr, "Sampling clock needs a tick rate.\n");
+        return -1;
+    }
+    if (budget > 0)
+    {
+        sample_budget = budget;
+    }
+    if (window_ms > 0)
+    {
+        sample_window_ms = window_ms;
+    }
+    if (clock != NULL)
+    {
+        sample_clock = clock;
+        sample_ticks_per_second = ticks_per_second;
+    }
+    return 0;
+}
+
+/* Smallest shift that keeps calls made over elapsed ticks within the budget */
+static uint32_t shift_for(uint64_t calls, uint64_t elapsed, uint32_t budget)
+{
+    double needed = (double)calls * (double)sample_ticks_per_second / ((double)budget * (double)(elapsed > 0 ? elapsed : 1));
+    uint32_t shift = 0;
+
+    while (shift < LOG_SAMPLE_MAX_SHIFT && (double)((uint32_t)1 << shift) < needed)
+    {
+        shift++;
+    }
+    return shift;
+}
+
+uint32_t log_sample_emit(struct log_sample_site *site, uint32_t budget)
+{
+    uint32_t factor = (uint32_t)1 << site->shift;
+
+    if (sample_clock == NULL)
+    {
+        return 1;
+    }
+
+    uint32_t limit = budget > 0 ? budget : sample_budget;
+    uint64_t allowance = (uint64_t)limit * sample_window_ms / 1000;
+
+    /* An emitted call stands for the factor calls counted down to it */
+    site->calls += factor;
+    site->emitted++;
+    if (site->shift > 0 || site->window_start == 0 || site->calls % LOG_SAMPLE_CHECK_CALLS == 0 ||
+        site->emitted > allowance)
+    {
+        uint64_t now = sample_clock();
+        uint64_t window = (uint64_t)sample_window_ms * sample_ticks_per_second / 1000;
+        uint64_t elapsed = now - site->window_start;
+
+        if (site->window_start == 0)
+        {
+            site->window_start = now;
+        }
+        else if (elapsed >= window || site->emitted > allowance)
+        {
+            uint32_t shift = shift_for(site->calls, elapsed, limit);
+            if (elapsed < window && shift <= site->shift)
+            {
+                /* The window's budget is spent early, so N doubles at least */
+                shift = site->shift < LOG_SAMPLE_MAX_SHIFT ? site->shift + 1 : LOG_SAMPLE_MAX_SHIFT;
+            }
+            else if (elapsed >= window && shift < site->shift)
+            {
+                /* Back off one step per window so a bursty site does not flap */
+                shift = site->shift - 1;
+            }
+            site->shift = shift;
+            site->calls = 0;
+            site->emitted = 0;
+            site->window_start = now;
+        }
+    }
+
+    site->countdown = (uint32_t)1 << site->shift;
+    return factor;
+}
+
+struct log_sample_site *log_sample_module_site(const void *module)
+{
+    unsigned home = (unsigned)(((uintptr_t)module >> 4) % LOG_SAMPLE_MODULE_SITES);
+
+    /* Open addressing, so colliding modules keep sites of their own until the table is full */
+    for (unsigned probe = 0; probe < LOG_SAMPLE_MODULE_SITES; probe++)
+    {
+        struct module_site *entry = &module_sites[(home + probe) % LOG_SAMPLE_MODULE_SITES];
+        if (entry->module == module)
+        {
+            return &entry->site;
+        }
+        if (entry->module == NULL)
+        {
+            entry->module = module;
+            return &entry->site;
+        }
+    }
+    /* Every site is taken: the module shares, without resetting, the site it hashes to */
+    return &module_sites[home].site;
+}
@@ -0,0 +1,162 @@
+/**
+ * @file log-sample.h
+ * @brief Adaptive sampling of hot log sites declarations
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef log_sample_h_
+#define log_sample_h_
+
+#include <stdint.h>
+
+#define LOG_SAMPLE_DEFAULT_BUDGET 1000   /* Records per second a site may emit before it is sampled */
+#define LOG_SAMPLE_DEFAULT_WINDOW_MS 100 /* How often a site's rate is re-evaluated */
+#define LOG_SAMPLE_MAX_SHIFT 20          /* Never sample more sparsely than 1 in 2^20 */
+#define LOG_SAMPLE_CHECK_CALLS 64        /* Unsampled sites read the clock once per this many calls */
+#define LOG_SAMPLE_MODULE_SITES 16       /* Modules tracked per thread; any more share a site */
+
+/* Every thread counts its own calls; builds for targets without TLS define EATL_NO_TLS */
+#ifdef EATL_NO_TLS
+#define LOG_SAMPLE_THREAD_LOCAL
+#else
+#define LOG_SAMPLE_THREAD_LOCAL __thread
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Rate state of one log site on one thread
+ *
+ * Zero initialized means not sampling. The site emits one call in 2^shift; the skipped calls cost a
+ * decrement and a branch. The rate is measured when a window has passed, or as soon as the site has
+ * emitted a whole window's budget: above the budget, shift grows by as many steps as the measured
+ * rate needs, and at least one; once the rate falls, shift shrinks by one step per window.
+ */
+struct log_sample_site
+{
+    uint32_t countdown;    /**< Calls left until the next emitted one */
+    uint32_t calls;        /**< Calls since window_start */
+    uint32_t emitted;      /**< Calls emitted since window_start */
+    uint64_t window_start; /**< Clock when the current window opened, 0 before the first call */
+    uint32_t shift;        /**< Emitting 1 in 2^shift */
+};
+
+/**
+ * @brief Sets the budget shared by every sampled site and the clock it is measured with
+ *
+ * @param[in] budget           Records per second per site and thread, 0 keeps the current one
+ * @param[in] window_ms        Rate evaluation period, 0 keeps the current one
+ * @param[in] clock            Time source; NULL uses log_sample_clock_ns() where it exists
+ * @param[in] ticks_per_second Rate of clock, ignored when clock is NULL
+ * @return int | 0 for success -1 for failure
+ */
+int log_sample_configure(uint32_t budget, uint32_t window_ms, uint64_t (*clock)(void), uint64_t ticks_per_second);
+
+/**
+ * @brief Takes the decision for a call whose countdown has run out; use log_sample()
+ *
+ * @param[in] site   Site state of the calling thread
+ * @param[in] budget Records per second, 0 for the configured budget
+ * @return uint32_t Sampling factor of the emitted call
+ */
+uint32_t log_sample_emit(struct log_sample_site *site, uint32_t budget);
+
+/**
+ * @brief Decides whether a call is logged
+ *
+ * Without a clock, e.g. on a target that never called log_sample_configure(), every call is logged.
+ *
+ * @param[in] site   Site state of the calling thread
+ * @param[in] budget Records per second, 0 for the configured budget
+ * @return uint32_t 0 to skip the call, else the sampling factor N: the record stands for N calls
+ */
+static inline uint32_t log_sample(struct log_sample_site *site, uint32_t budget)
+{
+    if (site->countdown > 1)
+    {
+        site->countdown--;
+        return 0;
+    }
+    return log_sample_emit(site, budget);
+}
+
+/**
+ * @brief Returns the calling thread's site for a module
+ *
+ * The first LOG_SAMPLE_MODULE_SITES modules a thread samples get a site each. A module after that
+ * shares the site of one already tracked, so their calls are counted against one budget.
+ *
+ * @param[in] module Module address, used as the key
+ * @return struct log_sample_site*
+ */
+struct log_sample_site *log_sample_module_site(const void *module);
+
+#ifdef __linux__
+
+/**
+ * @brief CLOCK_MONOTONIC in nanoseconds, the default clock on Linux
+ *
+ * @return uint64_t
+ */
+uint64_t log_sample_clock_ns(void);
+
+#endif
+
+/* Logs at most the budget per second per thread from this call site, tagging records with the factor */
+#define LOG_SAMPLED_(level, label, tag, message)                                                                     \
+    do                                                                                                               \
+    {                                                                                                                \
+        static LOG_SAMPLE_THREAD_LOCAL struct log_sample_site log_site_;                                             \
+        uint32_t log_factor_ = log_sample(&log_site_, 0);                                                            \
+        if (log_factor_ == 1)                                                                                        \
+        {                                                                                                            \
+            log_printf_level(level, "%s %s: " BWHT "%s" RESET_TEXT "\n", label, tag, message);                       \
+        }                                                                                                            \
+        else if (log_factor_ > 1)                                                                                    \
+        {                                                                                                            \
+            log_printf_level(level, "%s %s: " BWHT "%s" RESET_TEXT " [sampled 1/%u]\n", label, tag, message,         \
+                             (unsigned)log_factor_);                                                                 \
+        }                                                                                                            \
+    } while (0)
+
+/* CRITICAL records are never sampled, so there is no LOG_ERROR_SAMPLED */
+#define LOG_MSG_SAMPLED(label, message) LOG_SAMPLED_(LOG_LEVEL_INFO, label, INFO_MSG, message)
+#define LOG_WARNING_SAMPLED(label, message) LOG_SAMPLED_(LOG_LEVEL_WARNING, label, WARNING_MSG, message)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* log_sample_h_ */
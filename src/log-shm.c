@@ -0,0 +1,472 @@
+/**
+ * @file log-shm.c
+ * @brief Shared memory multi-process log ring definitions
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#endif
+
+/* Local includes */
+#include "log-shm.h"
+
+#ifdef __linux__
+
+#define ATTACH_WAIT_MS 1000 /* How long an attacher waits for the creator to finish initializing */
+
+static size_t segment_size(uint32_t slot_count)
+{
+    return sizeof(struct log_shm_header) + (size_t)slot_count * sizeof(struct log_shm_slot);
+}
+
+static uint32_t round_up_pow2(unsigned value)
+{
+    uint32_t slots = 2;
+
+    while (slots < value && slots < (1u << 30))
+    {
+        slots <<= 1;
+    }
+    return slots;
+}
+
+static int map_segment(int fd, size_t size, struct log_shm *shm)
+{
+    void *map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED)
+    {
+        perror("mmap");
+        return -1;
+    }
+    shm->header = map;
+    shm->map_size = size;
+    return 0;
+}
+
+static int create_segment(int fd, unsigned slot_count, struct log_shm *shm)
+{
+    uint32_t lane_slots[LOG_LEVEL_COUNT];
+    uint32_t slots = 0;
+
+    lane_slots[LOG_LEVEL_INFO] = round_up_pow2(slot_count == 0 ? LOG_SHM_DEFAULT_SLOTS : slot_count);
+    for (int level = LOG_LEVEL_INFO + 1; level < LOG_LEVEL_COUNT; level++)
+    {
+        lane_slots[level] = lane_slots[LOG_LEVEL_INFO] / 4 < LOG_SHM_MIN_LANE_SLOTS ? LOG_SHM_MIN_LANE_SLOTS
+                                                                                    : lane_slots[LOG_LEVEL_INFO] / 4;
+    }
+    for (int level = 0; level < LOG_LEVEL_COUNT; level++)
+    {
+        slots += lane_slots[level];
+    }
+
+    size_t size = segment_size(slots);
+    if (ftruncate(fd, (off_t)size) == -1)
+    {
+        perror("ftruncate");
+        return -1;
+    }
+    if (map_segment(fd, size, shm) == -1)
+    {
+        return -1;
+    }
+
+    struct log_shm_header *header = shm->header;
+    header->version = LOG_SHM_VERSION;
+    header->slot_count = slots;
+    header->collector_pid = 0;
+    header->dropped = 0;
+    header->diverted = 0;
+
+    uint32_t first = 0;
+    for (int level = 0; level < LOG_LEVEL_COUNT; level++)
+    {
+        struct log_shm_lane *lane = &header->lanes[level];
+        lane->enqueue_pos = 0;
+        lane->dequeue_pos = 0;
+        lane->slot_count = lane_slots[level];
+        lane->first_slot = first;
+        for (uint32_t i = 0; i < lane->slot_count; i++)
+        {
+            header->slots[first + i].sequence = i;
+        }
+        first += lane->slot_count;
+    }
+    __atomic_store_n(&header->magic, LOG_SHM_MAGIC, __ATOMIC_RELEASE);
+    return 0;
+}
+
+/* Another process created the segment; wait until it is sized and initialized */
+static int open_segment(int fd, struct log_shm *shm)
+{
+    struct timespec pause = {.tv_sec = 0, .tv_nsec = 1000000L};
+    struct stat info;
+
+    for (int waited = 0; waited < ATTACH_WAIT_MS; waited++)
+    {
+        if (fstat(fd, &info) == -1)
+        {
+            perror("fstat");
+            return -1;
+        }
+        if ((size_t)info.st_size >= sizeof(struct log_shm_header))
+        {
+            if (shm->header == NULL && map_segment(fd, (size_t)info.st_size, shm) == -1)
+            {
+                return -1;
+            }
+            if (__atomic_load_n(&shm->header->magic, __ATOMIC_ACQUIRE) == LOG_SHM_MAGIC)
+            {
+                break;
+            }
+        }
+        nanosleep(&pause, NULL);
+    }
+
+    struct log_shm_header *header = shm->header;
+    if (header == NULL || header->magic != LOG_SHM_MAGIC || header->version != LOG_SHM_VERSION ||
+        segment_size(header->slot_count) > shm->map_size)
+    {
+        fprintf(stderr, "Shared memory segment is not a log ring\n");
+        return -1;
+    }
+    for (int level = 0; level < LOG_LEVEL_COUNT; level++)
+    {
+        const struct log_shm_lane *lane = &header->lanes[level];
+        if (lane->slot_count == 0 || (lane->slot_count & (lane->slot_count - 1)) != 0 ||
+            (uint64_t)lane->first_slot + lane->slot_count > header->slot_count)
+        {
+            fprintf(stderr, "Shared memory segment is not a log ring\n");
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int log_shm_attach(const char *name, unsigned slot_count, struct log_shm *shm)
+{
+    shm->header = NULL;
+    shm->map_size = 0;
+    shm->pid = (uint32_t)getpid();
+
+    int created = 1;
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0660);
+    if (fd == -1 && errno == EEXIST)
+    {
+        created = 0;
+        fd = shm_open(name, O_RDWR | O_CLOEXEC, 0);
+    }
+    if (fd == -1)
+    {
+        perror("shm_open");
+        return -1;
+    }
+
+    int status = created ? create_segment(fd, slot_count, shm) : open_segment(fd, shm);
+    close(fd);
+    if (status == -1)
+    {
+        log_shm_detach(shm);
+        if (created)
+        {
+            shm_unlink(name);
+        }
+    }
+    return status;
+}
+
+void log_shm_detach(struct log_shm *shm)
+{
+    if (shm->header != NULL)
+    {
+        munmap(shm->header, shm->map_size);
+        shm->header = NULL;
+    }
+}
+
+void log_shm_unlink(const char *name)
+{
+    shm_unlink(name);
+}
+
+/* Claims a free slot of a lane; NULL when the lane is full */
+static struct log_shm_slot *claim_slot(struct log_shm_header *header, struct log_shm_lane *lane, uint64_t *claimed)
+{
+    uint64_t mask = lane->slot_count - 1;
+
+    /* The slot is free when its sequence equals the position */
+    uint64_t pos = __atomic_load_n(&lane->enqueue_pos, __ATOMIC_RELAXED);
+    for (;;)
+    {
+        struct log_shm_slot *slot = &header->slots[lane->first_slot + (pos & mask)];
+        uint64_t sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+        int64_t difference = (int64_t)(sequence - pos);
+
+        if (difference == 0)
+        {
+            if (__atomic_compare_exchange_n(&lane->enqueue_pos, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                *claimed = pos;
+                return slot;
+            }
+        }
+        else if (difference < 0)
+        {
+            /* Full: the collector has not freed this slot since the last lap */
+            return NULL;
+        }
+        else
+        {
+            pos = __atomic_load_n(&lane->enqueue_pos, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+static int collector_alive(const struct log_shm_header *header)
+{
+    pid_t pid = (pid_t)__atomic_load_n(&header->collector_pid, __ATOMIC_RELAXED);
+    return pid != 0 && (kill(pid, 0) == 0 || errno == EPERM);
+}
+
+/* A CRITICAL record found its lane full: wait for the collector, or bypass it */
+static struct log_shm_slot *claim_critical_slot(struct log_shm_header *header, struct log_shm_lane *lane,
+                                                uint64_t *claimed)
+{
+    struct timespec pause = {.tv_sec = 0, .tv_nsec = 50000L};
+    struct log_shm_slot *slot = NULL;
+
+    for (long waited_us = 0; slot == NULL && waited_us < LOG_SHM_CRITICAL_WAIT_MS * 1000L; waited_us += 50)
+    {
+        if (!collector_alive(header))
+        {
+            break;
+        }
+        nanosleep(&pause, NULL);
+        slot = claim_slot(header, lane, claimed);
+    }
+    return slot;
+}
+
+int log_shm_publish(struct log_shm *shm, enum log_level level, const char *data, size_t length)
+{
+    struct log_shm_header *header = shm->header;
+    struct timespec now;
+    uint64_t pos;
+
+    if ((unsigned)level >= LOG_LEVEL_COUNT)
+    {
+        level = LOG_LEVEL_INFO;
+    }
+
+    struct log_shm_lane *lane = &header->lanes[level];
+    struct log_shm_slot *slot = claim_slot(header, lane, &pos);
+    if (slot == NULL && level == LOG_LEVEL_CRITICAL)
+    {
+        slot = claim_critical_slot(header, lane, &pos);
+        if (slot == NULL)
+        {
+            /* Never lost: with no collector to hand it to, the record goes out directly */
+            __atomic_fetch_add(&header->diverted, 1, __ATOMIC_RELAXED);
+            return write(STDERR_FILENO, data, length) == (ssize_t)length ? 0 : -1;
+        }
+    }
+    if (slot == NULL)
+    {
+        __atomic_fetch_add(&header->dropped, 1, __ATOMIC_RELAXED);
+        return -1;
+    }
+
+    if (length > sizeof(slot->data))
+    {
+        length = sizeof(slot->data);
+        slot->data[length - 1] = '\n';
+        memcpy(slot->data, data, length - 1);
+    }
+    else
+    {
+        memcpy(slot->data, data, length);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    slot->timestamp_ns = (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+    slot->pid = shm->pid;
+    slot->length = (uint16_t)length;
+    slot->level = (uint16_t)level;
+    __atomic_store_n(&slot->sequence, pos + 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+int log_shm_consume(struct log_shm *shm, struct log_shm_slot *out)
+{
+    struct log_shm_header *header = shm->header;
+
+    /* Most severe lane first */
+    for (int level = LOG_LEVEL_COUNT - 1; level >= 0; level--)
+    {
+        struct log_shm_lane *lane = &header->lanes[level];
+        uint64_t pos = lane->dequeue_pos;
+        struct log_shm_slot *slot = &header->slots[lane->first_slot + (pos & (lane->slot_count - 1))];
+
+        if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) != pos + 1)
+        {
+            continue;
+        }
+
+        out->timestamp_ns = slot->timestamp_ns;
+        out->pid = slot->pid;
+        out->length = slot->length;
+        out->level = slot->level;
+        memcpy(out->data, slot->data, slot->length);
+
+        /* Hand the slot to the producer one lap ahead */
+        __atomic_store_n(&slot->sequence, pos + lane->slot_count, __ATOMIC_RELEASE);
+        __atomic_store_n(&lane->dequeue_pos, pos + 1, __ATOMIC_RELAXED);
+        return 1;
+    }
+    return 0;
+}
+
+static int shm_sink_write(struct log_sink *sink, const char *data, size_t length)
+{
+    return log_shm_publish(sink->context, LOG_LEVEL_INFO, data, length);
+}
+
+static int shm_sink_write_level(struct log_sink *sink, enum log_level level, const char *data, size_t length)
+{
+    return log_shm_publish(sink->context, level, data, length);
+}
+
+static int shm_sink_flush(struct log_sink *sink)
+{
+    (void)sink;
+    return 0;
+}
+
+static void shm_sink_close(struct log_sink *sink)
+{
+    log_shm_detach(sink->context);
+    free(sink->context);
+    free(sink);
+}
+
+struct log_sink *log_sink_shm(const char *name)
+{
+    struct log_sink *sink = malloc(sizeof(struct log_sink));
+    struct log_shm *shm = malloc(sizeof(struct log_shm));
+
+    if (sink == NULL || shm == NULL)
+    {
+        fprintf(stderr, "Memory allocation failed.\n");
+        free(sink);
+        free(shm);
+        return NULL;
+    }
+    if (log_shm_attach(name, LOG_SHM_DEFAULT_SLOTS, shm) == -1)
+    {
+        free(sink);
+        free(shm);
+        return NULL;
+    }
+
+    sink->name = "shm";
+    sink->write = shm_sink_write;
+    sink->write_level = shm_sink_write_level;
+    sink->flush = shm_sink_flush;
+    sink->close = shm_sink_close;
+    sink->colorize = 1;
+    sink->context = shm;
+    return sink;
+}
+
+#else /* If linux is not found */
+
+int log_shm_attach(const char *name, unsigned slot_count, struct log_shm *shm)
+{
+    (void)name;
+    (void)slot_count;
+    shm->header = NULL;
+    shm->map_size = 0;
+    return -1;
+}
+
+void log_shm_detach(struct log_shm *shm)
+{
+    (void)shm;
+}
+
+void log_shm_unlink(const char *name)
+{
+    (void)name;
+}
+
+int log_shm_publish(struct log_shm *shm, enum log_level level, const char *data, size_t length)
+{
+    (void)shm;
+    (void)level;
+    (void)data;
+    (void)length;
+    return -1;
+}
+
+int log_shm_consume(struct log_shm *shm, struct log_shm_slot *slot)
+{
+    (void)shm;
+    (void)slot;
+    return 0;
+}
+
+struct log_sink *log_sink_shm(const char *name)
+{
+    (void)name;
+    return NULL;
+}
+
+#endif /* __linux__ */
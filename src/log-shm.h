@@ -0,0 +1,169 @@
+/**
+ * @file log-shm.h
+ * @brief Shared memory multi-process log ring declarations
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef log_shm_h_
+#define log_shm_h_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "log-sink.h"
+
+#define LOG_SHM_DEFAULT_NAME "/eatl-log"
+#define LOG_SHM_MAGIC 0x4D485345u  /* "ESHM" */
+#define LOG_SHM_VERSION 2
+#define LOG_SHM_DEFAULT_SLOTS 4096 /* INFO lane; must be a power of two */
+#define LOG_SHM_MIN_LANE_SLOTS 64  /* WARNING and CRITICAL lanes get a quarter of the INFO lane, at least this */
+#define LOG_SHM_SLOT_BYTES 512     /* Slot size including its header */
+#define LOG_SHM_CACHE_LINE 64
+#define LOG_SHM_CRITICAL_WAIT_MS 1000 /* How long a CRITICAL producer waits on a full lane for a live collector */
+
+/**
+ * @brief One record slot
+ *
+ * sequence follows Dmitry Vyukov's bounded queue: it equals the slot's position while the slot is
+ * free, position + 1 once a producer has published into it, and position + slot_count after the
+ * collector has consumed it.
+ */
+struct log_shm_slot
+{
+    uint64_t sequence;     /**< Slot state, see above */
+    uint64_t timestamp_ns; /**< Producer's CLOCK_MONOTONIC time */
+    uint32_t pid;          /**< Producing process */
+    uint16_t length;       /**< Bytes used in data */
+    uint16_t level;        /**< enum log_level of the record, which is also its lane */
+    char data[LOG_SHM_SLOT_BYTES - 24];
+};
+
+/**
+ * @brief One ring per severity, so bulk INFO traffic never queues in front of CRITICAL records
+ *
+ * The producer and consumer positions live on separate cache lines.
+ */
+struct log_shm_lane
+{
+    _Alignas(LOG_SHM_CACHE_LINE) uint64_t enqueue_pos; /**< Next position claimed by a producer */
+    _Alignas(LOG_SHM_CACHE_LINE) uint64_t dequeue_pos; /**< Next position read by the collector */
+    uint32_t slot_count;                               /**< Slots in this lane, a power of two */
+    uint32_t first_slot;                               /**< Index of the lane's first slot in header->slots */
+};
+
+/**
+ * @brief Header at the start of the shared memory segment
+ */
+struct log_shm_header
+{
+    uint32_t magic;         /**< LOG_SHM_MAGIC, stored last when the segment is initialized */
+    uint32_t version;       /**< LOG_SHM_VERSION */
+    uint32_t slot_count;    /**< Slots of all lanes together */
+    uint32_t collector_pid; /**< Pid of the attached collector, 0 if none */
+    uint64_t dropped;       /**< INFO and WARNING records producers dropped because their lane was full */
+    uint64_t diverted;      /**< CRITICAL records written to stderr because no collector freed a slot */
+    struct log_shm_lane lanes[LOG_LEVEL_COUNT];
+    _Alignas(LOG_SHM_CACHE_LINE) struct log_shm_slot slots[];
+};
+
+/**
+ * @brief Process local handle on an attached segment
+ */
+struct log_shm
+{
+    struct log_shm_header *header;
+    size_t map_size;
+    uint32_t pid; /**< Cached at attach time so publishing needs no getpid() */
+};
+
+/**
+ * @brief Attaches to a segment, creating and initializing it if it does not exist yet
+ *
+ * @param[in] name       POSIX shared memory name, e.g. LOG_SHM_DEFAULT_NAME
+ * @param[in] slot_count INFO lane slots for a new segment, rounded up to a power of two; ignored for an existing one
+ * @param[out] shm       Handle to fill in
+ * @return int | 0 for success -1 for failure
+ */
+int log_shm_attach(const char *name, unsigned slot_count, struct log_shm *shm);
+
+/**
+ * @brief Unmaps a segment. The segment itself stays until log_shm_unlink().
+ */
+void log_shm_detach(struct log_shm *shm);
+
+/**
+ * @brief Removes a segment's name
+ *
+ * @param[in] name POSIX shared memory name
+ */
+void log_shm_unlink(const char *name);
+
+/**
+ * @brief Publishes one record into its severity's lane without locks or syscalls
+ *
+ * If an INFO or WARNING lane is full, because the collector is slow or gone, the record is dropped
+ * and the segment's dropped counter incremented. CRITICAL records are never dropped: while a
+ * collector is attached the producer waits up to LOG_SHM_CRITICAL_WAIT_MS for a free slot, and
+ * failing that writes the record straight to stderr. Records longer than a slot are truncated.
+ *
+ * @param[in] shm    Attached segment
+ * @param[in] level  Severity, which selects the lane
+ * @param[in] data   Record bytes
+ * @param[in] length Number of bytes
+ * @return int | 0 for success -1 if the record was dropped
+ */
+int log_shm_publish(struct log_shm *shm, enum log_level level, const char *data, size_t length);
+
+/**
+ * @brief Takes the next published record. Single consumer only.
+ *
+ * Lanes are drained in severity order: nothing is taken from a lane while a more severe lane
+ * holds a record.
+ *
+ * @param[in] shm   Attached segment
+ * @param[out] slot Copy of the record's slot
+ * @return int | 1 if a record was taken, 0 if the ring is empty
+ */
+int log_shm_consume(struct log_shm *shm, struct log_shm_slot *slot);
+
+/**
+ * @brief Opens a sink that publishes into a shared memory segment
+ *
+ * Records keep their color codes; the collector's own sink decides whether to strip them.
+ *
+ * @param[in] name POSIX shared memory name
+ * @return struct log_sink* NULL on failure or on platforms without POSIX shared memory
+ */
+struct log_sink *log_sink_shm(const char *name);
+
+#endif /* log_shm_h_ */
@@ -0,0 +1,550 @@
+/**
+ * @file log-sink.c
+ * @brief Pluggable log output sink definitions
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+/* System includes */
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#endif
+
+#ifdef _WIN32
+
+#include <io.h>
+
+#endif
+
+/* Local includes */
+#include "log-sink.h"
+#include "log-stage.h"
+
+#ifdef __linux__
+
+static pthread_mutex_t sink_lock = PTHREAD_MUTEX_INITIALIZER;
+#define SINK_LOCK() pthread_mutex_lock(&sink_lock)
+#define SINK_UNLOCK() pthread_mutex_unlock(&sink_lock)
+
+#else
+
+#define SINK_LOCK()
+#define SINK_UNLOCK()
+
+#endif
+
+static struct log_sink *active_sink;
+static volatile int sync_level = LOG_LEVEL_COUNT;
+
+/* stdout sink */
+
+static int stdout_write(struct log_sink *sink, const char *data, size_t length)
+{
+    (void)sink;
+    return fwrite(data, 1, length, stdout) == length ? 0 : -1;
+}
+
+static int stdout_flush(struct log_sink *sink)
+{
+    (void)sink;
+    return fflush(stdout) == 0 ? 0 : -1;
+}
+
+static struct log_sink stdout_sink = {
+    .name = "stdout",
+    .write = stdout_write,
+    .flush = stdout_flush,
+    .colorize = -1, /* Resolved on first use */
+};
+
+struct log_sink *log_sink_stdout(void)
+{
+    if (stdout_sink.colorize < 0)
+    {
+#if defined(__linux__)
+        stdout_sink.colorize = isatty(fileno(stdout));
+#elif defined(_WIN32)
+        stdout_sink.colorize = _isatty(_fileno(stdout));
+#else
+        stdout_sink.colorize = 1; /* Serial consoles on the embedded targets render ANSI codes */
+#endif
+    }
+    return &stdout_sink;
+}
+
+static void flush_at_exit(void)
+{
+    log_flush();
+}
+
+static void register_exit_flush(void);
+
+int log_init_reserved(unsigned threads)
+{
+    static char stdout_buffer[BUFSIZ];
+
+    /* A terminal stays line buffered, anything else gets a full buffer as stdio would pick */
+    struct log_sink *sink = log_sink_stdout();
+    if (setvbuf(stdout, stdout_buffer, sink->colorize ? _IOLBF : _IOFBF, sizeof(stdout_buffer)) != 0)
+    {
+        fprintf(stderr, "Could not reserve the stdout buffer.\n");
+        return -1;
+    }
+    register_exit_flush();
+    return log_stage_reserve(threads);
+}
+
+static void register_exit_flush(void)
+{
+    static int registered;
+
+    if (!registered)
+    {
+        atexit(flush_at_exit);
+        registered = 1;
+    }
+}
+
+#ifdef __linux__
+
+/* File and socket sinks share one batching writer */
+struct fd_sink
+{
+    struct log_sink sink;
+    int fd;
+    int is_socket;
+    size_t used;
+    char batch[LOG_SINK_BATCH_BYTES];
+};
+
+/* Writes the pending batch plus an optional record that did not fit, in one syscall */
+static int fd_sink_submit(struct fd_sink *state, const char *extra, size_t extra_length)
+{
+    struct iovec iov[2];
+    int count = 0;
+
+    if (state->used > 0)
+    {
+        iov[count].iov_base = state->batch;
+        iov[count++].iov_len = state->used;
+    }
+    if (extra_length > 0)
+    {
+        iov[count].iov_base = (void *)extra;
+        iov[count++].iov_len = extra_length;
+    }
+    state->used = 0;
+
+    struct iovec *next = iov;
+    while (count > 0)
+    {
+        ssize_t written;
+        if (state->is_socket)
+        {
+            struct msghdr message = {.msg_iov = next, .msg_iovlen = (size_t)count};
+            written = sendmsg(state->fd, &message, MSG_NOSIGNAL);
+        }
+        else
+        {
+            written = writev(state->fd, next, count);
+        }
+
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return -1;
+        }
+
+        /* Short write: skip what went out and resubmit the rest */
+        while (count > 0 && (size_t)written >= next->iov_len)
+        {
+            written -= (ssize_t)next->iov_len;
+            next++;
+            count--;
+        }
+        if (count > 0)
+        {
+            next->iov_base = (char *)next->iov_base + written;
+            next->iov_len -= (size_t)written;
+        }
+    }
+    return 0;
+}
+
+static int fd_sink_write(struct log_sink *sink, const char *data, size_t length)
+{
+    struct fd_sink *state = sink->context;
+
+    if (length <= sizeof(state->batch) - state->used)
+    {
+        memcpy(state->batch + state->used, data, length);
+        state->used += length;
+        return 0;
+    }
+    return fd_sink_submit(state, data, length);
+}
+
+static int fd_sink_flush(struct log_sink *sink)
+{
+    struct fd_sink *state = sink->context;
+
+    if (state->used == 0)
+    {
+        return 0;
+    }
+    return fd_sink_submit(state, NULL, 0);
+}
+
+static void fd_sink_close(struct log_sink *sink)
+{
+    struct fd_sink *state = sink->context;
+
+    fd_sink_flush(sink);
+    close(state->fd);
+    free(state);
+}
+
+static struct log_sink *fd_sink_create(const char *name, int fd, int is_socket)
+{
+    struct fd_sink *state = malloc(sizeof(struct fd_sink));
+    if (state == NULL)
+    {
+        fprintf(stderr, "Memory allocation failed.\n");
+        close(fd);
+        return NULL;
+    }
+
+    state->fd = fd;
+    state->is_socket = is_socket;
+    state->used = 0;
+    state->sink.name = name;
+    state->sink.write = fd_sink_write;
+    state->sink.write_level = NULL;
+    state->sink.flush = fd_sink_flush;
+    state->sink.close = fd_sink_close;
+    state->sink.colorize = isatty(fd);
+    state->sink.context = state;
+
+    register_exit_flush();
+    return &state->sink;
+}
+
+struct log_sink *log_sink_file(const char *path)
+{
+    int fd = open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (fd == -1)
+    {
+        perror("open");
+        return NULL;
+    }
+    return fd_sink_create("file", fd, 0);
+}
+
+struct log_sink *log_sink_unix_socket(const char *path)
+{
+    struct sockaddr_un address = {.sun_family = AF_UNIX};
+
+    if (strlen(path) >= sizeof(address.sun_path))
+    {
+        fprintf(stderr, "Socket path too long: %s\n", path);
+        return NULL;
+    }
+    strcpy(address.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd == -1)
+    {
+        perror("socket");
+        return NULL;
+    }
+    if (connect(fd, (struct sockaddr *)&address, sizeof(address)) == -1)
+    {
+        perror("connect");
+        close(fd);
+        return NULL;
+    }
+    return fd_sink_create("unix-socket", fd, 1);
+}
+
+#else /* If linux is not found */
+
+static int stdio_sink_write(struct log_sink *sink, const char *data, size_t length)
+{
+    return fwrite(data, 1, length, (FILE *)sink->context) == length ? 0 : -1;
+}
+
+static int stdio_sink_flush(struct log_sink *sink)
+{
+    return fflush((FILE *)sink->context) == 0 ? 0 : -1;
+}
+
+static void stdio_sink_close(struct log_sink *sink)
+{
+    fclose((FILE *)sink->context);
+    free(sink);
+}
+
+struct log_sink *log_sink_file(const char *path)
+{
+    FILE *file = fopen(path, "ab");
+    if (file == NULL)
+    {
+        perror("fopen");
+        return NULL;
+    }
+
+    struct log_sink *sink = malloc(sizeof(struct log_sink));
+    if (sink == NULL)
+    {
+        fprintf(stderr, "Memory allocation failed.\n");
+        fclose(file);
+        return NULL;
+    }
+    sink->name = "file";
+    sink->write = stdio_sink_write;
+    sink->write_level = NULL;
+    sink->flush = stdio_sink_flush;
+    sink->close = stdio_sink_close;
+    sink->colorize = 0;
+    sink->context = file;
+
+    register_exit_flush();
+    return sink;
+}
+
+struct log_sink *log_sink_unix_socket(const char *path)
+{
+    (void)path;
+    return NULL;
+}
+
+#endif /* __linux__ */
+
+void log_sink_close(struct log_sink *sink)
+{
+    if (sink == NULL || sink == &stdout_sink)
+    {
+        return;
+    }
+
+    SINK_LOCK();
+    if (active_sink == sink)
+    {
+        active_sink = NULL;
+    }
+    if (sink->close != NULL)
+    {
+        sink->close(sink);
+    }
+    SINK_UNLOCK();
+}
+
+void log_set_sink(struct log_sink *sink)
+{
+    SINK_LOCK();
+    if (active_sink != NULL && active_sink->flush != NULL)
+    {
+        active_sink->flush(active_sink);
+    }
+    active_sink = sink;
+    SINK_UNLOCK();
+}
+
+struct log_sink *log_get_sink(void)
+{
+    return active_sink != NULL ? active_sink : log_sink_stdout();
+}
+
+static int sink_write(struct log_sink *sink, enum log_level level, const char *data, size_t length)
+{
+    if (sink->write_level != NULL)
+    {
+        return sink->write_level(sink, level, data, length);
+    }
+    return sink->write(sink, data, length);
+}
+
+/* Copies a record without its "\x1B[...m" color sequences and hands it to the sink in chunks */
+static int write_stripped(struct log_sink *sink, enum log_level level, const char *data, size_t length)
+{
+    char plain[LOG_SINK_MAX_RECORD];
+    size_t used = 0;
+    int status = 0;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        if (data[i] == '\x1B' && i + 1 < length && data[i + 1] == '[')
+        {
+            i += 2;
+            while (i < length && data[i] != 'm')
+            {
+                i++;
+            }
+            continue;
+        }
+        plain[used++] = data[i];
+        if (used == sizeof(plain))
+        {
+            status |= sink_write(sink, level, plain, used);
+            used = 0;
+        }
+    }
+    if (used > 0)
+    {
+        status |= sink_write(sink, level, plain, used);
+    }
+    return status;
+}
+
+int log_write_level(enum log_level level, const char *data, size_t length)
+{
+    int status;
+
+    SINK_LOCK();
+    struct log_sink *sink = log_get_sink();
+    if (!sink->colorize && memchr(data, '\x1B', length) != NULL)
+    {
+        status = write_stripped(sink, level, data, length);
+    }
+    else
+    {
+        status = sink_write(sink, level, data, length);
+    }
+    if ((int)level >= sync_level && sink->flush != NULL)
+    {
+        status |= sink->flush(sink);
+    }
+    SINK_UNLOCK();
+    return status;
+}
+
+int log_write(const char *data, size_t length)
+{
+    return log_write_level(LOG_LEVEL_INFO, data, length);
+}
+
+static int vlog_printf(enum log_level level, const char *format, va_list args)
+{
+    char record[LOG_SINK_MAX_RECORD];
+
+    int length = vsnprintf(record, sizeof(record), format, args);
+    if (length < 0)
+    {
+        return -1;
+    }
+    if ((size_t)length >= sizeof(record))
+    {
+        /* Keep the record line terminated when it had to be truncated */
+        length = sizeof(record) - 1;
+        record[length - 1] = '\n';
+    }
+    return log_record_level(level, record, (size_t)length);
+}
+
+int log_printf(const char *format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    int status = vlog_printf(LOG_LEVEL_INFO, format, args);
+    va_end(args);
+    return status;
+}
+
+int log_printf_level(enum log_level level, const char *format, ...)
+{
+    va_list args;
+
+    va_start(args, format);
+    int status = vlog_printf(level, format, args);
+    va_end(args);
+    return status;
+}
+
+int log_record(const char *data, size_t length)
+{
+    return log_record_level(LOG_LEVEL_INFO, data, length);
+}
+
+int log_record_level(enum log_level level, const char *data, size_t length)
+{
+    if ((int)level < sync_level && log_stage_active())
+    {
+        return log_stage_write(level, data, length);
+    }
+    return log_write_level(level, data, length);
+}
+
+void log_set_sync_level(enum log_level level)
+{
+    sync_level = (int)level;
+}
+
+int log_flush(void)
+{
+    int status = 0;
+
+    if (log_stage_active())
+    {
+        status = log_stage_flush();
+    }
+
+    SINK_LOCK();
+    struct log_sink *sink = log_get_sink();
+    if (sink->flush != NULL)
+    {
+        status |= sink->flush(sink);
+    }
+    SINK_UNLOCK();
+    return status;
+}
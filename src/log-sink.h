@@ -0,0 +1,259 @@
+/**
+ * @file log-sink.h
+ * @brief Pluggable log output sink declarations
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef log_sink_h_
+#define log_sink_h_
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LOG_SINK_MAX_RECORD 1024       /* Longest record log_printf() formats; longer ones are truncated */
+#define LOG_SINK_BATCH_BYTES (64 * 1024) /* Bytes coalesced before a file or socket sink issues a syscall */
+
+/**
+ * @brief Severity of a log record, matching the INFO/WARNING/CRITICAL labels in logger.h
+ *
+ * Each level travels in its own lane: queued records are drained most severe first.
+ */
+enum log_level
+{
+    LOG_LEVEL_INFO = 0,
+    LOG_LEVEL_WARNING,
+    LOG_LEVEL_CRITICAL,
+    LOG_LEVEL_COUNT
+};
+
+#define LOG_LEVEL_BIT(level) (1u << (level))
+#define LOG_LEVEL_ALL ((1u << LOG_LEVEL_COUNT) - 1)
+
+/**
+ * @brief Destination for formatted log records
+ *
+ * A sink is a small table of function pointers in the same spirit as the logcallback in
+ * struct log_module: the logger formats a record once and hands the bytes to whichever sink is
+ * active, without knowing whether they end up on a terminal, in a file, in RAM-FS or on a socket.
+ */
+struct log_sink
+{
+    const char *name; /**< Sink name for diagnostics */
+
+    /**
+     * @brief Accepts one formatted record
+     *
+     * Batching sinks may keep the bytes until their buffer fills or flush() is called.
+     *
+     * @return int | 0 for success -1 for failure
+     */
+    int (*write)(struct log_sink *sink, const char *data, size_t length);
+
+    /**
+     * @brief Accepts one formatted record of a given severity. Optional; NULL falls back to write().
+     *
+     * For sinks that keep a lane per level, such as the shared memory sink.
+     *
+     * @return int | 0 for success -1 for failure
+     */
+    int (*write_level)(struct log_sink *sink, enum log_level level, const char *data, size_t length);
+
+    /**
+     * @brief Pushes any batched records to their destination
+     *
+     * @return int | 0 for success -1 for failure
+     */
+    int (*flush)(struct log_sink *sink);
+
+    /**
+     * @brief Flushes and releases the sink. Optional.
+     */
+    void (*close)(struct log_sink *sink);
+
+    int colorize;  /**< Keep the BRED/BYEL/... escape codes; cleared for anything but a TTY */
+    void *context; /**< Sink specific state */
+};
+
+/**
+ * @brief Returns the sink that writes to stdout
+ *
+ * Colorized only when stdout is a terminal. This is the default sink.
+ *
+ * @return struct log_sink*
+ */
+struct log_sink *log_sink_stdout(void);
+
+/**
+ * @brief Opens a sink that appends to a file
+ *
+ * On Linux records are coalesced in a LOG_SINK_BATCH_BYTES buffer and written with a single writev()
+ * per batch. Elsewhere the file is written through stdio.
+ *
+ * @param[in] path File to append to; created if it does not exist
+ * @return struct log_sink* NULL on failure
+ */
+struct log_sink *log_sink_file(const char *path);
+
+/**
+ * @brief Opens a sink that streams to a collector listening on a Unix domain socket
+ *
+ * Batched like the file sink. If the collector goes away, records are dropped instead of raising SIGPIPE.
+ *
+ * @param[in] path Filesystem path of the collector's SOCK_STREAM socket
+ * @return struct log_sink* NULL on failure or on platforms without Unix domain sockets
+ */
+struct log_sink *log_sink_unix_socket(const char *path);
+
+/**
+ * @brief Flushes and releases a sink returned by one of the log_sink_* constructors
+ *
+ * @param[in] sink Sink to close. If it is the active sink, stdout becomes active again.
+ */
+void log_sink_close(struct log_sink *sink);
+
+/**
+ * @brief Makes a sink the destination of all log output
+ *
+ * @param[in] sink Sink to activate; NULL restores the stdout sink
+ */
+void log_set_sink(struct log_sink *sink);
+
+/**
+ * @brief Returns the active sink
+ *
+ * @return struct log_sink*
+ */
+struct log_sink *log_get_sink(void);
+
+/**
+ * @brief Writes one record to the active sink
+ *
+ * Color escape codes are stripped when the sink is not colorized. Records are written as INFO.
+ *
+ * @param[in] data   Record bytes
+ * @param[in] length Number of bytes
+ * @return int | 0 for success -1 for failure
+ */
+int log_write(const char *data, size_t length);
+
+/**
+ * @brief Writes one record of a given severity to the active sink
+ *
+ * Records at or above the log_set_sync_level() level are flushed to their destination before this returns.
+ *
+ * @param[in] level  Severity
+ * @param[in] data   Record bytes
+ * @param[in] length Number of bytes
+ * @return int | 0 for success -1 for failure
+ */
+int log_write_level(enum log_level level, const char *data, size_t length);
+
+/**
+ * @brief Formats one record and writes it to the active sink
+ *
+ * While log_stage_start() is in effect the record is staged in the calling thread's buffer instead.
+ *
+ * @param[in] format printf style format
+ * @return int | 0 for success -1 for failure
+ */
+int log_printf(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
+/**
+ * @brief log_printf() for a given severity
+ *
+ * @param[in] level  Severity, which selects the lane
+ * @param[in] format printf style format
+ * @return int | 0 for success -1 for failure
+ */
+int log_printf_level(enum log_level level, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief Hands one already formatted record to the same path log_printf() uses
+ *
+ * The record is staged while log_stage_start() is in effect and written to the active sink otherwise.
+ *
+ * @param[in] data   Record bytes
+ * @param[in] length Number of bytes
+ * @return int | 0 for success -1 for failure
+ */
+int log_record(const char *data, size_t length);
+
+/**
+ * @brief log_record() for a given severity
+ *
+ * Records at or above the log_set_sync_level() level skip staging and are written and flushed at once.
+ *
+ * @param[in] level  Severity
+ * @param[in] data   Record bytes
+ * @param[in] length Number of bytes
+ * @return int | 0 for success -1 for failure
+ */
+int log_record_level(enum log_level level, const char *data, size_t length);
+
+/**
+ * @brief Sets the severity from which records are written synchronously
+ *
+ * Such records bypass staging and batching and are flushed out of stdio and sink buffers before the
+ * logging call returns, so they survive the process dying right after. Off by default.
+ *
+ * @param[in] level Lowest synchronous severity; LOG_LEVEL_COUNT turns synchronous writes off
+ */
+void log_set_sync_level(enum log_level level);
+
+/**
+ * @brief Reserves the buffers logging needs, so records logged afterwards never touch the heap
+ *
+ * stdout gets a static buffer, since stdio would otherwise allocate one on its first write, and
+ * log_stage_reserve() sets aside staging buffers for the logging threads. Sinks are allocated when
+ * they are opened, so open them during init as well. Call before anything is written to stdout.
+ *
+ * @param[in] threads Threads that will log while staging is active, 0 when staging is not used
+ * @return int | 0 for success -1 for failure
+ */
+int log_init_reserved(unsigned threads);
+
+/**
+ * @brief Publishes any staged records and flushes the active sink
+ *
+ * @return int | 0 for success -1 for failure
+ */
+int log_flush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* log_sink_h_ */
@@ -0,0 +1,905 @@
+/**
+ * @file log-stage.c
+ * @brief Per-thread log staging buffer definitions
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+
+#include <linux/membarrier.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+/* glibc registers an rseq area for every thread since 2.35 */
+#if defined(__x86_64__) && defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 35))
+#define STAGE_RSEQ
+#include <sys/rseq.h>
+#endif
+
+#endif
+
+/* Local includes */
+#include "cpu-topology.h"
+#include "log-sink.h"
+#include "log-stage.h"
+
+#ifdef __linux__
+
+#define STAGE_ALIGN_UP(n) (((n) + 7) & ~(size_t)7)
+
+/**
+ * One per logging thread. The lock is only ever contended by a publish, so the hot path costs an
+ * uncontended lock on a cache line no other thread writes to.
+ */
+struct stage_buffer
+{
+    _Alignas(LOG_STAGE_CACHE_LINE) pthread_mutex_t lock;
+    uint32_t thread_id;
+    uint64_t next_sequence;
+    size_t used;
+    int reserved; /* Taken from log_stage_reserve(), handed back instead of freed */
+    struct stage_buffer *next;
+    _Alignas(LOG_STAGE_CACHE_LINE) unsigned char data[LOG_STAGE_BUFFER_BYTES];
+};
+
+/* A copied-out buffer being merged */
+struct stage_run
+{
+    const unsigned char *start;
+    const unsigned char *head;
+    const unsigned char *end;
+};
+
+/*
+ * One per possible CPU. Producers append to half `active`; only a publish flips it, and it reads the
+ * other half only once no producer can still be writing there.
+ */
+struct stage_shard
+{
+    _Alignas(LOG_STAGE_CACHE_LINE) volatile uint32_t active;
+    uint32_t reserved;
+    uint64_t last_timestamp; /* Newest timestamp committed; later records are never stamped below it */
+    uint64_t used[2];        /* Bytes committed to each half */
+    unsigned char *data;     /* Both halves, shard_bytes each */
+    pthread_mutex_t lock;    /* sched_getcpu() method only */
+};
+
+/* One append, kept in memory so the rseq sequence needs only two address registers */
+struct shard_append
+{
+    struct stage_shard *shard;
+    uint64_t capacity;
+    uint64_t total;
+    const char *payload;
+    uint64_t length;
+    uint32_t cpu;
+    struct log_stage_record header;
+};
+
+static pthread_mutex_t registry_lock = PTHREAD_MUTEX_INITIALIZER; /* Guards the list, the shards and the merge scratch */
+static struct stage_buffer *buffers;
+static struct stage_buffer *spare_buffers; /* Reserved buffers no thread holds */
+static unsigned reserved_threads;
+static uint32_t next_thread_id;
+static volatile int staging;
+
+static __thread struct stage_buffer *own_buffer;
+static pthread_key_t exit_key;
+static pthread_once_t exit_key_once = PTHREAD_ONCE_INIT;
+
+/* Merge scratch, grown on demand and kept between publishes */
+static unsigned char *copied;
+static size_t copied_size;
+static struct stage_run *runs;
+static size_t runs_size;
+
+static struct stage_shard *shards; /* Kept once allocated, producers may still be on their way in */
+static int shard_count;
+static size_t shard_bytes;
+static int shard_rseq; /* Appends are rseq critical sections, publishes quiesce with membarrier() */
+static volatile int sharding;
+static __thread uint64_t shard_sequence;
+
+static pthread_t timer_thread;
+static volatile int timer_running;
+static long timer_period_ns;
+
+static int grow(void **buffer, size_t *size, size_t needed)
+{
+    if (needed <= *size)
+    {
+        return 0;
+    }
+
+    void *larger = realloc(*buffer, needed);
+    if (larger == NULL)
+    {
+        fprintf(stderr, "Memory allocation failed.\n");
+        return -1;
+    }
+    *buffer = larger;
+    *size = needed;
+    return 0;
+}
+
+static int record_before(const struct log_stage_record *a, const struct log_stage_record *b)
+{
+    if (a->timestamp_ns != b->timestamp_ns)
+    {
+        return a->timestamp_ns < b->timestamp_ns;
+    }
+    if (a->thread_id != b->thread_id)
+    {
+        return a->thread_id < b->thread_id;
+    }
+    return a->sequence < b->sequence;
+}
+
+/* Copies every thread buffer out as a run. Caller holds registry_lock. */
+static int collect_threads(size_t *live)
+{
+    size_t count = 0;
+
+    for (struct stage_buffer *buffer = buffers; buffer != NULL; buffer = buffer->next)
+    {
+        count++;
+    }
+    if (grow((void **)&copied, &copied_size, count * LOG_STAGE_BUFFER_BYTES) == -1 ||
+        grow((void **)&runs, &runs_size, (count + (size_t)shard_count) * sizeof(struct stage_run)) == -1)
+    {
+        return -1;
+    }
+
+    /* Each thread's lock is held only for the memcpy */
+    size_t offset = 0;
+    for (struct stage_buffer *buffer = buffers; buffer != NULL; buffer = buffer->next)
+    {
+        pthread_mutex_lock(&buffer->lock);
+        if (buffer->used > 0)
+        {
+            memcpy(copied + offset, buffer->data, buffer->used);
+            runs[*live].start = copied + offset;
+            runs[*live].end = copied + offset + buffer->used;
+            offset += buffer->used;
+            buffer->used = 0;
+            (*live)++;
+        }
+        pthread_mutex_unlock(&buffer->lock);
+    }
+    return 0;
+}
+
+/*
+ * Flips every shard to its other half and waits until nothing can still be appending to the old
+ * one, whose records then become runs in place. Caller holds registry_lock.
+ */
+static void collect_shards(size_t *live)
+{
+    if (shards == NULL)
+    {
+        return;
+    }
+
+    for (int cpu = 0; cpu < shard_count; cpu++)
+    {
+        if (shard_rseq)
+        {
+            shards[cpu].active ^= 1;
+        }
+        else
+        {
+            pthread_mutex_lock(&shards[cpu].lock);
+            shards[cpu].active ^= 1;
+            pthread_mutex_unlock(&shards[cpu].lock);
+        }
+    }
+    if (shard_rseq)
+    {
+        /* Aborts every critical section in flight, so each one restarts on the new half */
+        syscall(__NR_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED_RSEQ, 0, 0);
+    }
+
+    for (int cpu = 0; cpu < shard_count; cpu++)
+    {
+        struct stage_shard *shard = &shards[cpu];
+        uint32_t old = shard->active ^ 1;
+        if (shard->used[old] > 0)
+        {
+            runs[*live].start = shard->data + old * shard_bytes;
+            runs[*live].end = runs[*live].start + shard->used[old];
+            (*live)++;
+        }
+    }
+}
+
+/* Hands the drained halves back; the producers only return to them after the next flip */
+static void release_shards(void)
+{
+    for (int cpu = 0; shards != NULL && cpu < shard_count; cpu++)
+    {
+        shards[cpu].used[shards[cpu].active ^ 1] = 0;
+    }
+}
+
+/* Merges the collected runs by lane and timestamp and writes them. Caller holds registry_lock. */
+static int publish_locked(void)
+{
+    size_t live = 0;
+
+    if (collect_threads(&live) == -1)
+    {
+        return -1;
+    }
+    collect_shards(&live);
+    if (live == 0)
+    {
+        return 0;
+    }
+
+    /*
+     * Each run is in time order but interleaves lanes, so a full pass per lane picks that lane's
+     * records out, most severe lane first. Every record is its own sink write, so sinks that frame
+     * records, such as RAM-FS and shared memory, keep one record per write.
+     */
+    int status = 0;
+    for (int level = LOG_LEVEL_COUNT - 1; level >= 0; level--)
+    {
+        for (size_t i = 0; i < live; i++)
+        {
+            runs[i].head = runs[i].start;
+        }
+        for (;;)
+        {
+            struct stage_run *oldest = NULL;
+            for (size_t i = 0; i < live; i++)
+            {
+                /* Skip this run's records of other lanes */
+                while (runs[i].head < runs[i].end && ((const struct log_stage_record *)runs[i].head)->level != level)
+                {
+                    const struct log_stage_record *record = (const struct log_stage_record *)runs[i].head;
+                    runs[i].head += STAGE_ALIGN_UP(sizeof(struct log_stage_record) + record->length);
+                }
+                if (runs[i].head < runs[i].end &&
+                    (oldest == NULL || record_before((const struct log_stage_record *)runs[i].head,
+                                                     (const struct log_stage_record *)oldest->head)))
+                {
+                    oldest = &runs[i];
+                }
+            }
+            if (oldest == NULL)
+            {
+                break;
+            }
+
+            const struct log_stage_record *record = (const struct log_stage_record *)oldest->head;
+            status |= log_write_level((enum log_level)level, (const char *)(record + 1), record->length);
+            oldest->head += STAGE_ALIGN_UP(sizeof(struct log_stage_record) + record->length);
+        }
+    }
+    release_shards();
+    return status;
+}
+
+int log_stage_flush(void)
+{
+    pthread_mutex_lock(&registry_lock);
+    int status = publish_locked();
+    pthread_mutex_unlock(&registry_lock);
+    return status;
+}
+
+/* Publishes what an exiting thread left behind and releases its buffer */
+static void release_buffer(void *arg)
+{
+    struct stage_buffer *buffer = arg;
+
+    pthread_mutex_lock(&registry_lock);
+    publish_locked();
+    for (struct stage_buffer **link = &buffers; *link != NULL; link = &(*link)->next)
+    {
+        if (*link == buffer)
+        {
+            *link = buffer->next;
+            break;
+        }
+    }
+    pthread_mutex_destroy(&buffer->lock);
+    if (buffer->reserved)
+    {
+        buffer->next = spare_buffers;
+        spare_buffers = buffer;
+    }
+    pthread_mutex_unlock(&registry_lock);
+
+    if (!buffer->reserved)
+    {
+        free(buffer);
+    }
+    own_buffer = NULL;
+}
+
+static void create_exit_key(void)
+{
+    pthread_key_create(&exit_key, release_buffer);
+}
+
+static struct stage_buffer *register_thread(void)
+{
+    pthread_mutex_lock(&registry_lock);
+    struct stage_buffer *buffer = spare_buffers;
+    if (buffer != NULL)
+    {
+        spare_buffers = buffer->next;
+    }
+    unsigned reserved = reserved_threads;
+    pthread_mutex_unlock(&registry_lock);
+
+    if (buffer == NULL && reserved > 0)
+    {
+        /* Every reserved buffer is taken; this thread's records go straight to the sink instead */
+        return NULL;
+    }
+    if (buffer == NULL)
+    {
+        buffer = aligned_alloc(LOG_STAGE_CACHE_LINE, sizeof(struct stage_buffer));
+        if (buffer == NULL)
+        {
+            fprintf(stderr, "Memory allocation failed.\n");
+            return NULL;
+        }
+        buffer->reserved = 0;
+    }
+
+    pthread_mutex_init(&buffer->lock, NULL);
+    buffer->next_sequence = 0;
+    buffer->used = 0;
+
+    pthread_mutex_lock(&registry_lock);
+    buffer->thread_id = next_thread_id++;
+    buffer->next = buffers;
+    buffers = buffer;
+    pthread_mutex_unlock(&registry_lock);
+
+    pthread_once(&exit_key_once, create_exit_key);
+    pthread_setspecific(exit_key, buffer);
+    own_buffer = buffer;
+    return buffer;
+}
+
+#ifdef STAGE_RSEQ
+
+static struct rseq *rseq_area(void)
+{
+    return (struct rseq *)((char *)__builtin_thread_pointer() + __rseq_offset);
+}
+
+/*
+ * Appends to the active half of append->shard as one restartable sequence: check the CPU, reserve,
+ * clamp the timestamp, copy header and payload, and commit by storing the new fill level. Returns 0
+ * once committed, 1 when the sequence was aborted and must be retried, 2 when the half is full.
+ */
+static int shard_append_rseq(struct rseq *area, struct shard_append *append)
+{
+    __asm__ goto(".pushsection __rseq_cs, \"aw\"\n\t"
+                 ".balign 32\n\t"
+                 "3:\n\t"
+                 ".long 0, 0\n\t"
+                 ".quad 1f, 2f - 1f, 4f\n\t"
+                 ".popsection\n\t"
+                 "leaq 3b(%%rip), %%rax\n\t"
+                 "movq %%rax, %c[rseq_cs](%[area])\n\t"
+                 "1:\n\t"
+                 "movl %c[cpu](%[append]), %%eax\n\t"
+                 "cmpl %%eax, %c[cpu_id](%[area])\n\t"
+                 "jnz %l[aborted]\n\t"
+                 "movq %c[shard](%[append]), %%rdx\n\t"
+                 "movl %c[active](%%rdx), %%eax\n\t"
+                 "leaq %c[used](%%rdx,%%rax,8), %%r8\n\t"
+                 "movq (%%r8), %%r9\n\t"
+                 "movq %%r9, %%r10\n\t"
+                 "addq %c[total](%[append]), %%r10\n\t"
+                 "cmpq %c[capacity](%[append]), %%r10\n\t"
+                 "ja %l[full]\n\t"
+                 "movq %c[last](%%rdx), %%r11\n\t"
+                 "cmpq %%r11, %c[stamp](%[append])\n\t"
+                 "jae 5f\n\t"
+                 "movq %%r11, %c[stamp](%[append])\n\t"
+                 "5:\n\t"
+                 "movq %c[stamp](%[append]), %%r11\n\t"
+                 "movq %%r11, %c[last](%%rdx)\n\t"
+                 "imulq %c[capacity](%[append]), %%rax\n\t"
+                 "addq %c[data](%%rdx), %%rax\n\t"
+                 "leaq (%%rax,%%r9), %%rdi\n\t"
+                 "leaq %c[header](%[append]), %%rsi\n\t"
+                 "movl %[header_size], %%ecx\n\t"
+                 "rep movsb\n\t"
+                 "movq %c[payload](%[append]), %%rsi\n\t"
+                 "movq %c[length](%[append]), %%rcx\n\t"
+                 "rep movsb\n\t"
+                 "movq %%r10, (%%r8)\n\t"
+                 "2:\n\t"
+                 ".pushsection __rseq_failure, \"ax\"\n\t"
+                 ".byte 0x0f, 0xb9, 0x3d\n\t" /* ud1 <signature>(%%rip), %%edi: the signature precedes the abort IP */
+                 ".long %c[signature]\n\t"
+                 "4:\n\t"
+                 "jmp %l[aborted]\n\t"
+                 ".popsection\n\t"
+                 :
+                 : [area] "r"(area), [append] "r"(append), [signature] "i"(RSEQ_SIG),
+                   [rseq_cs] "i"(offsetof(struct rseq, rseq_cs)), [cpu_id] "i"(offsetof(struct rseq, cpu_id)),
+                   [cpu] "i"(offsetof(struct shard_append, cpu)), [shard] "i"(offsetof(struct shard_append, shard)),
+                   [capacity] "i"(offsetof(struct shard_append, capacity)),
+                   [total] "i"(offsetof(struct shard_append, total)),
+                   [payload] "i"(offsetof(struct shard_append, payload)),
+                   [length] "i"(offsetof(struct shard_append, length)),
+                   [header] "i"(offsetof(struct shard_append, header)),
+                   [stamp] "i"(offsetof(struct shard_append, header.timestamp_ns)),
+                   [header_size] "i"(sizeof(struct log_stage_record)),
+                   [active] "i"(offsetof(struct stage_shard, active)), [used] "i"(offsetof(struct stage_shard, used)),
+                   [last] "i"(offsetof(struct stage_shard, last_timestamp)),
+                   [data] "i"(offsetof(struct stage_shard, data))
+                 : "rax", "rcx", "rdx", "rsi", "rdi", "r8", "r9", "r10", "r11", "memory", "cc"
+                 : aborted, full);
+    return 0;
+aborted:
+    return 1;
+full:
+    return 2;
+}
+
+#endif /* STAGE_RSEQ */
+
+/* Appends under the shard lock, for kernels or architectures without rseq */
+static int shard_append_locked(struct shard_append *append)
+{
+    struct stage_shard *shard = append->shard;
+
+    pthread_mutex_lock(&shard->lock);
+    uint32_t half = shard->active;
+    if (shard->used[half] + append->total > append->capacity)
+    {
+        pthread_mutex_unlock(&shard->lock);
+        return 2;
+    }
+    if (append->header.timestamp_ns < shard->last_timestamp)
+    {
+        append->header.timestamp_ns = shard->last_timestamp;
+    }
+    shard->last_timestamp = append->header.timestamp_ns;
+
+    unsigned char *target = shard->data + half * shard_bytes + shard->used[half];
+    memcpy(target, &append->header, sizeof(append->header));
+    memcpy(target + sizeof(append->header), append->payload, append->length);
+    shard->used[half] += append->total;
+    pthread_mutex_unlock(&shard->lock);
+    return 0;
+}
+
+static int shard_write(enum log_level level, const char *data, size_t length)
+{
+    struct shard_append append;
+    struct timespec now;
+
+    append.total = STAGE_ALIGN_UP(sizeof(struct log_stage_record) + length);
+    if (append.total > shard_bytes)
+    {
+        return log_write_level(level, data, length);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    append.capacity = shard_bytes;
+    append.payload = data;
+    append.length = length;
+    append.header.timestamp_ns = (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+    append.header.sequence = shard_sequence++;
+    append.header.level = (uint16_t)level;
+    append.header.length = (uint32_t)length;
+
+    for (;;)
+    {
+        int status;
+#ifdef STAGE_RSEQ
+        if (shard_rseq)
+        {
+            struct rseq *area = rseq_area();
+            append.cpu = *(volatile uint32_t *)&area->cpu_id_start;
+            if ((int)append.cpu >= shard_count)
+            {
+                return log_write_level(level, data, length);
+            }
+            append.shard = &shards[append.cpu];
+            append.header.thread_id = (uint16_t)append.cpu;
+            status = shard_append_rseq(area, &append);
+        }
+        else
+#endif
+        {
+            int cpu = sched_getcpu();
+            append.cpu = (uint32_t)(cpu >= 0 && cpu < shard_count ? cpu : 0);
+            append.shard = &shards[append.cpu];
+            append.header.thread_id = (uint16_t)append.cpu;
+            status = shard_append_locked(&append);
+        }
+
+        if (status == 0)
+        {
+            return 0;
+        }
+        if (status == 2 && log_stage_flush() == -1)
+        {
+            return log_write_level(level, data, length);
+        }
+    }
+}
+
+int log_stage_write(enum log_level level, const char *data, size_t length)
+{
+    if (sharding)
+    {
+        return shard_write(level, data, length);
+    }
+
+    struct stage_buffer *buffer = own_buffer;
+    struct log_stage_record record;
+    struct timespec now;
+
+    size_t total = STAGE_ALIGN_UP(sizeof(record) + length);
+    if (total > LOG_STAGE_BUFFER_BYTES)
+    {
+        return log_write_level(level, data, length);
+    }
+    if (buffer == NULL && (buffer = register_thread()) == NULL)
+    {
+        return log_write_level(level, data, length);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    record.timestamp_ns = (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+    record.thread_id = (uint16_t)buffer->thread_id;
+    record.level = (uint16_t)level;
+    record.length = (uint32_t)length;
+
+    pthread_mutex_lock(&buffer->lock);
+    if (buffer->used + total > LOG_STAGE_BUFFER_BYTES)
+    {
+        pthread_mutex_unlock(&buffer->lock);
+        log_stage_flush();
+        pthread_mutex_lock(&buffer->lock);
+        if (buffer->used + total > LOG_STAGE_BUFFER_BYTES)
+        {
+            /* The publish could not drain the buffer, e.g. its scratch failed to grow */
+            pthread_mutex_unlock(&buffer->lock);
+            return log_write_level(level, data, length);
+        }
+    }
+
+    record.sequence = buffer->next_sequence++;
+    memcpy(buffer->data + buffer->used, &record, sizeof(record));
+    memcpy(buffer->data + buffer->used + sizeof(record), data, length);
+    buffer->used += total;
+    pthread_mutex_unlock(&buffer->lock);
+    return 0;
+}
+
+static void *timer_main(void *arg)
+{
+    struct timespec deadline;
+
+    (void)arg;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+    while (timer_running)
+    {
+        deadline.tv_nsec += timer_period_ns;
+        while (deadline.tv_nsec >= 1000000000L)
+        {
+            deadline.tv_nsec -= 1000000000L;
+            deadline.tv_sec++;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+        log_flush();
+    }
+    return NULL;
+}
+
+static void flush_at_exit(void)
+{
+    log_stage_flush();
+    log_flush();
+}
+
+/* Grows the merge scratch to what the reserved threads and the shards can stage. Caller holds registry_lock. */
+static int reserve_scratch_locked(void)
+{
+    size_t threads = reserved_threads;
+    size_t count = (size_t)shard_count;
+
+    if (grow((void **)&copied, &copied_size, threads * LOG_STAGE_BUFFER_BYTES) == -1 ||
+        grow((void **)&runs, &runs_size, (threads + count) * sizeof(struct stage_run)) == -1)
+    {
+        return -1;
+    }
+    return 0;
+}
+
+int log_stage_reserve(unsigned threads)
+{
+    pthread_once(&exit_key_once, create_exit_key);
+
+    pthread_mutex_lock(&registry_lock);
+    for (unsigned i = 0; i < threads; i++)
+    {
+        struct stage_buffer *buffer = aligned_alloc(LOG_STAGE_CACHE_LINE, sizeof(struct stage_buffer));
+        if (buffer == NULL)
+        {
+            pthread_mutex_unlock(&registry_lock);
+            fprintf(stderr, "Memory allocation failed.\n");
+            return -1;
+        }
+        buffer->reserved = 1;
+        buffer->next = spare_buffers;
+        spare_buffers = buffer;
+        reserved_threads++;
+    }
+    int status = reserve_scratch_locked();
+    pthread_mutex_unlock(&registry_lock);
+    return status;
+}
+
+/* Whether appends can be rseq critical sections; only queries, so it is safe to call for a report */
+static int rseq_method(void)
+{
+#ifdef STAGE_RSEQ
+    if (__rseq_size == 0 || (int32_t)rseq_area()->cpu_id < 0)
+    {
+        return 0;
+    }
+    long supported = syscall(__NR_membarrier, MEMBARRIER_CMD_QUERY, 0, 0);
+    return supported > 0 && (supported & MEMBARRIER_CMD_PRIVATE_EXPEDITED_RSEQ) != 0;
+#else
+    return 0;
+#endif
+}
+
+/* Registers the process for the membarrier() that publishes use to quiesce rseq appends */
+static int rseq_register(void)
+{
+    static int registered;
+
+    if (!registered && rseq_method())
+    {
+        registered = syscall(__NR_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED_RSEQ, 0, 0) == 0;
+    }
+    return registered;
+}
+
+int log_stage_shard_geometry(size_t *bytes, const char **method)
+{
+    size_t size = cpu_topology_cache_per_cpu(2) / 4;
+
+    if (size < LOG_STAGE_SHARD_MIN_BYTES)
+    {
+        size = LOG_STAGE_SHARD_MIN_BYTES;
+    }
+    if (size > LOG_STAGE_SHARD_MAX_BYTES)
+    {
+        size = LOG_STAGE_SHARD_MAX_BYTES;
+    }
+    if (bytes != NULL)
+    {
+        *bytes = size & ~(size_t)4095;
+    }
+    if (method != NULL)
+    {
+        *method = rseq_method() ? "rseq" : "sched_getcpu";
+    }
+    return get_cpu_topology()->possible_cpus;
+}
+
+static int create_shards(void)
+{
+    size_t bytes;
+    int count = log_stage_shard_geometry(&bytes, NULL);
+
+    shard_rseq = rseq_register();
+    if (shards != NULL)
+    {
+        return 0;
+    }
+
+    struct stage_shard *created = aligned_alloc(LOG_STAGE_CACHE_LINE, (size_t)count * sizeof(struct stage_shard));
+    if (created == NULL)
+    {
+        fprintf(stderr, "Memory allocation failed.\n");
+        return -1;
+    }
+    for (int cpu = 0; cpu < count; cpu++)
+    {
+        created[cpu].data = aligned_alloc(LOG_STAGE_CACHE_LINE, 2 * bytes);
+        if (created[cpu].data == NULL)
+        {
+            fprintf(stderr, "Memory allocation failed.\n");
+            while (cpu-- > 0)
+            {
+                free(created[cpu].data);
+            }
+            free(created);
+            return -1;
+        }
+        created[cpu].active = 0;
+        created[cpu].last_timestamp = 0;
+        created[cpu].used[0] = 0;
+        created[cpu].used[1] = 0;
+        pthread_mutex_init(&created[cpu].lock, NULL);
+    }
+
+    shard_bytes = bytes;
+    shard_count = count;
+    shards = created;
+    return reserve_scratch_locked();
+}
+
+int log_stage_start_sharded(unsigned interval_ms)
+{
+    if (staging)
+    {
+        return -1;
+    }
+
+    pthread_mutex_lock(&registry_lock);
+    int status = create_shards();
+    pthread_mutex_unlock(&registry_lock);
+    if (status == -1)
+    {
+        return -1;
+    }
+
+    sharding = 1;
+    if (log_stage_start(interval_ms) == -1)
+    {
+        sharding = 0;
+        return -1;
+    }
+    return 0;
+}
+
+int log_stage_start(unsigned interval_ms)
+{
+    static int registered;
+
+    if (staging)
+    {
+        return -1;
+    }
+    if (!registered)
+    {
+        atexit(flush_at_exit);
+        registered = 1;
+    }
+
+    staging = 1;
+    if (interval_ms > 0)
+    {
+        timer_period_ns = (long)interval_ms * 1000000L;
+        timer_running = 1;
+        if (pthread_create(&timer_thread, NULL, timer_main, NULL) != 0)
+        {
+            timer_running = 0;
+            staging = 0;
+            return -1;
+        }
+    }
+    return 0;
+}
+
+void log_stage_stop(void)
+{
+    if (!staging)
+    {
+        return;
+    }
+    if (timer_running)
+    {
+        timer_running = 0;
+        pthread_join(timer_thread, NULL);
+    }
+    staging = 0;
+    log_stage_flush();
+    sharding = 0;
+}
+
+int log_stage_active(void)
+{
+    return staging;
+}
+
+#else /* If linux is not found */
+
+int log_stage_start(unsigned interval_ms)
+{
+    (void)interval_ms;
+    return -1;
+}
+
+void log_stage_stop(void)
+{
+}
+
+int log_stage_active(void)
+{
+    return 0;
+}
+
+int log_stage_write(enum log_level level, const char *data, size_t length)
+{
+    return log_write_level(level, data, length);
+}
+
+int log_stage_flush(void)
+{
+    return 0;
+}
+
+int log_stage_start_sharded(unsigned interval_ms)
+{
+    (void)interval_ms;
+    return -1;
+}
+
+int log_stage_shard_geometry(size_t *bytes, const char **method)
+{
+    (void)bytes;
+    (void)method;
+    return 0;
+}
+
+int log_stage_reserve(unsigned threads)
+{
+    (void)threads;
+    return 0;
+}
+
+#endif /* __linux__ */
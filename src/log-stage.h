@@ -0,0 +1,156 @@
+/**
+ * @file log-stage.h
+ * @brief Per-thread log staging buffer declarations
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef log_stage_h_
+#define log_stage_h_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "log-sink.h"
+
+#define LOG_STAGE_BUFFER_BYTES (32 * 1024) /* Per thread staging buffer */
+#define LOG_STAGE_CACHE_LINE 64
+#define LOG_STAGE_SHARD_MIN_BYTES (16 * 1024)  /* Per CPU shard half, lower bound */
+#define LOG_STAGE_SHARD_MAX_BYTES (256 * 1024) /* Per CPU shard half, upper bound */
+
+/**
+ * @brief Header in front of every staged record
+ *
+ * (level, timestamp_ns, thread_id, sequence) orders records globally when the buffers of several
+ * threads are merged: the most severe lane first, then time.
+ */
+struct log_stage_record
+{
+    uint64_t timestamp_ns; /**< CLOCK_MONOTONIC time the record was staged */
+    uint64_t sequence;     /**< Per thread, starts at 0 */
+    uint16_t thread_id;    /**< Small id handed out when the thread first logs, or the shard's CPU */
+    uint16_t level;        /**< enum log_level, the record's lane */
+    uint32_t length;       /**< Record bytes following the header */
+};
+
+/**
+ * @brief Starts routing log_printf() through per-thread staging buffers
+ *
+ * Each thread formats into its own cache-aligned buffer and takes only its own, uncontended lock.
+ * Buffers are published to the active sink when one fills, on log_stage_flush(), and every
+ * interval_ms milliseconds from a timer thread. Publishing merges the records of all threads back
+ * into timestamp order, CRITICAL lane first, then WARNING, then INFO, and hands them to the sink one
+ * write per record. Linux only; elsewhere records keep going straight to the sink.
+ *
+ * @param[in] interval_ms Timer period, 0 for no timer
+ * @return int | 0 for success -1 for failure
+ */
+int log_stage_start(unsigned interval_ms);
+
+/**
+ * @brief Starts routing log_printf() through per-CPU shards instead of per-thread buffers
+ *
+ * Every possible CPU owns a shard of two halves; producers append to the active half of the CPU
+ * they run on. On x86-64 with glibc's restartable sequence registration the append is an rseq
+ * critical section: no lock and no atomic instruction, and a preempted or migrated producer simply
+ * restarts. Publishing flips the active halves and waits out any critical section still running
+ * with membarrier() before merging the old halves. Without rseq the shard is picked with
+ * sched_getcpu() and guarded by a lock that is only contended when a thread migrates mid-record.
+ *
+ * Shard count and size come from log_stage_shard_geometry(). Records keep the lane and timestamp
+ * order of log_stage_start(); a record committed after a newer one on the same CPU takes that
+ * newer timestamp, so every shard stays in commit order. Linux only.
+ *
+ * @param[in] interval_ms Timer period, 0 for no timer
+ * @return int | 0 for success -1 for failure
+ */
+int log_stage_start_sharded(unsigned interval_ms);
+
+/**
+ * @brief Reports how log_stage_start_sharded() lays out its shards
+ *
+ * One shard per possible CPU; each half is a quarter of the L2 cache a CPU has to itself, clamped to
+ * LOG_STAGE_SHARD_MIN_BYTES..LOG_STAGE_SHARD_MAX_BYTES. Only reports: the membarrier() registration
+ * the rseq method needs is left to log_stage_start_sharded().
+ *
+ * @param[out] bytes  Bytes per shard half, may be NULL
+ * @param[out] method "rseq" or "sched_getcpu", may be NULL
+ * @return int Number of shards, 0 when sharding is unavailable
+ */
+int log_stage_shard_geometry(size_t *bytes, const char **method);
+
+/**
+ * @brief Reserves staging buffers and merge scratch for a number of logging threads
+ *
+ * Without a reservation, a thread's buffer is allocated the first time it logs and the merge scratch
+ * grows with the number of threads. With one, threads take buffers from the reserve and hand them
+ * back when they exit, and publishing never allocates. A thread that finds every reserved buffer
+ * taken writes its records straight to the sink rather than allocating one. Shards are sized in when log_stage_start_sharded() creates them. Call before any of the
+ * threads logs. Linux only.
+ *
+ * @param[in] threads Logging threads to reserve for
+ * @return int | 0 for success -1 for failure
+ */
+int log_stage_reserve(unsigned threads);
+
+/**
+ * @brief Stops the timer, publishes whatever is staged and goes back to direct writes
+ */
+void log_stage_stop(void);
+
+/**
+ * @brief Returns non-zero while staging is active
+ *
+ * @return int
+ */
+int log_stage_active(void);
+
+/**
+ * @brief Stages one formatted record for the calling thread, or the CPU it runs on when sharded
+ *
+ * Staging never drops: a full buffer or shard is published on the spot.
+ *
+ * @param[in] level  Severity, which selects the lane
+ * @param[in] data   Record bytes
+ * @param[in] length Number of bytes
+ * @return int | 0 for success -1 for failure
+ */
+int log_stage_write(enum log_level level, const char *data, size_t length);
+
+/**
+ * @brief Merges the buffers of all threads and shards and writes them to the active sink
+ *
+ * @return int | 0 for success -1 for failure
+ */
+int log_stage_flush(void);
+
+#endif /* log_stage_h_ */
@@ -0,0 +1,607 @@
+/**
+ * @file log-telemetry.c
+ * @brief Compressed numeric telemetry channel definitions
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* System includes */
+#include <string.h>
+
+/* Local includes */
+#include "log-telemetry.h"
+
+#define HEADER_BYTES sizeof(struct telemetry_block_header)
+#define NO_WINDOW 0xFF /* previous_leading before the first XOR window is known */
+
+static const char base64_alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static uint64_t zigzag(uint64_t value)
+{
+    return (value << 1) ^ (uint64_t)((int64_t)value >> 63);
+}
+
+static uint64_t unzigzag(uint64_t value)
+{
+    return (value >> 1) ^ (0 - (value & 1));
+}
+
+static uint64_t double_bits(double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+/* Writes the low count bits of value, most significant first */
+static int put_bits(struct telemetry_encoder *encoder, uint64_t value, unsigned count)
+{
+    if (encoder->bit_position + count > encoder->capacity_bits)
+    {
+        return -1;
+    }
+    while (count > 0)
+    {
+        uint8_t *byte = &encoder->buffer[HEADER_BYTES + (encoder->bit_position >> 3)];
+        unsigned used = (unsigned)(encoder->bit_position & 7);
+        unsigned room = 8 - used;
+        unsigned take = count < room ? count : room;
+
+        if (used == 0)
+        {
+            *byte = 0;
+        }
+        *byte |= (uint8_t)(((value >> (count - take)) & ((1u << take) - 1)) << (room - take));
+        encoder->bit_position += take;
+        count -= take;
+    }
+    return 0;
+}
+
+static int get_bits(struct telemetry_decoder *decoder, unsigned count, uint64_t *value)
+{
+    uint64_t result = 0;
+
+    if (decoder->bit_position + count > decoder->end_bit)
+    {
+        return -1;
+    }
+    while (count > 0)
+    {
+        uint8_t byte = decoder->buffer[HEADER_BYTES + (decoder->bit_position >> 3)];
+        unsigned used = (unsigned)(decoder->bit_position & 7);
+        unsigned room = 8 - used;
+        unsigned take = count < room ? count : room;
+
+        result = (result << take) | (uint64_t)((byte >> (room - take)) & ((1u << take) - 1));
+        decoder->bit_position += take;
+        count -= take;
+    }
+    *value = result;
+    return 0;
+}
+
+/* 7 bits per group, high bit set on every group but the last */
+static int put_varint(struct telemetry_encoder *encoder, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        if (put_bits(encoder, 0x80 | (value & 0x7F), 8) == -1)
+        {
+            return -1;
+        }
+        value >>= 7;
+    }
+    return put_bits(encoder, value, 8);
+}
+
+static int get_varint(struct telemetry_decoder *decoder, uint64_t *value)
+{
+    uint64_t result = 0;
+
+    for (unsigned shift = 0; shift < 64; shift += 7)
+    {
+        uint64_t group;
+        if (get_bits(decoder, 8, &group) == -1)
+        {
+            return -1;
+        }
+        result |= (group & 0x7F) << shift;
+        if ((group & 0x80) == 0)
+        {
+            *value = result;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/* A single 0 bit for a steady delta, otherwise 1 and the zigzagged delta-of-delta minus one */
+static int put_delta_of_delta(struct telemetry_encoder *encoder, uint64_t value, uint64_t previous,
+                              int64_t *previous_delta)
+{
+    uint64_t delta = value - previous;
+    uint64_t delta_of_delta = delta - (uint64_t)*previous_delta;
+
+    *previous_delta = (int64_t)delta;
+    if (delta_of_delta == 0)
+    {
+        return put_bits(encoder, 0, 1);
+    }
+    if (put_bits(encoder, 1, 1) == -1)
+    {
+        return -1;
+    }
+    return put_varint(encoder, zigzag(delta_of_delta) - 1);
+}
+
+static int get_delta_of_delta(struct telemetry_decoder *decoder, uint64_t previous, int64_t *previous_delta,
+                              uint64_t *value)
+{
+    uint64_t flag;
+    uint64_t delta_of_delta = 0;
+
+    if (get_bits(decoder, 1, &flag) == -1)
+    {
+        return -1;
+    }
+    if (flag)
+    {
+        if (get_varint(decoder, &delta_of_delta) == -1)
+        {
+            return -1;
+        }
+        delta_of_delta = unzigzag(delta_of_delta + 1);
+    }
+    uint64_t delta = (uint64_t)*previous_delta + delta_of_delta;
+    *previous_delta = (int64_t)delta;
+    *value = previous + delta;
+    return 0;
+}
+
+static int put_xor(struct telemetry_encoder *encoder, uint64_t bits)
+{
+    uint64_t difference = bits ^ encoder->previous_value;
+
+    encoder->previous_value = bits;
+    if (difference == 0)
+    {
+        return put_bits(encoder, 0, 1);
+    }
+
+    unsigned leading = (unsigned)__builtin_clzll(difference);
+    unsigned trailing = (unsigned)__builtin_ctzll(difference);
+    if (leading > 31)
+    {
+        leading = 31; /* Five bits on the wire */
+    }
+
+    if (encoder->previous_leading != NO_WINDOW && leading >= encoder->previous_leading &&
+        trailing >= encoder->previous_trailing)
+    {
+        unsigned meaningful = 64 - encoder->previous_leading - encoder->previous_trailing;
+        if (put_bits(encoder, 0x2, 2) == -1)
+        {
+            return -1;
+        }
+        return put_bits(encoder, difference >> encoder->previous_trailing, meaningful);
+    }
+
+    unsigned meaningful = 64 - leading - trailing;
+    encoder->previous_leading = (uint8_t)leading;
+    encoder->previous_trailing = (uint8_t)trailing;
+    if (put_bits(encoder, 0x3, 2) == -1 || put_bits(encoder, leading, 5) == -1 ||
+        put_bits(encoder, meaningful & 0x3F, 6) == -1) /* 64 is sent as 0 */
+    {
+        return -1;
+    }
+    return put_bits(encoder, difference >> trailing, meaningful);
+}
+
+static int get_xor(struct telemetry_decoder *decoder, uint64_t *bits)
+{
+    uint64_t flag;
+    uint64_t difference;
+
+    if (get_bits(decoder, 1, &flag) == -1)
+    {
+        return -1;
+    }
+    if (flag == 0)
+    {
+        *bits = decoder->previous_value;
+        return 0;
+    }
+    if (get_bits(decoder, 1, &flag) == -1)
+    {
+        return -1;
+    }
+    if (flag)
+    {
+        uint64_t leading;
+        uint64_t meaningful;
+        if (get_bits(decoder, 5, &leading) == -1 || get_bits(decoder, 6, &meaningful) == -1)
+        {
+            return -1;
+        }
+        if (meaningful == 0)
+        {
+            meaningful = 64;
+        }
+        if (leading + meaningful > 64)
+        {
+            return -1;
+        }
+        decoder->previous_leading = (uint8_t)leading;
+        decoder->previous_trailing = (uint8_t)(64 - leading - meaningful);
+    }
+    else if (decoder->previous_leading == NO_WINDOW)
+    {
+        return -1;
+    }
+
+    unsigned trailing = decoder->previous_trailing;
+    if (get_bits(decoder, 64u - decoder->previous_leading - trailing, &difference) == -1)
+    {
+        return -1;
+    }
+    decoder->previous_value ^= difference << trailing;
+    *bits = decoder->previous_value;
+    return 0;
+}
+
+int telemetry_encoder_init(struct telemetry_encoder *encoder, enum telemetry_kind kind, uint8_t *buffer,
+                           size_t capacity)
+{
+    if (encoder == NULL || buffer == NULL || capacity < HEADER_BYTES + 16 ||
+        (kind != TELEMETRY_DOUBLE && kind != TELEMETRY_INTEGER))
+    {
+        return -1;
+    }
+
+    memset(encoder, 0, sizeof(*encoder));
+    encoder->buffer = buffer;
+    encoder->capacity_bits = (capacity - HEADER_BYTES) * 8;
+    encoder->kind = kind;
+    encoder->previous_leading = NO_WINDOW;
+    return 0;
+}
+
+/* Encodes one sample; on failure the encoder is left exactly as it was */
+static int append_sample(struct telemetry_encoder *encoder, uint64_t timestamp, uint64_t value)
+{
+    struct telemetry_encoder saved = *encoder;
+    int result;
+
+    if (encoder->count == UINT16_MAX)
+    {
+        return -1;
+    }
+
+    if (encoder->count == 0)
+    {
+        result = put_varint(encoder, timestamp);
+        if (result == 0)
+        {
+            result = encoder->kind == TELEMETRY_DOUBLE ? put_bits(encoder, value, 64) : put_varint(encoder, zigzag(value));
+        }
+        encoder->previous_value = value;
+    }
+    else
+    {
+        result = put_delta_of_delta(encoder, timestamp, encoder->previous_timestamp, &encoder->previous_timestamp_delta);
+        if (result == 0)
+        {
+            if (encoder->kind == TELEMETRY_DOUBLE)
+            {
+                result = put_xor(encoder, value);
+            }
+            else
+            {
+                result = put_delta_of_delta(encoder, value, encoder->previous_value, &encoder->previous_value_delta);
+                encoder->previous_value = value;
+            }
+        }
+    }
+
+    if (result == -1)
+    {
+        size_t position = saved.bit_position;
+        *encoder = saved;
+        if (position & 7)
+        {
+            encoder->buffer[HEADER_BYTES + (position >> 3)] &= (uint8_t)(0xFF << (8 - (position & 7)));
+        }
+        return -1;
+    }
+    encoder->previous_timestamp = timestamp;
+    encoder->count++;
+    return 0;
+}
+
+int telemetry_append_double(struct telemetry_encoder *encoder, uint64_t timestamp, double value)
+{
+    if (encoder == NULL || encoder->kind != TELEMETRY_DOUBLE)
+    {
+        return -1;
+    }
+    return append_sample(encoder, timestamp, double_bits(value));
+}
+
+int telemetry_append_integer(struct telemetry_encoder *encoder, uint64_t timestamp, long long value)
+{
+    if (encoder == NULL || encoder->kind != TELEMETRY_INTEGER)
+    {
+        return -1;
+    }
+    return append_sample(encoder, timestamp, (uint64_t)value);
+}
+
+size_t telemetry_encoder_finish(struct telemetry_encoder *encoder)
+{
+    struct telemetry_block_header header;
+    uint32_t bits = (uint32_t)encoder->bit_position;
+
+    header.magic[0] = (uint8_t)(TELEMETRY_BLOCK_MAGIC & 0xFF);
+    header.magic[1] = (uint8_t)(TELEMETRY_BLOCK_MAGIC >> 8);
+    header.version = TELEMETRY_BLOCK_VERSION;
+    header.kind = (uint8_t)encoder->kind;
+    header.count[0] = (uint8_t)(encoder->count & 0xFF);
+    header.count[1] = (uint8_t)(encoder->count >> 8);
+    for (int i = 0; i < 4; i++)
+    {
+        header.bits[i] = (uint8_t)(bits >> (8 * i));
+    }
+    memcpy(encoder->buffer, &header, HEADER_BYTES);
+    return HEADER_BYTES + (encoder->bit_position + 7) / 8;
+}
+
+int telemetry_decoder_init(struct telemetry_decoder *decoder, const uint8_t *block, size_t length)
+{
+    struct telemetry_block_header header;
+
+    if (decoder == NULL || block == NULL || length < HEADER_BYTES)
+    {
+        return -1;
+    }
+    memcpy(&header, block, HEADER_BYTES);
+
+    uint32_t bits = 0;
+    for (int i = 3; i >= 0; i--)
+    {
+        bits = (bits << 8) | header.bits[i];
+    }
+    if (header.magic[0] != (TELEMETRY_BLOCK_MAGIC & 0xFF) || header.magic[1] != (TELEMETRY_BLOCK_MAGIC >> 8) ||
+        header.version != TELEMETRY_BLOCK_VERSION ||
+        (header.kind != TELEMETRY_DOUBLE && header.kind != TELEMETRY_INTEGER) ||
+        bits > (length - HEADER_BYTES) * 8)
+    {
+        return -1;
+    }
+
+    memset(decoder, 0, sizeof(*decoder));
+    decoder->buffer = block;
+    decoder->end_bit = bits;
+    decoder->kind = (enum telemetry_kind)header.kind;
+    decoder->count = (uint16_t)(header.count[0] | (header.count[1] << 8));
+    decoder->previous_leading = NO_WINDOW;
+    return 0;
+}
+
+int telemetry_decoder_next(struct telemetry_decoder *decoder, uint64_t *timestamp, union telemetry_value *value)
+{
+    uint64_t time;
+    uint64_t raw;
+
+    if (decoder->decoded == decoder->count)
+    {
+        return 0;
+    }
+
+    if (decoder->decoded == 0)
+    {
+        if (get_varint(decoder, &time) == -1)
+        {
+            return -1;
+        }
+        if (decoder->kind == TELEMETRY_DOUBLE ? get_bits(decoder, 64, &raw) == -1 : get_varint(decoder, &raw) == -1)
+        {
+            return -1;
+        }
+        if (decoder->kind == TELEMETRY_INTEGER)
+        {
+            raw = unzigzag(raw);
+        }
+        decoder->previous_value = raw;
+    }
+    else
+    {
+        if (get_delta_of_delta(decoder, decoder->previous_timestamp, &decoder->previous_timestamp_delta, &time) == -1)
+        {
+            return -1;
+        }
+        if (decoder->kind == TELEMETRY_DOUBLE)
+        {
+            if (get_xor(decoder, &raw) == -1)
+            {
+                return -1;
+            }
+        }
+        else
+        {
+            if (get_delta_of_delta(decoder, decoder->previous_value, &decoder->previous_value_delta, &raw) == -1)
+            {
+                return -1;
+            }
+            decoder->previous_value = raw;
+        }
+    }
+
+    decoder->previous_timestamp = time;
+    decoder->decoded++;
+    *timestamp = time;
+    if (decoder->kind == TELEMETRY_DOUBLE)
+    {
+        memcpy(&value->double_data, &raw, sizeof(raw));
+    }
+    else
+    {
+        value->int_data = (long long)raw;
+    }
+    return 1;
+}
+
+int telemetry_channel_init(struct telemetry_channel *channel, enum telemetry_kind kind, telemetry_block_callback emit,
+                           void *context)
+{
+    if (channel == NULL || emit == NULL)
+    {
+        return -1;
+    }
+    channel->emit = emit;
+    channel->context = context;
+    return telemetry_encoder_init(&channel->encoder, kind, channel->block, sizeof(channel->block));
+}
+
+void telemetry_channel_flush(struct telemetry_channel *channel)
+{
+    if (channel->encoder.count == 0)
+    {
+        return;
+    }
+    size_t length = telemetry_encoder_finish(&channel->encoder);
+    channel->emit(channel->block, length, channel->context);
+    telemetry_encoder_init(&channel->encoder, channel->encoder.kind, channel->block, sizeof(channel->block));
+}
+
+int telemetry_log_double(struct telemetry_channel *channel, uint64_t timestamp, double value)
+{
+    if (telemetry_append_double(&channel->encoder, timestamp, value) == 0)
+    {
+        return 0;
+    }
+    if (channel->encoder.count == 0)
+    {
+        return -1;
+    }
+    telemetry_channel_flush(channel);
+    return telemetry_append_double(&channel->encoder, timestamp, value);
+}
+
+int telemetry_log_integer(struct telemetry_channel *channel, uint64_t timestamp, long long value)
+{
+    if (telemetry_append_integer(&channel->encoder, timestamp, value) == 0)
+    {
+        return 0;
+    }
+    if (channel->encoder.count == 0)
+    {
+        return -1;
+    }
+    telemetry_channel_flush(channel);
+    return telemetry_append_integer(&channel->encoder, timestamp, value);
+}
+
+size_t telemetry_block_to_text(const uint8_t *block, size_t length, char *text, size_t capacity)
+{
+    size_t written = 0;
+
+    if (TELEMETRY_TEXT_LENGTH(length) + 1 > capacity)
+    {
+        return 0;
+    }
+    for (size_t i = 0; i < length; i += 3)
+    {
+        uint32_t group = (uint32_t)block[i] << 16;
+        if (i + 1 < length)
+        {
+            group |= (uint32_t)block[i + 1] << 8;
+        }
+        if (i + 2 < length)
+        {
+            group |= block[i + 2];
+        }
+        text[written++] = base64_alphabet[(group >> 18) & 0x3F];
+        text[written++] = base64_alphabet[(group >> 12) & 0x3F];
+        text[written++] = i + 1 < length ? base64_alphabet[(group >> 6) & 0x3F] : '=';
+        text[written++] = i + 2 < length ? base64_alphabet[group & 0x3F] : '=';
+    }
+    text[written] = '\0';
+    return written;
+}
+
+static int base64_digit(char c)
+{
+    const char *found = c == '\0' ? NULL : strchr(base64_alphabet, c);
+    return found == NULL ? -1 : (int)(found - base64_alphabet);
+}
+
+long telemetry_block_from_text(const char *text, size_t length, uint8_t *block, size_t capacity)
+{
+    size_t decoded = 0;
+
+    if (length % 4 != 0)
+    {
+        return -1;
+    }
+    for (size_t i = 0; i < length; i += 4)
+    {
+        int padding = 0;
+        uint32_t group = 0;
+
+        for (size_t j = 0; j < 4; j++)
+        {
+            int digit = 0;
+            if (text[i + j] == '=' && i + 4 == length && j >= 2)
+            {
+                padding++;
+            }
+            else if (padding > 0 || (digit = base64_digit(text[i + j])) == -1)
+            {
+                return -1;
+            }
+            group = (group << 6) | (uint32_t)digit;
+        }
+
+        size_t bytes = 3 - (size_t)padding;
+        if (decoded + bytes > capacity)
+        {
+            return -1;
+        }
+        for (size_t j = 0; j < bytes; j++)
+        {
+            block[decoded++] = (uint8_t)(group >> (16 - 8 * j));
+        }
+    }
+    return (long)decoded;
+}
@@ -0,0 +1,255 @@
+/**
+ * @file log-telemetry.h
+ * @brief Compressed numeric telemetry channel declarations
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef log_telemetry_h_
+#define log_telemetry_h_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define TELEMETRY_BLOCK_MAGIC 0x4754u  /* "TG", start of every block */
+#define TELEMETRY_BLOCK_VERSION 1
+#define TELEMETRY_BLOCK_BYTES 512      /* Default channel block; 684 bytes once base64 encoded */
+#define TELEMETRY_TEXT_LENGTH(bytes) ((((bytes) + 2) / 3) * 4) /* Base64 characters, excluding the NUL */
+
+/**
+ * @brief Kind of values carried by one series
+ */
+enum telemetry_kind
+{
+    TELEMETRY_DOUBLE = 1, /**< union log_data.double_data style sensor readings */
+    TELEMETRY_INTEGER = 2 /**< long long results such as perform_calculation() */
+};
+
+/**
+ * @brief One decoded value
+ */
+union telemetry_value
+{
+    double double_data;
+    long long int_data;
+};
+
+/**
+ * @brief Fixed header in front of the bit stream of a block
+ *
+ * Multi-byte fields are little endian regardless of the host.
+ */
+struct telemetry_block_header
+{
+    uint8_t magic[2]; /**< TELEMETRY_BLOCK_MAGIC */
+    uint8_t version;  /**< TELEMETRY_BLOCK_VERSION */
+    uint8_t kind;     /**< enum telemetry_kind */
+    uint8_t count[2]; /**< Samples in the block */
+    uint8_t bits[4];  /**< Length of the bit stream in bits */
+};
+
+/**
+ * @brief Streaming encoder writing one block into a caller supplied buffer
+ *
+ * Timestamps and integers are stored as zigzag varints of their delta-of-delta, with a single 0 bit
+ * for the common case of a steady interval or a steady trend. Doubles are XORed with the previous
+ * value and only the meaningful bits are stored, reusing the previous leading/trailing zero window
+ * when it still fits, as in Facebook's Gorilla. A slowly moving sensor sampled at a fixed rate
+ * costs a few bits per sample instead of 16 bytes.
+ */
+struct telemetry_encoder
+{
+    uint8_t *buffer;
+    size_t capacity_bits;
+    size_t bit_position;
+    enum telemetry_kind kind;
+    uint16_t count;
+    uint64_t previous_timestamp;
+    int64_t previous_timestamp_delta;
+    uint64_t previous_value;          /* Raw bits of the last double, or the last integer */
+    int64_t previous_value_delta;
+    uint8_t previous_leading;
+    uint8_t previous_trailing;
+};
+
+/**
+ * @brief Streaming decoder over one block
+ */
+struct telemetry_decoder
+{
+    const uint8_t *buffer;
+    size_t end_bit;
+    size_t bit_position;
+    enum telemetry_kind kind;
+    uint16_t count;
+    uint16_t decoded;
+    uint64_t previous_timestamp;
+    int64_t previous_timestamp_delta;
+    uint64_t previous_value;
+    int64_t previous_value_delta;
+    uint8_t previous_leading;
+    uint8_t previous_trailing;
+};
+
+/**
+ * @brief Receives a finished block from a telemetry channel
+ *
+ * @param[in] block   Encoded block, valid only for the duration of the call
+ * @param[in] length  Block length in bytes
+ * @param[in] context Pointer given to telemetry_channel_init()
+ */
+typedef void (*telemetry_block_callback)(const uint8_t *block, size_t length, void *context);
+
+/**
+ * @brief A series that is encoded as it is logged and handed out one full block at a time
+ */
+struct telemetry_channel
+{
+    struct telemetry_encoder encoder;
+    uint8_t block[TELEMETRY_BLOCK_BYTES];
+    telemetry_block_callback emit;
+    void *context;
+};
+
+/**
+ * @brief Starts a block
+ *
+ * @param[out] encoder  Encoder to initialize
+ * @param[in]  kind     Kind of values in the series
+ * @param[out] buffer   Block storage; must outlive the encoder
+ * @param[in]  capacity Bytes available, at least sizeof(struct telemetry_block_header) + 16
+ * @return 0 on success, -1 on failure
+ */
+int telemetry_encoder_init(struct telemetry_encoder *encoder, enum telemetry_kind kind, uint8_t *buffer,
+                           size_t capacity);
+
+/**
+ * @brief Appends a sample to a double series
+ *
+ * Samples are appended whole or not at all; -1 means the block is full and should be finished.
+ *
+ * @param[in] encoder   Encoder of a TELEMETRY_DOUBLE series
+ * @param[in] timestamp Sample time in the caller's units
+ * @param[in] value     Sample value
+ * @return 0 on success, -1 when the sample does not fit
+ */
+int telemetry_append_double(struct telemetry_encoder *encoder, uint64_t timestamp, double value);
+
+/**
+ * @brief Appends a sample to an integer series
+ *
+ * @return 0 on success, -1 when the sample does not fit
+ */
+int telemetry_append_integer(struct telemetry_encoder *encoder, uint64_t timestamp, long long value);
+
+/**
+ * @brief Writes the block header
+ *
+ * @param[in] encoder Encoder to finish; further appends are still possible
+ * @return size_t Bytes of block in encoder->buffer
+ */
+size_t telemetry_encoder_finish(struct telemetry_encoder *encoder);
+
+/**
+ * @brief Validates a block header and prepares to decode it
+ *
+ * @param[out] decoder Decoder to initialize
+ * @param[in]  block   Block produced by telemetry_encoder_finish()
+ * @param[in]  length  Block length in bytes
+ * @return 0 on success, -1 if the block is malformed
+ */
+int telemetry_decoder_init(struct telemetry_decoder *decoder, const uint8_t *block, size_t length);
+
+/**
+ * @brief Decodes the next sample
+ *
+ * @param[in]  decoder   Decoder
+ * @param[out] timestamp Sample time
+ * @param[out] value     Sample value, member chosen by decoder->kind
+ * @return 1 if a sample was decoded, 0 at the end of the block, -1 if the block is truncated
+ */
+int telemetry_decoder_next(struct telemetry_decoder *decoder, uint64_t *timestamp, union telemetry_value *value);
+
+/**
+ * @brief Starts a channel
+ *
+ * @param[out] channel Channel to initialize
+ * @param[in]  kind    Kind of values in the series
+ * @param[in]  emit    Called with every full block and from telemetry_channel_flush()
+ * @param[in]  context Passed through to emit
+ * @return 0 on success, -1 on failure
+ */
+int telemetry_channel_init(struct telemetry_channel *channel, enum telemetry_kind kind, telemetry_block_callback emit,
+                           void *context);
+
+/**
+ * @brief Logs a sample to a double channel, emitting the current block first if it is full
+ *
+ * @return 0 on success, -1 on failure
+ */
+int telemetry_log_double(struct telemetry_channel *channel, uint64_t timestamp, double value);
+
+/**
+ * @brief Logs a sample to an integer channel, emitting the current block first if it is full
+ *
+ * @return 0 on success, -1 on failure
+ */
+int telemetry_log_integer(struct telemetry_channel *channel, uint64_t timestamp, long long value);
+
+/**
+ * @brief Emits the partial block, if any, and starts a new one
+ */
+void telemetry_channel_flush(struct telemetry_channel *channel);
+
+/**
+ * @brief Encodes a block as base64 text, so it can be stored in text only places such as RAM-FS
+ *
+ * @param[in]  block    Block bytes
+ * @param[in]  length   Block length
+ * @param[out] text     Output, at least TELEMETRY_TEXT_LENGTH(length) + 1 bytes
+ * @param[in]  capacity Size of text
+ * @return size_t Characters written excluding the NUL, 0 if text is too small
+ */
+size_t telemetry_block_to_text(const uint8_t *block, size_t length, char *text, size_t capacity);
+
+/**
+ * @brief Decodes base64 text produced by telemetry_block_to_text()
+ *
+ * @param[in]  text     Text, not necessarily NUL terminated
+ * @param[in]  length   Text length
+ * @param[out] block    Output bytes
+ * @param[in]  capacity Size of block
+ * @return long Bytes decoded, -1 if the text is malformed or does not fit
+ */
+long telemetry_block_from_text(const char *text, size_t length, uint8_t *block, size_t capacity);
+
+#endif /* log_telemetry_h_ */
@@ -0,0 +1,671 @@
+/**
+ * @file log-trace.c
+ * @brief Capture and replay of perform_calculation() traces
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+
+#include <pthread.h>
+#include <time.h>
+
+#endif
+
+/* Local includes */
+#include "log-aggregate.h"
+#include "log-sample.h"
+#include "log-trace.h"
+
+int log_trace_capturing;
+
+#ifdef __linux__
+
+static pthread_mutex_t trace_lock = PTHREAD_MUTEX_INITIALIZER;
+static FILE *trace_file;
+static uint64_t trace_last_ns;
+
+/* Configuration of a module as last described in the trace */
+struct trace_module
+{
+    const struct log_module *module;
+    uint32_t sample_budget;
+    int has_thresholds;
+    long long minimum;
+    long long maximum;
+    long long hysteresis;
+    enum log_trigger trigger;
+    int has_aggregate;
+    uint32_t window_samples;
+    uint64_t window_ticks;
+};
+
+static struct trace_module trace_modules[LOG_TRACE_MAX_MODULES];
+static int trace_num_modules;
+static int trace_full_reported;
+static char trace_texts[LOG_TRACE_MAX_TEXTS][MAX_LOG_MESSAGE_LENGTH];
+static size_t trace_text_lengths[LOG_TRACE_MAX_TEXTS];
+static int trace_num_texts;
+
+static uint64_t clock_ns(clockid_t clock)
+{
+    struct timespec now;
+
+    clock_gettime(clock, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+static void put_varint(uint64_t value)
+{
+    do
+    {
+        int byte = (int)(value & 0x7F);
+        value >>= 7;
+        putc(value != 0 ? byte | 0x80 : byte, trace_file);
+    } while (value != 0);
+}
+
+static void put_signed(long long value)
+{
+    put_varint(((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+static void put_record_locked(enum log_trace_record type)
+{
+    uint64_t now = clock_ns(CLOCK_MONOTONIC);
+
+    putc(type, trace_file);
+    put_varint(now - trace_last_ns);
+    trace_last_ns = now;
+}
+
+static void snapshot_module(struct trace_module *entry, const struct log_module *module)
+{
+    memset(entry, 0, sizeof(*entry));
+    entry->module = module;
+    entry->sample_budget = module->sample_budget;
+    if (module->thresholds != NULL)
+    {
+        entry->has_thresholds = 1;
+        entry->minimum = module->thresholds->minimum;
+        entry->maximum = module->thresholds->maximum;
+        entry->hysteresis = module->thresholds->hysteresis;
+        entry->trigger = module->thresholds->trigger;
+    }
+    if (module->aggregate != NULL)
+    {
+        entry->has_aggregate = 1;
+        entry->window_samples = module->aggregate->window_samples;
+        entry->window_ticks = module->aggregate->window_ticks;
+    }
+}
+
+static void put_module_locked(int id, const struct log_module *module)
+{
+    const struct trace_module *entry = &trace_modules[id];
+    const char *name = module->module_name != NULL ? module->module_name : "";
+    size_t length = strnlen(name, MAX_MODULE_NAME_LENGTH - 1);
+
+    put_record_locked(LOG_TRACE_MODULE);
+    put_varint((uint64_t)id);
+    put_varint(length);
+    fwrite(name, 1, length, trace_file);
+    put_varint(entry->sample_budget);
+    putc(entry->has_thresholds, trace_file);
+    if (entry->has_thresholds)
+    {
+        put_signed(entry->minimum);
+        put_signed(entry->maximum);
+        put_signed(entry->hysteresis);
+        put_varint((uint64_t)entry->trigger);
+        put_signed(module->thresholds->state);
+    }
+    putc(entry->has_aggregate, trace_file);
+    if (entry->has_aggregate)
+    {
+        put_varint(entry->window_samples);
+        put_varint(entry->window_ticks);
+    }
+}
+
+/*
+ * Id of a module; the module is described the first time it is seen and again whenever its
+ * configuration has changed since. Returns -1 once the table is full.
+ */
+static int module_id_locked(const struct log_module *module)
+{
+    struct trace_module current;
+    int id = 0;
+
+    while (id < trace_num_modules && trace_modules[id].module != module)
+    {
+        id++;
+    }
+    if (id == LOG_TRACE_MAX_MODULES)
+    {
+        if (!trace_full_reported)
+        {
+            fprintf(stderr, "Trace holds %d modules, later ones are not recorded.\n", LOG_TRACE_MAX_MODULES);
+            trace_full_reported = 1;
+        }
+        return -1;
+    }
+
+    snapshot_module(&current, module);
+    if (id < trace_num_modules && memcmp(&current, &trace_modules[id], sizeof(current)) == 0)
+    {
+        return id;
+    }
+    if (id == trace_num_modules)
+    {
+        trace_num_modules++;
+    }
+    trace_modules[id] = current;
+    put_module_locked(id, module);
+    return id;
+}
+
+int log_trace_start(const char *path)
+{
+    pthread_mutex_lock(&trace_lock);
+    if (trace_file != NULL)
+    {
+        pthread_mutex_unlock(&trace_lock);
+        fprintf(stderr, "A trace is already being captured.\n");
+        return -1;
+    }
+    trace_file = fopen(path, "wb");
+    if (trace_file == NULL)
+    {
+        pthread_mutex_unlock(&trace_lock);
+        fprintf(stderr, "Could not open trace %s.\n", path);
+        return -1;
+    }
+    /* Records are a few bytes each; a large buffer keeps capture to a copy most of the time */
+    setvbuf(trace_file, NULL, _IOFBF, 1 << 16);
+
+    trace_last_ns = clock_ns(CLOCK_MONOTONIC);
+    fwrite(LOG_TRACE_MAGIC, 1, strlen(LOG_TRACE_MAGIC), trace_file);
+    putc(LOG_TRACE_VERSION, trace_file);
+    for (int shift = 0; shift < 64; shift += 8)
+    {
+        putc((int)((trace_last_ns >> shift) & 0xFF), trace_file);
+    }
+    trace_num_modules = 0;
+    trace_num_texts = 0;
+    trace_full_reported = 0;
+    __atomic_store_n(&log_trace_capturing, 1, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&trace_lock);
+    return 0;
+}
+
+void log_trace_stop(void)
+{
+    pthread_mutex_lock(&trace_lock);
+    __atomic_store_n(&log_trace_capturing, 0, __ATOMIC_RELEASE);
+    if (trace_file != NULL)
+    {
+        if (fclose(trace_file) != 0)
+        {
+            fprintf(stderr, "Trace could not be written completely.\n");
+        }
+        trace_file = NULL;
+    }
+    pthread_mutex_unlock(&trace_lock);
+}
+
+/* Events repeat a handful of messages, so each text is written once and referenced after that */
+static void put_text_locked(const char *text, size_t length)
+{
+    for (int i = 0; i < trace_num_texts; i++)
+    {
+        if (trace_text_lengths[i] == length && memcmp(trace_texts[i], text, length) == 0)
+        {
+            put_varint((uint64_t)i + 1);
+            return;
+        }
+    }
+    if (trace_num_texts < LOG_TRACE_MAX_TEXTS)
+    {
+        memcpy(trace_texts[trace_num_texts], text, length);
+        trace_text_lengths[trace_num_texts] = length;
+        trace_num_texts++;
+        put_varint((uint64_t)trace_num_texts);
+    }
+    else
+    {
+        put_varint(0);
+    }
+    put_varint(length);
+    fwrite(text, 1, length, trace_file);
+}
+
+void log_trace_input(const struct log_module *module, long long a, long long b)
+{
+    pthread_mutex_lock(&trace_lock);
+    int id = trace_file != NULL ? module_id_locked(module) : -1;
+    if (id >= 0)
+    {
+        put_record_locked(LOG_TRACE_INPUT);
+        put_varint((uint64_t)id);
+        put_signed(a);
+        put_signed(b);
+    }
+    pthread_mutex_unlock(&trace_lock);
+}
+
+void log_trace_event(const struct log_module *module, const char *message)
+{
+    pthread_mutex_lock(&trace_lock);
+    int id = trace_file != NULL ? module_id_locked(module) : -1;
+    if (id >= 0)
+    {
+        size_t length = strnlen(message, MAX_LOG_MESSAGE_LENGTH - 1);
+        put_record_locked(LOG_TRACE_EVENT);
+        put_varint((uint64_t)id);
+        put_text_locked(message, length);
+    }
+    pthread_mutex_unlock(&trace_lock);
+}
+
+/* A module rebuilt from the trace, with the events it produced that are not yet compared */
+struct replay_module
+{
+    struct log_module module;
+    struct log_thresholds thresholds;
+    struct log_aggregate aggregate;
+    char name[MAX_MODULE_NAME_LENGTH];
+    char pending[LOG_TRACE_PENDING_EVENTS][MAX_LOG_MESSAGE_LENGTH];
+    int head;
+    int count;
+};
+
+static struct replay_module *replay_current;
+static struct log_trace_stats *replay_stats;
+static uint64_t replay_time; /* Capture clock of the record being replayed */
+
+/* Sampling and aggregation windows follow the capture clock, so their decisions do not depend on the replay speed */
+static uint64_t replay_clock(void)
+{
+    return replay_time;
+}
+
+static int get_varint(FILE *file, uint64_t *value)
+{
+    *value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        int byte = getc(file);
+        if (byte == EOF)
+        {
+            return -1;
+        }
+        *value |= (uint64_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static int get_signed(FILE *file, long long *value)
+{
+    uint64_t raw;
+
+    if (get_varint(file, &raw) == -1)
+    {
+        return -1;
+    }
+    *value = (long long)(raw >> 1) ^ -(long long)(raw & 1);
+    return 0;
+}
+
+/* Reads a length prefixed string into text, which holds capacity bytes */
+static int get_text(FILE *file, char *text, size_t capacity)
+{
+    uint64_t length;
+
+    if (get_varint(file, &length) == -1 || length >= capacity ||
+        fread(text, 1, (size_t)length, file) != length)
+    {
+        return -1;
+    }
+    text[length] = '\0';
+    return 0;
+}
+
+static void replay_callback(const char *message)
+{
+    struct replay_module *replay = replay_current;
+
+    log_printf("%s: Callback message: %s", replay->name, message);
+    if (replay->count == LOG_TRACE_PENDING_EVENTS)
+    {
+        replay_stats->extra++;
+        return;
+    }
+    snprintf(replay->pending[(replay->head + replay->count) % LOG_TRACE_PENDING_EVENTS], MAX_LOG_MESSAGE_LENGTH, "%s",
+             message);
+    replay->count++;
+}
+
+/* Applies a module record: a new module, or the new configuration of a known one */
+static int replay_module_record(FILE *file, struct replay_module *modules, int *num_modules)
+{
+    uint64_t id;
+    uint64_t budget;
+    uint64_t trigger;
+    long long state;
+    uint64_t window_samples;
+    uint64_t window_ticks;
+
+    if (get_varint(file, &id) == -1 || id > (uint64_t)*num_modules || id >= LOG_TRACE_MAX_MODULES ||
+        get_text(file, modules[id].name, sizeof(modules[id].name)) == -1 || get_varint(file, &budget) == -1)
+    {
+        return -1;
+    }
+    struct replay_module *replay = &modules[id];
+    replay->module.module_name = replay->name;
+    replay->module.callback = replay_callback;
+    replay->module.sample_budget = (uint32_t)budget;
+
+    int has_thresholds = getc(file);
+    if (has_thresholds == EOF)
+    {
+        return -1;
+    }
+    replay->module.thresholds = NULL;
+    if (has_thresholds)
+    {
+        if (get_signed(file, &replay->thresholds.minimum) == -1 || get_signed(file, &replay->thresholds.maximum) == -1 ||
+            get_signed(file, &replay->thresholds.hysteresis) == -1 || get_varint(file, &trigger) == -1 ||
+            get_signed(file, &state) == -1)
+        {
+            return -1;
+        }
+        replay->thresholds.trigger = (enum log_trigger)trigger;
+        replay->thresholds.state = (int)state;
+        replay->module.thresholds = &replay->thresholds;
+    }
+
+    int has_aggregate = getc(file);
+    if (has_aggregate == EOF)
+    {
+        return -1;
+    }
+    if (has_aggregate && (get_varint(file, &window_samples) == -1 || get_varint(file, &window_ticks) == -1))
+    {
+        return -1;
+    }
+    /* A window in progress is closed as the application would have before changing it */
+    if (replay->module.aggregate != NULL)
+    {
+        replay_current = replay;
+        log_aggregate_flush(&replay->module);
+        replay->module.aggregate = NULL;
+    }
+    if (has_aggregate)
+    {
+        if (log_aggregate_init(&replay->aggregate, (uint32_t)window_samples, window_ticks, replay_clock, NULL, NULL) == -1)
+        {
+            return -1;
+        }
+        replay->module.aggregate = &replay->aggregate;
+    }
+    if (id == (uint64_t)*num_modules)
+    {
+        (*num_modules)++;
+    }
+    return 0;
+}
+
+int log_trace_replay(const char *path, double speed, struct log_trace_stats *stats)
+{
+    struct log_trace_stats own_stats;
+    char magic[sizeof(LOG_TRACE_MAGIC)];
+    uint8_t start_bytes[8];
+    char message[MAX_LOG_MESSAGE_LENGTH];
+    int num_modules = 0;
+    int num_texts = 0;
+    int result = -1;
+
+    if (stats == NULL)
+    {
+        stats = &own_stats;
+    }
+    memset(stats, 0, sizeof(*stats));
+
+    FILE *file = fopen(path, "rb");
+    if (file == NULL)
+    {
+        fprintf(stderr, "Could not open trace %s.\n", path);
+        return -1;
+    }
+    struct replay_module *modules = calloc(LOG_TRACE_MAX_MODULES, sizeof(*modules));
+    char(*texts)[MAX_LOG_MESSAGE_LENGTH] = calloc(LOG_TRACE_MAX_TEXTS, sizeof(*texts));
+    if (modules == NULL || texts == NULL)
+    {
+        fprintf(stderr, "Memory allocation failed.\n");
+        goto out;
+    }
+    if (fread(magic, 1, strlen(LOG_TRACE_MAGIC), file) != strlen(LOG_TRACE_MAGIC) ||
+        memcmp(magic, LOG_TRACE_MAGIC, strlen(LOG_TRACE_MAGIC)) != 0 || getc(file) != LOG_TRACE_VERSION ||
+        fread(start_bytes, 1, sizeof(start_bytes), file) != sizeof(start_bytes))
+    {
+        fprintf(stderr, "%s is not a trace.\n", path);
+        goto out;
+    }
+
+    replay_time = 0;
+    for (int i = 7; i >= 0; i--)
+    {
+        replay_time = replay_time << 8 | start_bytes[i];
+    }
+    replay_stats = stats;
+    log_sample_configure(0, 0, replay_clock, 1000000000ULL);
+
+    uint64_t start = clock_ns(CLOCK_MONOTONIC);
+    uint64_t cpu_start = clock_ns(CLOCK_PROCESS_CPUTIME_ID);
+    uint64_t offset = 0;
+    for (;;)
+    {
+        int type = getc(file);
+        uint64_t delta;
+        uint64_t id;
+
+        if (type == EOF)
+        {
+            result = 0;
+            break;
+        }
+        if (get_varint(file, &delta) == -1)
+        {
+            break;
+        }
+        offset += delta;
+        replay_time += delta;
+        if (type == LOG_TRACE_MODULE)
+        {
+            if (replay_module_record(file, modules, &num_modules) == -1)
+            {
+                break;
+            }
+            continue;
+        }
+        if (get_varint(file, &id) == -1 || id >= (uint64_t)num_modules)
+        {
+            break;
+        }
+        struct replay_module *replay = &modules[id];
+
+        if (type == LOG_TRACE_INPUT)
+        {
+            long long a;
+            long long b;
+            if (get_signed(file, &a) == -1 || get_signed(file, &b) == -1)
+            {
+                break;
+            }
+            if (speed > 0)
+            {
+                /* Sleep until the input is due at the requested speed; a late replay does not catch up by skipping */
+                uint64_t due = start + (uint64_t)((double)offset / speed);
+                if (clock_ns(CLOCK_MONOTONIC) < due)
+                {
+                    struct timespec wake = {
+                        .tv_sec = (time_t)(due / 1000000000ULL),
+                        .tv_nsec = (long)(due % 1000000000ULL),
+                    };
+                    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL);
+                }
+            }
+            replay_current = replay;
+            perform_calculation(&replay->module, a, b);
+            stats->inputs++;
+        }
+        else if (type == LOG_TRACE_EVENT)
+        {
+            uint64_t text;
+            if (get_varint(file, &text) == -1 || text > (uint64_t)num_texts + 1)
+            {
+                break;
+            }
+            if (text == 0 || text == (uint64_t)num_texts + 1)
+            {
+                if (get_text(file, message, sizeof(message)) == -1)
+                {
+                    break;
+                }
+                if (text != 0)
+                {
+                    if (num_texts == LOG_TRACE_MAX_TEXTS)
+                    {
+                        break;
+                    }
+                    memcpy(texts[num_texts++], message, sizeof(message));
+                }
+            }
+            else
+            {
+                memcpy(message, texts[text - 1], sizeof(message));
+            }
+            stats->events++;
+            if (replay->count == 0)
+            {
+                stats->missing++;
+                continue;
+            }
+            if (strcmp(replay->pending[replay->head], message) == 0)
+            {
+                stats->matched++;
+            }
+            else
+            {
+                stats->mismatched++;
+            }
+            replay->head = (replay->head + 1) % LOG_TRACE_PENDING_EVENTS;
+            replay->count--;
+        }
+        else
+        {
+            break;
+        }
+    }
+    stats->wall_ns = clock_ns(CLOCK_MONOTONIC) - start;
+    stats->cpu_ns = clock_ns(CLOCK_PROCESS_CPUTIME_ID) - cpu_start;
+    for (int id = 0; id < num_modules; id++)
+    {
+        stats->extra += (uint64_t)modules[id].count;
+    }
+    if (result == -1)
+    {
+        fprintf(stderr, "Trace %s is truncated or corrupt after %llu inputs.\n", path,
+                (unsigned long long)stats->inputs);
+    }
+
+    log_sample_configure(0, 0, log_sample_clock_ns, 1000000000ULL);
+
+out:
+    replay_current = NULL;
+    free(texts);
+    free(modules);
+    fclose(file);
+    return result;
+}
+
+#else
+
+int log_trace_start(const char *path)
+{
+    (void)path;
+    fprintf(stderr, "Trace capture is only supported on Linux.\n");
+    return -1;
+}
+
+void log_trace_stop(void)
+{
+}
+
+void log_trace_input(const struct log_module *module, long long a, long long b)
+{
+    (void)module;
+    (void)a;
+    (void)b;
+}
+
+void log_trace_event(const struct log_module *module, const char *message)
+{
+    (void)module;
+    (void)message;
+}
+
+int log_trace_replay(const char *path, double speed, struct log_trace_stats *stats)
+{
+    (void)path;
+    (void)speed;
+    (void)stats;
+    fprintf(stderr, "Trace replay is only supported on Linux.\n");
+    return -1;
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,160 @@
+/**
+ * @file log-trace.h
+ * @brief Capture and replay of perform_calculation() traces
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef log_trace_h_
+#define log_trace_h_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common/logger.h"
+
+#define LOG_TRACE_MAGIC "EATLTRC"  /* First 7 bytes of a trace, followed by the version byte */
+#define LOG_TRACE_VERSION 1
+#define LOG_TRACE_MAX_MODULES 64   /* Distinct modules one trace can hold */
+#define LOG_TRACE_MAX_TEXTS 64     /* Distinct event messages stored once and referenced after */
+#define LOG_TRACE_PENDING_EVENTS 4 /* Replayed events per module waiting to be compared */
+
+/**
+ * @brief Record types of a trace
+ *
+ * After the 8 byte magic and version and the start time as a little endian uint64_t in ns, every
+ * record is a type byte, the ns since the previous record as a varint and a payload. Integers are
+ * LEB128 varints, signed ones zigzag encoded first. An event text is a reference: n refers to the
+ * n-th text seen, one past the last text defines the next one (length and bytes follow), and 0
+ * carries a length and bytes that are not stored once LOG_TRACE_MAX_TEXTS texts are.
+ */
+enum log_trace_record
+{
+    LOG_TRACE_MODULE = 1, /* id, name length, name, budget, threshold flag [, min, max, hysteresis, trigger, state],
+                             aggregate flag [, window samples, window ticks] */
+    LOG_TRACE_INPUT,      /* id, a, b: one perform_calculation() call */
+    LOG_TRACE_EVENT       /* id, text: one event delivered to the module */
+};
+
+/**
+ * @brief What a replay did, filled in by log_trace_replay()
+ */
+struct log_trace_stats
+{
+    uint64_t inputs;     /**< perform_calculation() calls replayed */
+    uint64_t events;     /**< Events in the trace */
+    uint64_t matched;    /**< Replayed events identical to the recorded ones */
+    uint64_t mismatched; /**< Replayed events that differ from the recorded ones */
+    uint64_t missing;    /**< Recorded events the replay did not produce */
+    uint64_t extra;      /**< Replayed events the trace does not have */
+    uint64_t wall_ns;    /**< Elapsed time of the replay */
+    uint64_t cpu_ns;     /**< CPU time the process spent replaying */
+};
+
+/* Set while a capture is running; the hooks in logger.c test it before calling in */
+extern int log_trace_capturing;
+
+#ifdef __linux__
+#define LOG_TRACE_INPUT(module, a, b)                                 \
+    do                                                                \
+    {                                                                 \
+        if (__atomic_load_n(&log_trace_capturing, __ATOMIC_RELAXED)) \
+        {                                                             \
+            log_trace_input(module, a, b);                            \
+        }                                                             \
+    } while (0)
+#define LOG_TRACE_EVENT(module, message)                              \
+    do                                                                \
+    {                                                                 \
+        if (__atomic_load_n(&log_trace_capturing, __ATOMIC_RELAXED)) \
+        {                                                             \
+            log_trace_event(module, message);                         \
+        }                                                             \
+    } while (0)
+#else
+/* Capture needs a file system; elsewhere the hooks compile away */
+#define LOG_TRACE_INPUT(module, a, b) ((void)0)
+#define LOG_TRACE_EVENT(module, message) ((void)0)
+#endif
+
+/**
+ * @brief Starts recording every perform_calculation() input and every delivered event
+ *
+ * A module is described in the trace the first time it is seen, and again whenever its thresholds,
+ * aggregation window or sample budget have changed, so a replay runs with the same configuration.
+ * Aggregation callbacks and clocks are not recorded; a replayed window logs its summary. Linux only.
+ *
+ * @param[in] path Trace file, truncated
+ * @return int | 0 for success -1 for failure
+ */
+int log_trace_start(const char *path);
+
+/**
+ * @brief Stops the capture and flushes the trace
+ */
+void log_trace_stop(void);
+
+/**
+ * @brief Records one perform_calculation() input, called by the logger while capturing
+ *
+ * @param[in] module Module the calculation runs for
+ * @param[in] a      First operand
+ * @param[in] b      Second operand
+ */
+void log_trace_input(const struct log_module *module, long long a, long long b);
+
+/**
+ * @brief Records one event as delivered to the module's callback, called by the logger while capturing
+ *
+ * @param[in] module  Module the event belongs to
+ * @param[in] message Event message, after sampling tags have been added
+ */
+void log_trace_event(const struct log_module *module, const char *message);
+
+/**
+ * @brief Feeds a trace back through perform_calculation()
+ *
+ * Every module of the trace is rebuilt with its recorded configuration and a callback that
+ * logs "<module>: Callback message: <message>" through the active sink, so the output of two builds
+ * can be compared byte for byte. Each replayed event is also checked against the recorded one.
+ * Sampling and aggregation windows run on the recorded input times, so the output does not depend
+ * on the replay speed. The capture read its clock inside the calculation instead, so a sampled
+ * event close to the edge of a window may carry a different 1/N than the recorded one.
+ *
+ * @param[in]  path  Trace file
+ * @param[in]  speed 1.0 keeps the recorded timing, 2.0 is twice as fast, 0 replays as fast as possible
+ * @param[out] stats Counts and timings, may be NULL
+ * @return int | 0 for success -1 for failure, including a truncated or corrupt trace
+ */
+int log_trace_replay(const char *path, double speed, struct log_trace_stats *stats);
+
+#endif /* log_trace_h_ */
@@ -54,6 +54,9 @@
 /* Local includes */
 #include "ram-fs.h"
 #include "common/logger.h"
+#include "log-aggregate.h"
+#include "log-sample.h"
+#include "log-trace.h"
 
 #ifdef _WIN32
 
@@ -66,54 +69,175 @@ void return_linux_memory_usage(void)
 {
     struct rusage usage;
     getrusage(RUSAGE_SELF, &usage);
-    printf("Maximum resident set size: %ld kilobytes\n", usage.ru_maxrss);
+    log_printf("Maximum resident set size: %ld kilobytes\n", usage.ru_maxrss);
 }
 
 #endif
 
-static void event_occured(struct log_module *module, const char *message)
+int log_event(const struct log_module *module, const char *message)
 {
+    char sampled[MAX_LOG_MESSAGE_LENGTH];
+
     if (module == NULL)
     {
-        printf("Log module returned NULL\n");
-        return;
+        log_printf("Log module returned NULL\n");
+        return -1;
+    }
+    if (module->sample_budget > 0)
+    {
+        /* Past the budget only one event in N is delivered, tagged so consumers can re-weight counts */
+        uint32_t factor = log_sample(log_sample_module_site(module), module->sample_budget);
+        if (factor == 0)
+        {
+            return 0;
+        }
+        if (factor > 1)
+        {
+            size_t length = strlen(message);
+            if (length > 0 && message[length - 1] == '\n')
+            {
+                length--;
+            }
+            snprintf(sampled, sizeof(sampled), "%.*s [sampled 1/%u]\n", (int)length, message, (unsigned)factor);
+            message = sampled;
+        }
     }
+    LOG_TRACE_EVENT(module, message);
     if (module->callback)
     {
+#ifdef EATL_DWT_PROFILE
+        /* Callbacks are profiled per module rather than per call site */
+        DWT_PROFILE(module->module_name, module->callback(message));
+#else
         module->callback(message);
-        return;
+#endif
+        return 0;
     }
-    else
+    return log_printf("%s: An event occured \n", module->module_name);
+}
+
+static void event_occured(struct log_module *module, const char *message)
+{
+    log_event(module, message);
+}
+
+/* Thresholds of a module without its own, matching the compile-time limits */
+static const struct log_thresholds default_thresholds = {
+    .maximum = CALCULATION_MAXIMUM,
+    .minimum = CALCULATION_MINIMUM,
+    .hysteresis = 0,
+    .trigger = LOG_TRIGGER_LEVEL,
+    .state = LOG_THRESHOLD_NONE,
+};
+
+/* Band of a result, given the band of the previous one */
+static int classify_result(const struct log_thresholds *limits, int state, long long result)
+{
+    if (state == LOG_THRESHOLD_MAXIMUM && result > limits->maximum - limits->hysteresis)
+    {
+        return LOG_THRESHOLD_MAXIMUM;
+    }
+    if (state == LOG_THRESHOLD_MINIMUM && result < limits->minimum + limits->hysteresis)
     {
-        printf("%s: An event occured \n", module->module_name);
+        return LOG_THRESHOLD_MINIMUM;
     }
+    if (result > limits->maximum)
+    {
+        return LOG_THRESHOLD_MAXIMUM;
+    }
+    if (result < limits->minimum)
+    {
+        return LOG_THRESHOLD_MINIMUM;
+    }
+    return LOG_THRESHOLD_NONE;
+}
+
+int log_thresholds_init(struct log_thresholds *thresholds, long long minimum, long long maximum, long long hysteresis,
+                        enum log_trigger trigger)
+{
+    if (thresholds == NULL || minimum > maximum || hysteresis < 0)
+    {
+        log_printf("Invalid log thresholds\n");
+        return -1;
+    }
+    thresholds->minimum = minimum;
+    thresholds->maximum = maximum;
+    thresholds->hysteresis = hysteresis;
+    thresholds->trigger = trigger;
+    thresholds->state = LOG_THRESHOLD_NONE;
+    return 0;
+}
+
+int log_thresholds_set(struct log_module *module, long long minimum, long long maximum, long long hysteresis)
+{
+    if (module == NULL || module->thresholds == NULL || minimum > maximum || hysteresis < 0)
+    {
+        log_printf("Invalid log thresholds\n");
+        return -1;
+    }
+    module->thresholds->minimum = minimum;
+    module->thresholds->maximum = maximum;
+    module->thresholds->hysteresis = hysteresis;
+    return 0;
 }
 
 long long perform_calculation(struct log_module *module, long long a, long long b)
 {
     if (module == NULL)
     {
-        printf("Log module returned NULL");
+        log_printf("Log module returned NULL\n");
         return -1;
     }
+    LOG_TRACE_INPUT(module, a, b);
     long long result = a * b;
 
+    const struct log_thresholds *limits = module->thresholds != NULL ? module->thresholds : &default_thresholds;
+    int previous = limits->state;
+    int state = classify_result(limits, previous, result);
+    if (module->thresholds != NULL)
+    {
+        module->thresholds->state = state;
+    }
+
+    if (module->aggregate != NULL)
+    {
+        /* Only the first crossing of each threshold in a window is an event; the rest are counted */
+        if (log_aggregate_add(module, result, state))
+        {
+            event_occured(module, state == LOG_THRESHOLD_MAXIMUM ? "Calculation exceeds threshold\n"
+                                                                 : "Calculation falls below threshold\n");
+        }
+        return result;
+    }
+
+    if (limits->trigger == LOG_TRIGGER_EDGE)
+    {
+        /* Only changes of band are events, so a signal parked beyond a threshold is reported once */
+        if (state != previous)
+        {
+            event_occured(module, state == LOG_THRESHOLD_MAXIMUM   ? "Calculation exceeds threshold\n"
+                                  : state == LOG_THRESHOLD_MINIMUM ? "Calculation falls below threshold\n"
+                                                                   : "Calculation back between both thresholds\n");
+        }
+        return result;
+    }
+
     /* Using a swtich-statement to speed things up*/
-    if (result > CALCULATION_MAXIMUM)
+    if (state == LOG_THRESHOLD_MAXIMUM)
     {
         event_occured(module, "Calculation exceeds threshold\n");
     }
-    else if (result < CALCULATION_MINIMUM)
+    else if (state == LOG_THRESHOLD_MINIMUM)
     {
         event_occured(module, "Calculation falls below threshold\n");
     }
-    else if(result > CALCULATION_MINIMUM && result < CALCULATION_MAXIMUM)
+    else if(result > limits->minimum && result < limits->maximum)
     {
         event_occured(module, "Calculation falls between both thresholds\n");
     }
     else
     {
-        printf("Result is within both thresholds (result: %lld)\n", result);
+        log_printf("Result is within both thresholds (result: %lld)\n", result);
     }
     return result;
-}
\ No newline at end of file
+}
@@ -0,0 +1,310 @@
+/**
+ * @file mem-sample.c
+ * @brief Process memory sampling definitions
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#endif
+
+/* Local includes */
+#include "mem-sample.h"
+
+#ifdef __linux__
+
+#define STATM_PATH "/proc/self/statm"
+#define STATUS_PATH "/proc/self/status"
+#define SMAPS_ROLLUP_PATH "/proc/self/smaps_rollup"
+
+static int statm_fd = -1;
+static int status_fd = -1;
+static int smaps_fd = -1;
+static long page_size;
+
+/* Reads the whole of a /proc file from offset 0 without moving the descriptor */
+static ssize_t read_proc(int fd, char *buffer, size_t length)
+{
+    ssize_t bytes_read = pread(fd, buffer, length - 1, 0);
+    if (bytes_read < 0)
+    {
+        return -1;
+    }
+    buffer[bytes_read] = '\0';
+    return bytes_read;
+}
+
+/* Parses an unsigned decimal number and moves the cursor past it */
+static uint64_t parse_u64(const char **cursor)
+{
+    const char *p = *cursor;
+    uint64_t value = 0;
+
+    while (*p == ' ' || *p == '\t')
+    {
+        p++;
+    }
+    while (*p >= '0' && *p <= '9')
+    {
+        value = value * 10 + (uint64_t)(*p - '0');
+        p++;
+    }
+    *cursor = p;
+    return value;
+}
+
+/* Finds "Key:   1234 kB" in a status style buffer and returns the value in bytes */
+static uint64_t find_kb_field(const char *buffer, const char *key)
+{
+    size_t key_length = strlen(key);
+    const char *line = buffer;
+
+    while (line != NULL && *line != '\0')
+    {
+        if (strncmp(line, key, key_length) == 0 && line[key_length] == ':')
+        {
+            const char *cursor = line + key_length + 1;
+            return parse_u64(&cursor) * 1024;
+        }
+        line = strchr(line, '\n');
+        if (line != NULL)
+        {
+            line++;
+        }
+    }
+    return 0;
+}
+
+int mem_sample_open(void)
+{
+    if (statm_fd >= 0)
+    {
+        return 0;
+    }
+
+    page_size = sysconf(_SC_PAGESIZE);
+    statm_fd = open(STATM_PATH, O_RDONLY | O_CLOEXEC);
+    if (statm_fd == -1)
+    {
+        perror("open");
+        return -1;
+    }
+
+    /* Older kernels lack smaps_rollup; the sample then reports zero PSS and swap */
+    status_fd = open(STATUS_PATH, O_RDONLY | O_CLOEXEC);
+    smaps_fd = open(SMAPS_ROLLUP_PATH, O_RDONLY | O_CLOEXEC);
+    return 0;
+}
+
+void mem_sample_close(void)
+{
+    if (statm_fd >= 0)
+    {
+        close(statm_fd);
+    }
+    if (status_fd >= 0)
+    {
+        close(status_fd);
+    }
+    if (smaps_fd >= 0)
+    {
+        close(smaps_fd);
+    }
+    statm_fd = status_fd = smaps_fd = -1;
+}
+
+int mem_sample_read(struct mem_sample *sample)
+{
+    char buffer[4096];
+    struct timespec now;
+
+    if (sample == NULL || mem_sample_open() != 0)
+    {
+        return -1;
+    }
+    memset(sample, 0, sizeof(*sample));
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    sample->timestamp_ns = (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+
+    /* statm: size resident shared text lib data dt, all in pages */
+    if (read_proc(statm_fd, buffer, sizeof(buffer)) <= 0)
+    {
+        perror("pread");
+        return -1;
+    }
+    const char *cursor = buffer;
+    sample->vsz_bytes = parse_u64(&cursor) * (uint64_t)page_size;
+    sample->rss_bytes = parse_u64(&cursor) * (uint64_t)page_size;
+    sample->shared_bytes = parse_u64(&cursor) * (uint64_t)page_size;
+    sample->text_bytes = parse_u64(&cursor) * (uint64_t)page_size;
+    (void)parse_u64(&cursor); /* lib, always 0 since Linux 2.6 */
+    uint64_t data_bytes = parse_u64(&cursor) * (uint64_t)page_size;
+
+    if (status_fd >= 0 && read_proc(status_fd, buffer, sizeof(buffer)) > 0)
+    {
+        sample->stack_bytes = find_kb_field(buffer, "VmStk");
+    }
+    sample->heap_bytes = data_bytes > sample->stack_bytes ? data_bytes - sample->stack_bytes : 0;
+
+    if (smaps_fd >= 0 && read_proc(smaps_fd, buffer, sizeof(buffer)) > 0)
+    {
+        sample->pss_bytes = find_kb_field(buffer, "Pss");
+        sample->swap_bytes = find_kb_field(buffer, "Swap");
+    }
+    return 0;
+}
+
+static pthread_t sampler_thread;
+static volatile int sampler_running;
+static struct log_module *sampler_module;
+static long sampler_period_ns;
+
+static void *sampler_main(void *arg)
+{
+    struct timespec deadline;
+    struct mem_sample sample;
+    char line[MAX_LOG_MESSAGE_LENGTH];
+
+    (void)arg;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+    while (sampler_running)
+    {
+        if (mem_sample_read(&sample) == 0)
+        {
+            snprintf(line, sizeof(line),
+                     "%s: mem t=%llu vsz=%llu rss=%llu shared=%llu heap=%llu stack=%llu pss=%llu swap=%llu",
+                     sampler_module->module_name,
+                     (unsigned long long)sample.timestamp_ns,
+                     (unsigned long long)sample.vsz_bytes,
+                     (unsigned long long)sample.rss_bytes,
+                     (unsigned long long)sample.shared_bytes,
+                     (unsigned long long)sample.heap_bytes,
+                     (unsigned long long)sample.stack_bytes,
+                     (unsigned long long)sample.pss_bytes,
+                     (unsigned long long)sample.swap_bytes);
+            LOG_MSG(INFO, line);
+        }
+
+        deadline.tv_nsec += sampler_period_ns;
+        while (deadline.tv_nsec >= 1000000000L)
+        {
+            deadline.tv_nsec -= 1000000000L;
+            deadline.tv_sec++;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+    }
+    return NULL;
+}
+
+int mem_sampler_start(struct log_module *module, unsigned int hz)
+{
+    if (module == NULL)
+    {
+        log_printf("Log module returned NULL\n");
+        return -1;
+    }
+    if (hz == 0 || hz > MEM_SAMPLER_MAX_HZ || sampler_running)
+    {
+        return -1;
+    }
+    if (mem_sample_open() != 0)
+    {
+        return -1;
+    }
+
+    sampler_module = module;
+    sampler_period_ns = 1000000000L / (long)hz;
+    sampler_running = 1;
+    if (pthread_create(&sampler_thread, NULL, sampler_main, NULL) != 0)
+    {
+        sampler_running = 0;
+        return -1;
+    }
+    return 0;
+}
+
+void mem_sampler_stop(void)
+{
+    if (!sampler_running)
+    {
+        return;
+    }
+    sampler_running = 0;
+    pthread_join(sampler_thread, NULL);
+}
+
+#else /* If linux is not found */
+
+int mem_sample_open(void)
+{
+    return -1;
+}
+
+void mem_sample_close(void)
+{
+}
+
+int mem_sample_read(struct mem_sample *sample)
+{
+    (void)sample;
+    return -1;
+}
+
+int mem_sampler_start(struct log_module *module, unsigned int hz)
+{
+    (void)module;
+    (void)hz;
+    return -1;
+}
+
+void mem_sampler_stop(void)
+{
+}
+
+#endif /* __linux__ */
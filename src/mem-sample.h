@@ -0,0 +1,105 @@
+/**
+ * @file mem-sample.h
+ * @brief Process memory sampling declarations
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef mem_sample_h_
+#define mem_sample_h_
+
+#include <stdint.h>
+
+#include "common/logger.h"
+
+#define MEM_SAMPLER_MAX_HZ 1000
+
+/**
+ * @brief One sample of the process' memory footprint
+ *
+ * All figures are in bytes. heap_bytes covers the data segment and anonymous mappings
+ * (statm "data") minus the main thread's stack.
+ */
+struct mem_sample
+{
+    uint64_t timestamp_ns; /**< CLOCK_MONOTONIC time the sample was taken */
+    uint64_t vsz_bytes;    /**< Virtual memory size */
+    uint64_t rss_bytes;    /**< Resident set size */
+    uint64_t shared_bytes; /**< Resident pages backed by files or shared memory */
+    uint64_t text_bytes;   /**< Size of the program's text */
+    uint64_t heap_bytes;   /**< Data segment and anonymous mappings */
+    uint64_t stack_bytes;  /**< Main thread stack */
+    uint64_t pss_bytes;    /**< Proportional set size (smaps_rollup) */
+    uint64_t swap_bytes;   /**< Swapped out anonymous memory (smaps_rollup) */
+};
+
+/**
+ * @brief Opens the /proc files used for sampling
+ *
+ * The descriptors stay open until mem_sample_close() so each sample costs only a pread per file.
+ * Called implicitly by mem_sample_read() when needed.
+ *
+ * @return int | 0 for success -1 for failure
+ */
+int mem_sample_open(void);
+
+/**
+ * @brief Closes the descriptors opened by mem_sample_open()
+ */
+void mem_sample_close(void);
+
+/**
+ * @brief Takes one sample of the process' memory usage
+ *
+ * @param[out] sample Sample to fill
+ * @return int | 0 for success -1 for failure
+ */
+int mem_sample_read(struct mem_sample *sample);
+
+/**
+ * @brief Starts a background thread that logs a memory sample at a fixed rate
+ *
+ * Samples are scheduled against absolute deadlines so the rate does not drift with the cost of a
+ * sample. Each sample is written to the log stream as one line tagged with the module's name.
+ *
+ * @param[in] module Module the samples are logged under
+ * @param[in] hz     Samples per second (1 to MEM_SAMPLER_MAX_HZ)
+ * @return int | 0 for success -1 for failure
+ */
+int mem_sampler_start(struct log_module *module, unsigned int hz);
+
+/**
+ * @brief Stops the sampler thread started by mem_sampler_start()
+ */
+void mem_sampler_stop(void);
+
+#endif /* mem_sample_h_ */
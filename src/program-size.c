@@ -40,27 +40,58 @@
 #include <stdlib.h>
 #include <string.h>
 
-#ifdef _WIN32
+/* Decodes little-endian and big-endian fields from raw header bytes */
+static uint16_t read_u16(const unsigned char *p, int big_endian)
+{
+    return big_endian ? (uint16_t)((p[0] << 8) | p[1]) : (uint16_t)(p[0] | (p[1] << 8));
+}
 
-#include <windows.h>
+static uint32_t read_u32(const unsigned char *p, int big_endian)
+{
+    return big_endian ? ((uint32_t)read_u16(p, 1) << 16) | read_u16(p + 2, 1)
+                      : ((uint32_t)read_u16(p + 2, 0) << 16) | read_u16(p, 0);
+}
 
-#endif /* End of _WIN32 MACRO */
+static uint64_t read_u64(const unsigned char *p, int big_endian)
+{
+    return big_endian ? ((uint64_t)read_u32(p, 1) << 32) | read_u32(p + 4, 1)
+                      : ((uint64_t)read_u32(p + 4, 0) << 32) | read_u32(p, 0);
+}
+
+static int size_pe_file(FILE *file, const char *filename, size_t *totalSize, int sections);
+static int size_elf_file(FILE *file, const char *filename, size_t *totalSize, int sections);
 
-#ifdef __linux__
+static const char *const section_class_names[SECTION_CLASS_COUNT] = {"code", "rodata", "data", "bss", "other"};
 
-#include <elf.h>
+/* Per-section listing, ended by a totals line per class that scripts can pick up */
+static void print_section(const char *name, size_t size, section_class kind, size_t *classTotals)
+{
+    printf("  %-28s %10zu  %s\n", name, size, section_class_names[kind]);
+    classTotals[kind] += size;
+}
 
-#endif /* End of _WIN32 MACRO */
+static void print_class_totals(const size_t *classTotals)
+{
+    printf("Totals:");
+    for (int kind = 0; kind < SECTION_CLASS_COUNT; kind++)
+    {
+        printf("%s %s %zu", kind == 0 ? "" : ",", section_class_names[kind], classTotals[kind]);
+    }
+    printf(" bytes\n");
+}
 
 int main(int argc, char *argv[])
 {
-    if (argc < 2)
+    int sections = argc == 3 && strcmp(argv[1], "-s") == 0;
+
+    if (argc != 2 && !sections)
     {
-        fprintf(stderr, "Usage: %s <executable>\n", argv[0]);
+        fprintf(stderr, "Usage: %s [-s] <executable>\n", argv[0]);
+        fprintf(stderr, "  -s  List every section with its class (code, rodata, data, bss, other)\n");
         return 1;
     }
 
-    const char *filename = argv[1];
+    const char *filename = argv[argc - 1];
     FILE *file = fopen(filename, "rb");
 
     if (!file)
@@ -69,137 +100,280 @@ int main(int argc, char *argv[])
         return 1;
     }
 
-#ifdef _WIN32
+    size_t totalSize = 0;
+    int status;
 
-    IMAGE_DOS_HEADER dosHeader;
-    if (!_READ_DOS_HEADER(file, &dosHeader))
+    /* The format is taken from the file itself rather than the host the tool was built on */
+    switch (detect_binary_format(file))
+    {
+    case BINARY_FORMAT_PE32:
+    case BINARY_FORMAT_PE32_PLUS:
+        status = size_pe_file(file, filename, &totalSize, sections);
+        break;
+    case BINARY_FORMAT_ELF32:
+    case BINARY_FORMAT_ELF64:
+        status = size_elf_file(file, filename, &totalSize, sections);
+        break;
+    default:
+        fprintf(stderr, "Not a valid PE or ELF file: %s\n", filename);
+        status = -1;
+        break;
+    }
+
+    fclose(file);
+
+    if (status != 0)
     {
-        fprintf(stderr, "Not a valid PE file: %s\n", filename);
-        fclose(file);
         return 1;
     }
 
-    DWORD peSignature;
-    if (!_READ_PE_HEADER(file, &peSignature, dosHeader.e_lfanew))
+    printf("Size of the executable: %zu bytes\n", totalSize);
+
+    return 0x00;
+}
+
+binary_format detect_binary_format(FILE *file)
+{
+    unsigned char ident[ELF_IDENT_SIZE];
+
+    if (fseek(file, 0, SEEK_SET) != 0 || fread(ident, sizeof(ident), 1, file) != 1)
+    {
+        return BINARY_FORMAT_UNKNOWN;
+    }
+
+    if (memcmp(ident, "\x7F" "ELF", 4) == 0)
+    {
+        switch (ident[4])
+        {
+        case ELF_CLASS_32:
+            return BINARY_FORMAT_ELF32;
+        case ELF_CLASS_64:
+            return BINARY_FORMAT_ELF64;
+        default:
+            return BINARY_FORMAT_UNKNOWN;
+        }
+    }
+
+    PE_DOS_HEADER dosHeader;
+    PE_FILE_HEADER fileHeader;
+    PE_OPTIONAL_HEADER optionalHeader;
+
+    if (fseek(file, 0, SEEK_SET) != 0 ||
+        !_READ_DOS_HEADER(file, &dosHeader) ||
+        !_READ_PE_HEADER(file, dosHeader.e_lfanew) ||
+        !_READ_FILE_HEADER(file, &fileHeader) ||
+        !_READ_OPT_HEADER(file, &optionalHeader, fileHeader.SizeOfOptionalHeader))
+    {
+        return BINARY_FORMAT_UNKNOWN;
+    }
+
+    switch (optionalHeader.Magic)
+    {
+    case PE_OPT_MAGIC_PE32:
+        return BINARY_FORMAT_PE32;
+    case PE_OPT_MAGIC_PE32_PLUS:
+        return BINARY_FORMAT_PE32_PLUS;
+    default:
+        return BINARY_FORMAT_UNKNOWN;
+    }
+}
+
+static int size_pe_file(FILE *file, const char *filename, size_t *totalSize, int sections)
+{
+    PE_DOS_HEADER dosHeader;
+    if (fseek(file, 0, SEEK_SET) != 0 || !_READ_DOS_HEADER(file, &dosHeader))
     {
         fprintf(stderr, "Not a valid PE file: %s\n", filename);
-        fclose(file);
-        return 1;
+        return -1;
+    }
+
+    if (!_READ_PE_HEADER(file, dosHeader.e_lfanew))
+    {
+        fprintf(stderr, "Not a valid PE file: %s\n", filename);
+        return -1;
     }
 
-    IMAGE_FILE_HEADER fileHeader;
+    PE_FILE_HEADER fileHeader;
     if (!_READ_FILE_HEADER(file, &fileHeader))
     {
         fprintf(stderr, "Error reading file header\n");
-        fclose(file);
-        return 1;
+        return -1;
     }
 
-    IMAGE_OPTIONAL_HEADER optionalHeader;
-    if (!_READ_OPT_HEADER(file, &optionalHeader))
+    PE_OPTIONAL_HEADER optionalHeader;
+    if (!_READ_OPT_HEADER(file, &optionalHeader, fileHeader.SizeOfOptionalHeader))
     {
         fprintf(stderr, "Error reading optional header\n");
-        fclose(file);
-        return 1;
+        return -1;
     }
 
-    IMAGE_SECTION_HEADER *sectionHeaders = malloc(fileHeader.NumberOfSections * sizeof(IMAGE_SECTION_HEADER));
+    PE_SECTION_HEADER *sectionHeaders = malloc(fileHeader.NumberOfSections * sizeof(PE_SECTION_HEADER));
     if (!sectionHeaders)
     {
         fprintf(stderr, "Memory allocation failure\n");
-        fclose(file);
-        return 1;
+        return -1;
     }
 
     if (!_READ_SECTION_HEADERS(file, sectionHeaders, fileHeader.NumberOfSections))
     {
         fprintf(stderr, "Error reading section headers\n");
         free(sectionHeaders);
-        fclose(file);
-        return 1;
+        return -1;
     }
 
-    size_t totalSize = calculate_total_header_size(sectionHeaders, fileHeader.NumberOfSections);
-
-    free(sectionHeaders);
-    fclose(file);
+    *totalSize = calculate_total_header_size_pe(sectionHeaders, fileHeader.NumberOfSections);
 
-    printf("Size of the executable: %zu bytes\n", totalSize);
-#endif
+    if (sections)
+    {
+        size_t classTotals[SECTION_CLASS_COUNT] = {0};
+        printf("Sections of %s:\n", filename);
+        for (int i = 0; i < fileHeader.NumberOfSections; i++)
+        {
+            section_class kind = classify_pe_section(&sectionHeaders[i]);
+            /* Zero filled sections have no raw data; their size is the one they take in memory */
+            size_t size = kind == SECTION_BSS ? sectionHeaders[i].VirtualSize : sectionHeaders[i].SizeOfRawData;
+            print_section(sectionHeaders[i].Name, size, kind, classTotals);
+        }
+        print_class_totals(classTotals);
+    }
 
-#ifdef __linux__
+    free(sectionHeaders);
+    return 0;
+}
 
-    Elf32_Ehdr elfHeader;
+static int size_elf_file(FILE *file, const char *filename, size_t *totalSize, int sections)
+{
+    ELF_HEADER elfHeader;
     if (!_READ_ELF_HEADER(file, &elfHeader))
     {
         fprintf(stderr, "Not a valid ELF file: %s\n", filename);
-        fclose(file);
-        return 1;
+        return -1;
     }
 
-    Elf32_Shdr *sectionHeaders = malloc(elfHeader.e_shnum * sizeof(Elf32_Shdr));
-    if (!sectionHeaders)
+    ELF_SECTION_HEADER *sectionHeaders = malloc(elfHeader.e_shnum * sizeof(ELF_SECTION_HEADER));
+    if (elfHeader.e_shnum > 0 && !sectionHeaders)
     {
         fprintf(stderr, "Memory allocation failure\n");
-        fclose(file);
-        return 1;
+        return -1;
     }
 
-    if (!_READ_SECTION_HEADERS_LINUX(file, sectionHeaders, elfHeader.e_shnum, elfHeader.e_shoff))
+    if (!_READ_SECTION_HEADERS_ELF(file, &elfHeader, sectionHeaders))
     {
         fprintf(stderr, "Error reading section headers\n");
         free(sectionHeaders);
-        fclose(file);
-        return 1;
+        return -1;
     }
 
-    size_t totalSize = calculate_total_header_size(sectionHeaders, elfHeader.e_shnum);
-
-    free(sectionHeaders);
-    fclose(file);
+    *totalSize = calculate_total_header_size_elf(sectionHeaders, elfHeader.e_shnum);
 
-    printf("Size of the executable: %zu bytes\n", totalSize);
-
-#endif
+    if (sections)
+    {
+        size_t namesSize = 0;
+        size_t classTotals[SECTION_CLASS_COUNT] = {0};
+        char *names = _READ_SECTION_NAMES_ELF(file, &elfHeader, sectionHeaders, &namesSize);
+
+        printf("Sections of %s:\n", filename);
+        /* Section 0 is the reserved null entry */
+        for (int i = 1; i < elfHeader.e_shnum; i++)
+        {
+            const char *name = names != NULL && sectionHeaders[i].sh_name < namesSize ? names + sectionHeaders[i].sh_name : "?";
+            print_section(name, (size_t)sectionHeaders[i].sh_size, classify_elf_section(&sectionHeaders[i]), classTotals);
+        }
+        print_class_totals(classTotals);
+        free(names);
+    }
 
-    return 0x00;
+    free(sectionHeaders);
+    return 0;
 }
 
-#ifdef _WIN32
-
 // Function implementations
-int _READ_DOS_HEADER(FILE *file, IMAGE_DOS_HEADER *dosHeader)
+int _READ_DOS_HEADER(FILE *file, PE_DOS_HEADER *dosHeader)
 {
-    return fread(dosHeader, sizeof(IMAGE_DOS_HEADER), 1, file) == 1 &&
-           dosHeader->e_magic == IMAGE_DOS_SIGNATURE;
+    unsigned char raw[PE_DOS_HEADER_SIZE];
+
+    if (fread(raw, sizeof(raw), 1, file) != 1)
+    {
+        return 0;
+    }
+    dosHeader->e_magic = read_u16(raw, 0);
+    dosHeader->e_lfanew = read_u32(raw + 0x3C, 0);
+    return dosHeader->e_magic == PE_DOS_SIGNATURE;
 }
 
-int _READ_PE_HEADER(FILE *file, DWORD *peSignature, long peOffset)
+int _READ_PE_HEADER(FILE *file, long peOffset)
 {
+    unsigned char raw[4];
+
     if (fseek(file, peOffset, SEEK_SET) != 0)
     {
         return 0;
     }
-    return fread(peSignature, sizeof(DWORD), 1, file) == 1 &&
-           *peSignature == IMAGE_NT_SIGNATURE;
+    return fread(raw, sizeof(raw), 1, file) == 1 &&
+           read_u32(raw, 0) == PE_NT_SIGNATURE;
 }
 
-int _READ_FILE_HEADER(FILE *file, IMAGE_FILE_HEADER *fileHeader)
+int _READ_FILE_HEADER(FILE *file, PE_FILE_HEADER *fileHeader)
 {
-    return fread(fileHeader, sizeof(IMAGE_FILE_HEADER), 1, file) == 1;
+    unsigned char raw[PE_FILE_HEADER_SIZE];
+
+    if (fread(raw, sizeof(raw), 1, file) != 1)
+    {
+        return 0;
+    }
+    fileHeader->Machine = read_u16(raw, 0);
+    fileHeader->NumberOfSections = read_u16(raw + 2, 0);
+    fileHeader->TimeDateStamp = read_u32(raw + 4, 0);
+    fileHeader->PointerToSymbolTable = read_u32(raw + 8, 0);
+    fileHeader->NumberOfSymbols = read_u32(raw + 12, 0);
+    fileHeader->SizeOfOptionalHeader = read_u16(raw + 16, 0);
+    fileHeader->Characteristics = read_u16(raw + 18, 0);
+    return 1;
 }
 
-int _READ_OPT_HEADER(FILE *file, IMAGE_OPTIONAL_HEADER *optionalHeader)
+int _READ_OPT_HEADER(FILE *file, PE_OPTIONAL_HEADER *optionalHeader, uint16_t sizeOfOptionalHeader)
 {
-    return fread(optionalHeader, sizeof(IMAGE_OPTIONAL_HEADER), 1, file) == 1;
+    unsigned char raw[PE_OPT_HEADER_COMMON_SIZE];
+
+    if (sizeOfOptionalHeader < sizeof(raw) || fread(raw, sizeof(raw), 1, file) != 1)
+    {
+        return 0;
+    }
+    optionalHeader->Magic = read_u16(raw, 0);
+    optionalHeader->MajorLinkerVersion = raw[2];
+    optionalHeader->MinorLinkerVersion = raw[3];
+    optionalHeader->SizeOfCode = read_u32(raw + 4, 0);
+    optionalHeader->SizeOfInitializedData = read_u32(raw + 8, 0);
+    optionalHeader->SizeOfUninitializedData = read_u32(raw + 12, 0);
+    optionalHeader->AddressOfEntryPoint = read_u32(raw + 16, 0);
+    optionalHeader->BaseOfCode = read_u32(raw + 20, 0);
+
+    /* Skip the PE32/PE32+ specific fields and data directories to land on the section table */
+    return fseek(file, (long)sizeOfOptionalHeader - (long)sizeof(raw), SEEK_CUR) == 0;
 }
 
-int _READ_SECTION_HEADERS(FILE *file, IMAGE_SECTION_HEADER *sectionHeaders, int numberOfSections)
+int _READ_SECTION_HEADERS(FILE *file, PE_SECTION_HEADER *sectionHeaders, int numberOfSections)
 {
-    return fread(sectionHeaders, sizeof(IMAGE_SECTION_HEADER), numberOfSections, file) == numberOfSections;
+    unsigned char raw[PE_SECTION_HEADER_SIZE];
+
+    for (int i = 0; i < numberOfSections; i++)
+    {
+        if (fread(raw, sizeof(raw), 1, file) != 1)
+        {
+            return 0;
+        }
+        memcpy(sectionHeaders[i].Name, raw, PE_SECTION_NAME_LENGTH);
+        sectionHeaders[i].Name[PE_SECTION_NAME_LENGTH] = '\0';
+        sectionHeaders[i].VirtualSize = read_u32(raw + 8, 0);
+        sectionHeaders[i].VirtualAddress = read_u32(raw + 12, 0);
+        sectionHeaders[i].SizeOfRawData = read_u32(raw + 16, 0);
+        sectionHeaders[i].PointerToRawData = read_u32(raw + 20, 0);
+        sectionHeaders[i].Characteristics = read_u32(raw + 36, 0);
+    }
+    return 1;
 }
 
-size_t calculate_total_header_size(const IMAGE_SECTION_HEADER *sectionHeaders, int numberOfSections)
+size_t calculate_total_header_size_pe(const PE_SECTION_HEADER *sectionHeaders, int numberOfSections)
 {
     size_t totalSize = 0;
     for (int i = 0; i < numberOfSections; i++)
@@ -209,31 +383,105 @@ size_t calculate_total_header_size(const IMAGE_SECTION_HEADER *sectionHeaders, i
     return totalSize;
 }
 
-#endif
+int _READ_ELF_HEADER(FILE *file, ELF_HEADER *elfHeader)
+{
+    unsigned char raw[ELF64_HEADER_SIZE];
 
-#ifdef __linux__
+    if (fseek(file, 0, SEEK_SET) != 0 || fread(raw, ELF_IDENT_SIZE, 1, file) != 1)
+    {
+        return 0;
+    }
+    if (memcmp(raw, "\x7F" "ELF", 4) != 0)
+    {
+        return 0;
+    }
 
-#include <elf.h>
+    int is64 = raw[4] == ELF_CLASS_64;
+    int big_endian = raw[5] == ELF_DATA_MSB;
+    size_t headerSize = is64 ? ELF64_HEADER_SIZE : ELF32_HEADER_SIZE;
 
-int _READ_ELF_HEADER(FILE *file, Elf32_Ehdr *elfHeader)
-{
-    if (fread(elfHeader, sizeof(Elf32_Ehdr), 1, file) != 1)
+    if ((raw[4] != ELF_CLASS_32 && !is64) || (raw[5] != ELF_DATA_LSB && !big_endian))
     {
         return 0;
     }
-    return memcmp(elfHeader->e_ident, ELFMAG, SELFMAG) == 0;
+    if (fread(raw + ELF_IDENT_SIZE, headerSize - ELF_IDENT_SIZE, 1, file) != 1)
+    {
+        return 0;
+    }
+
+    memcpy(elfHeader->e_ident, raw, ELF_IDENT_SIZE);
+    elfHeader->e_type = read_u16(raw + 16, big_endian);
+    elfHeader->e_machine = read_u16(raw + 18, big_endian);
+    if (is64)
+    {
+        elfHeader->e_entry = read_u64(raw + 24, big_endian);
+        elfHeader->e_phoff = read_u64(raw + 32, big_endian);
+        elfHeader->e_shoff = read_u64(raw + 40, big_endian);
+        elfHeader->e_shentsize = read_u16(raw + 58, big_endian);
+        elfHeader->e_shnum = read_u16(raw + 60, big_endian);
+        elfHeader->e_shstrndx = read_u16(raw + 62, big_endian);
+    }
+    else
+    {
+        elfHeader->e_entry = read_u32(raw + 24, big_endian);
+        elfHeader->e_phoff = read_u32(raw + 28, big_endian);
+        elfHeader->e_shoff = read_u32(raw + 32, big_endian);
+        elfHeader->e_shentsize = read_u16(raw + 46, big_endian);
+        elfHeader->e_shnum = read_u16(raw + 48, big_endian);
+        elfHeader->e_shstrndx = read_u16(raw + 50, big_endian);
+    }
+    return 1;
 }
 
-int _READ_SECTION_HEADERS_LINUX(FILE *file, Elf32_Shdr *sectionHeaders, int sectionHeaderCount, int sectionHeaderOffset)
+int _READ_SECTION_HEADERS_ELF(FILE *file, const ELF_HEADER *elfHeader, ELF_SECTION_HEADER *sectionHeaders)
 {
-    if (fseek(file, sectionHeaderOffset, SEEK_SET) != 0)
+    int is64 = elfHeader->e_ident[4] == ELF_CLASS_64;
+    int big_endian = elfHeader->e_ident[5] == ELF_DATA_MSB;
+    size_t entrySize = is64 ? ELF64_SECTION_HEADER_SIZE : ELF32_SECTION_HEADER_SIZE;
+    unsigned char raw[ELF64_SECTION_HEADER_SIZE];
+
+    if (elfHeader->e_shnum == 0)
+    {
+        return 1;
+    }
+    if (elfHeader->e_shentsize < entrySize || fseek(file, (long)elfHeader->e_shoff, SEEK_SET) != 0)
     {
         return 0;
     }
-    return fread(sectionHeaders, sizeof(Elf32_Shdr), sectionHeaderCount, file) == sectionHeaderCount;
+
+    for (int i = 0; i < elfHeader->e_shnum; i++)
+    {
+        if (fread(raw, entrySize, 1, file) != 1)
+        {
+            return 0;
+        }
+        sectionHeaders[i].sh_name = read_u32(raw, big_endian);
+        sectionHeaders[i].sh_type = read_u32(raw + 4, big_endian);
+        if (is64)
+        {
+            sectionHeaders[i].sh_flags = read_u64(raw + 8, big_endian);
+            sectionHeaders[i].sh_addr = read_u64(raw + 16, big_endian);
+            sectionHeaders[i].sh_offset = read_u64(raw + 24, big_endian);
+            sectionHeaders[i].sh_size = read_u64(raw + 32, big_endian);
+        }
+        else
+        {
+            sectionHeaders[i].sh_flags = read_u32(raw + 8, big_endian);
+            sectionHeaders[i].sh_addr = read_u32(raw + 12, big_endian);
+            sectionHeaders[i].sh_offset = read_u32(raw + 16, big_endian);
+            sectionHeaders[i].sh_size = read_u32(raw + 20, big_endian);
+        }
+        /* Skip any extension bytes when e_shentsize is larger than the standard entry */
+        if (elfHeader->e_shentsize > entrySize &&
+            fseek(file, (long)(elfHeader->e_shentsize - entrySize), SEEK_CUR) != 0)
+        {
+            return 0;
+        }
+    }
+    return 1;
 }
 
-size_t calculate_total_header_size(const Elf32_Shdr *sectionHeaders, int sectionHeaderCount)
+size_t calculate_total_header_size_elf(const ELF_SECTION_HEADER *sectionHeaders, int sectionHeaderCount)
 {
     size_t totalSize = 0;
     for (int i = 0; i < sectionHeaderCount; i++)
@@ -243,4 +491,63 @@ size_t calculate_total_header_size(const Elf32_Shdr *sectionHeaders, int section
     return totalSize;
 }
 
-#endif
\ No newline at end of file
+char *_READ_SECTION_NAMES_ELF(FILE *file, const ELF_HEADER *elfHeader, const ELF_SECTION_HEADER *sectionHeaders,
+                              size_t *namesSize)
+{
+    if (elfHeader->e_shstrndx == 0 || elfHeader->e_shstrndx >= elfHeader->e_shnum)
+    {
+        return NULL;
+    }
+
+    const ELF_SECTION_HEADER *table = &sectionHeaders[elfHeader->e_shstrndx];
+    char *names = malloc((size_t)table->sh_size + 1);
+    if (!names)
+    {
+        return NULL;
+    }
+    if (fseek(file, (long)table->sh_offset, SEEK_SET) != 0 || fread(names, (size_t)table->sh_size, 1, file) != 1)
+    {
+        free(names);
+        return NULL;
+    }
+    /* A table without a trailing NUL must not let a name run off its end */
+    names[table->sh_size] = '\0';
+    *namesSize = (size_t)table->sh_size;
+    return names;
+}
+
+section_class classify_elf_section(const ELF_SECTION_HEADER *sectionHeader)
+{
+    if (!(sectionHeader->sh_flags & ELF_SHF_ALLOC))
+    {
+        return SECTION_OTHER;
+    }
+    if (sectionHeader->sh_flags & ELF_SHF_EXECINSTR)
+    {
+        return SECTION_CODE;
+    }
+    if (sectionHeader->sh_type == ELF_SHT_NOBITS)
+    {
+        return SECTION_BSS;
+    }
+    return sectionHeader->sh_flags & ELF_SHF_WRITE ? SECTION_DATA : SECTION_RODATA;
+}
+
+section_class classify_pe_section(const PE_SECTION_HEADER *sectionHeader)
+{
+    uint32_t flags = sectionHeader->Characteristics;
+
+    if (flags & PE_SCN_MEM_DISCARDABLE)
+    {
+        return SECTION_OTHER;
+    }
+    if (flags & (PE_SCN_CNT_CODE | PE_SCN_MEM_EXECUTE))
+    {
+        return SECTION_CODE;
+    }
+    if (flags & PE_SCN_CNT_UNINITIALIZED_DATA)
+    {
+        return SECTION_BSS;
+    }
+    return flags & PE_SCN_MEM_WRITE ? SECTION_DATA : SECTION_RODATA;
+}
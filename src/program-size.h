@@ -41,9 +41,165 @@
 #include <stdlib.h>
 #include <stdio.h>
 
-#ifdef _WIN32
+/*
+ * The header layouts below mirror the PE/COFF and ELF specifications with fixed-width
+ * types so one host tool can parse both formats without windows.h or elf.h. Fields are
+ * decoded byte by byte from the file, so neither struct packing nor host endianness matter.
+ */
+
+#define PE_DOS_SIGNATURE 0x5A4D         /* "MZ" */
+#define PE_NT_SIGNATURE 0x00004550      /* "PE\0\0" */
+#define PE_OPT_MAGIC_PE32 0x10B
+#define PE_OPT_MAGIC_PE32_PLUS 0x20B
+
+#define PE_DOS_HEADER_SIZE 64
+#define PE_FILE_HEADER_SIZE 20
+#define PE_OPT_HEADER_COMMON_SIZE 24
+#define PE_SECTION_HEADER_SIZE 40
+#define PE_SECTION_NAME_LENGTH 8
+
+#define ELF_IDENT_SIZE 16
+#define ELF_CLASS_32 1
+#define ELF_CLASS_64 2
+#define ELF_DATA_LSB 1
+#define ELF_DATA_MSB 2
+#define ELF32_HEADER_SIZE 52
+#define ELF64_HEADER_SIZE 64
+#define ELF32_SECTION_HEADER_SIZE 40
+#define ELF64_SECTION_HEADER_SIZE 64
+
+#define ELF_SHT_NOBITS 8           /* Occupies no file space, e.g. .bss */
+#define ELF_SHF_WRITE 0x1
+#define ELF_SHF_ALLOC 0x2          /* Loaded into memory at run time */
+#define ELF_SHF_EXECINSTR 0x4
+
+#define PE_SCN_CNT_CODE 0x00000020
+#define PE_SCN_CNT_UNINITIALIZED_DATA 0x00000080
+#define PE_SCN_MEM_DISCARDABLE 0x02000000
+#define PE_SCN_MEM_EXECUTE 0x20000000
+#define PE_SCN_MEM_WRITE 0x80000000
+
+/**
+ * @brief Executable formats recognized from the file magic
+ */
+typedef enum binary_format
+{
+    BINARY_FORMAT_UNKNOWN = 0, /**< Magic did not match any supported format */
+    BINARY_FORMAT_PE32,        /**< 32-bit portable executable */
+    BINARY_FORMAT_PE32_PLUS,   /**< 64-bit portable executable */
+    BINARY_FORMAT_ELF32,       /**< 32-bit executable linkable format */
+    BINARY_FORMAT_ELF64        /**< 64-bit executable linkable format */
+} binary_format;
+
+/**
+ * @brief What a section holds, as reported by lsize -s
+ */
+typedef enum section_class
+{
+    SECTION_CODE = 0, /**< Executable instructions */
+    SECTION_RODATA,   /**< Loaded, read only data */
+    SECTION_DATA,     /**< Loaded, writable and initialized from the file */
+    SECTION_BSS,      /**< Loaded, writable and zero filled; takes no file space */
+    SECTION_OTHER,    /**< Not loaded: symbols, debug information, notes */
+    SECTION_CLASS_COUNT
+} section_class;
+
+/**
+ * @brief DOS header found at the start of every PE file
+ *
+ * Only the signature and the offset to the PE header are needed to size the executable.
+ */
+typedef struct
+{
+    uint16_t e_magic;  /**< DOS signature (MZ) */
+    uint32_t e_lfanew; /**< File offset of the PE signature */
+} PE_DOS_HEADER;
+
+/**
+ * @brief COFF file header that follows the PE signature
+ */
+typedef struct
+{
+    uint16_t Machine;              /**< Target machine architecture */
+    uint16_t NumberOfSections;     /**< Number of entries in the section table */
+    uint32_t TimeDateStamp;        /**< Link time */
+    uint32_t PointerToSymbolTable; /**< File offset of the COFF symbol table */
+    uint32_t NumberOfSymbols;      /**< Number of COFF symbols */
+    uint16_t SizeOfOptionalHeader; /**< Size of the optional header that follows */
+    uint16_t Characteristics;      /**< File flags */
+} PE_FILE_HEADER;
 
-#include <windows.h>
+/**
+ * @brief Standard fields shared by the PE32 and PE32+ optional headers
+ *
+ * The Magic member tells PE32 (0x10B) from PE32+ (0x20B). The remaining windows-specific
+ * fields differ in width between the two and are skipped using SizeOfOptionalHeader.
+ */
+typedef struct
+{
+    uint16_t Magic;                   /**< PE32 or PE32+ */
+    uint8_t MajorLinkerVersion;       /**< Linker major version */
+    uint8_t MinorLinkerVersion;       /**< Linker minor version */
+    uint32_t SizeOfCode;              /**< Size of the code section(s) */
+    uint32_t SizeOfInitializedData;   /**< Size of the initialized data section(s) */
+    uint32_t SizeOfUninitializedData; /**< Size of the uninitialized data section(s) */
+    uint32_t AddressOfEntryPoint;     /**< RVA of the entry point */
+    uint32_t BaseOfCode;              /**< RVA of the start of the code section */
+} PE_OPTIONAL_HEADER;
+
+/**
+ * @brief Entry in the PE section table
+ */
+typedef struct
+{
+    char Name[PE_SECTION_NAME_LENGTH + 1]; /**< Section name, null-terminated */
+    uint32_t VirtualSize;                  /**< Size of the section in memory */
+    uint32_t VirtualAddress;               /**< RVA of the section */
+    uint32_t SizeOfRawData;                /**< Size of the section on disk */
+    uint32_t PointerToRawData;             /**< File offset of the section data */
+    uint32_t Characteristics;              /**< Section flags */
+} PE_SECTION_HEADER;
+
+/**
+ * @brief ELF file header, widened so ELF32 and ELF64 share one layout
+ */
+typedef struct
+{
+    unsigned char e_ident[ELF_IDENT_SIZE]; /**< Magic, class, data encoding and version */
+    uint16_t e_type;                       /**< Object file type */
+    uint16_t e_machine;                    /**< Target architecture */
+    uint64_t e_entry;                      /**< Entry point virtual address */
+    uint64_t e_phoff;                      /**< Program header table offset */
+    uint64_t e_shoff;                      /**< Section header table offset */
+    uint16_t e_shentsize;                  /**< Size of one section header */
+    uint16_t e_shnum;                      /**< Number of section headers */
+    uint16_t e_shstrndx;                   /**< Index of the section name string table */
+} ELF_HEADER;
+
+/**
+ * @brief ELF section header, widened so ELF32 and ELF64 share one layout
+ */
+typedef struct
+{
+    uint32_t sh_name;   /**< Offset of the name in the section name string table */
+    uint32_t sh_type;   /**< Section type */
+    uint64_t sh_flags;  /**< Section flags */
+    uint64_t sh_addr;   /**< Virtual address in memory */
+    uint64_t sh_offset; /**< File offset of the section data */
+    uint64_t sh_size;   /**< Size of the section */
+} ELF_SECTION_HEADER;
+
+/**
+ * @brief Identifies the format of an executable from its magic bytes
+ *
+ * Reads the first bytes of the file and checks for the ELF magic (0x7F 'E' 'L' 'F') or the
+ * DOS signature followed by a PE signature. The file position is left unspecified.
+ *
+ * @param[in] FILE File to read from
+ *
+ * @return binary_format
+ */
+binary_format detect_binary_format(FILE *);
 
 /**
  * @brief Counts the total size of the DOS header.
@@ -55,11 +211,11 @@
  * The DOS header contains a signature e_magic(MZ) or 0x5A4D and an offset(e_lfanew) to the PE header. 
  * 
  * @param[in] FILE File to read from
- * @param[in] IMAGE_DOS_HEADER DOS header structure 
+ * @param[in] PE_DOS_HEADER DOS header structure 
  * 
  * @return int 
  */
-int _READ_DOS_HEADER(FILE *, IMAGE_DOS_HEADER *);
+int _READ_DOS_HEADER(FILE *, PE_DOS_HEADER *);
 
 /**
  * @brief Counts the total size of the PE header.
@@ -69,12 +225,11 @@ int _READ_DOS_HEADER(FILE *, IMAGE_DOS_HEADER *);
  * portable executable(PE). 
  * 
  * @param[in] FILE File to read from 
- * @param[in] DWORD peSignature
  * @param[in] long peOffset
  * 
  * @return int 
  */
-int _READ_PE_HEADER(FILE *, DWORD *, long);
+int _READ_PE_HEADER(FILE *, long);
 
 /**
  * @brief Counts the total size of the COFF file header
@@ -84,36 +239,32 @@ int _READ_PE_HEADER(FILE *, DWORD *, long);
  * how to handle the file and contents. 
  * 
  * @param[in] FILE File to read from
- * @param[in] IMAGE_FILE_HEADER FILE header structure
+ * @param[in] PE_FILE_HEADER FILE header structure
  * 
  * @return int 
  */
-int _READ_FILE_HEADER(FILE *, IMAGE_FILE_HEADER *);
+int _READ_FILE_HEADER(FILE *, PE_FILE_HEADER *);
 
 /**
  * @brief Counts the total size of the optional(OPT) header 
  * 
  * Contains essential data for loading and running the executable
  * Despite its name, this header is mandatory for executables. 
- * Inside, it contains:
+ * Only the standard fields common to PE32 and PE32+ are decoded; the file position is then
+ * moved past the whole optional header using SizeOfOptionalHeader so the section table can be read.
  * 
  * - Magic: Identifies the file type (e.g., PE32 for 32-bit, PE32+ for 64-bit).
  * - SizeOfCode: The size of the code (text) section(s), in bytes.
  * - SizeOfInitializedData: The size of the initialized data section(s), in bytes.
  * - AddressOfEntryPoint: The address where execution starts. This specifies the relative virtual address (RVA) of the entry point for the executable.
- * - ImageBase: The preferred load address in memory. Indicates the preferred base address of the image when loaded into memory.
- * - SectionAlignment: The alignment (in bytes) of sections when loaded into memory. This value must be greater than or equal to FileAlignment.
- * - FileAlignment: The alignment (in bytes) of sections within the PE file on disk.
- * - SizeOfImage: The total size of the image in memory, including all headers, sections, and padding.
- * - Subsystem: The required subsystem to run the executable, such as the Windows GUI or Windows CUI (console). Common values include IMAGE_SUBSYSTEM_WINDOWS_GUI and IMAGE_SUBSYSTEM_WINDOWS_CUI.
- * - NumberOfRvaAndSizes: The number of entries in the Data Directory. Each entry points to a specific table or structure used by the executable.
  * 
  * @param[in] FILE File to read from
- * @param[in] IMAGE_OPTIONAL_HEADER OPT header structure
+ * @param[in] PE_OPTIONAL_HEADER OPT header structure
+ * @param[in] uint16_t SizeOfOptionalHeader from the COFF file header
  * 
  * @return int 
  */
-int _READ_OPT_HEADER(FILE *, IMAGE_OPTIONAL_HEADER *);
+int _READ_OPT_HEADER(FILE *, PE_OPTIONAL_HEADER *, uint16_t);
 
 /**
  * @brief Counts the total size of the section header
@@ -125,63 +276,86 @@ int _READ_OPT_HEADER(FILE *, IMAGE_OPTIONAL_HEADER *);
  * Characteristics: Flags indicating the section's attributes (executable, writable, etc.)
  * 
  * @param[in] FILE File to read from
- * @param[in] IMAGE_SECTION_HEADER section header structure
+ * @param[in] PE_SECTION_HEADER section header structure
  * @param[in] NUMBER_OF_SECTIONS total number of sections
  * 
  * @return int 
  */
-int _READ_SECTION_HEADERS(FILE *, IMAGE_SECTION_HEADER *, int);
+int _READ_SECTION_HEADERS(FILE *, PE_SECTION_HEADER *, int);
 
 /**
- * @brief Calculates the total size of all headers within a PE file
+ * @brief Calculates the total size of all sections within a PE file
  * 
- * Takes the size of each header, adds it up, and returns it.
+ * Takes the size of each section, adds it up, and returns it.
  * 
- * @param[in] IMAGE_SECTION_HEADER Section header structure
+ * @param[in] PE_SECTION_HEADER Section header structure
  * @param[in] NUMBER_OF_SECTIONS total number of sections
  * 
  * @return size_t 
  */
-size_t calculate_total_header_size(const IMAGE_SECTION_HEADER *, int);
-
-#endif /* End of _WIN32 MACRO */
-
-#ifdef __linux__
-
-#include <elf.h>
+size_t calculate_total_header_size_pe(const PE_SECTION_HEADER *, int);
 
 /**
  * @brief Reads and calculates the total size of the executable linkable format(ELF) file
  * 
+ * Accepts both ELFCLASS32 and ELFCLASS64 files in either byte order.
+ * 
  * @param[in] FILE File to read from 
- * @param[in] Elf32_Ehdr ELF header structure
+ * @param[in] ELF_HEADER ELF header structure
  * 
  * @return int
  */
-int _READ_ELF_HEADER(FILE *, Elf32_Ehdr *);
+int _READ_ELF_HEADER(FILE *, ELF_HEADER *);
 
 /**
- * @brief Reads and calculates section headers specific to the Linux format ELF
+ * @brief Reads and calculates section headers of an ELF file
  * 
  * @param[in] FILE File to read from
- * @param[in] Elf32_Shdr ELF header structure
- * @param[in] int Section header count
- * @param[in] int Section header offset
+ * @param[in] ELF_HEADER ELF header the section table belongs to
+ * @param[in] ELF_SECTION_HEADER Section header structures to fill (e_shnum entries)
  * 
  * @return int
  */
-int _READ_SECTION_HEADERS_LINUX(FILE *, Elf32_Shdr *, int, int);
+int _READ_SECTION_HEADERS_ELF(FILE *, const ELF_HEADER *, ELF_SECTION_HEADER *);
 
 /**
- * @brief Calculates the total header size 
+ * @brief Calculates the total size of all sections within an ELF file
  * 
- * @param[in] Elf32_Shdr ELF header structure 
+ * @param[in] ELF_SECTION_HEADER Section header structures
  * @param[in] int Section header count
  * 
- * @return int
+ * @return size_t
  */
-size_t calculate_total_header_size(const Elf32_Shdr *, int);
+size_t calculate_total_header_size_elf(const ELF_SECTION_HEADER *, int);
 
-#endif /* End of __linux__ MACRO */
+/**
+ * @brief Reads the section name string table of an ELF file
+ *
+ * @param[in] FILE File to read from
+ * @param[in] ELF_HEADER ELF header giving the index of the string table
+ * @param[in] ELF_SECTION_HEADER Section header structures (e_shnum entries)
+ * @param[out] size_t Size of the returned table
+ *
+ * @return char* Table to be freed by the caller, NULL on failure
+ */
+char *_READ_SECTION_NAMES_ELF(FILE *, const ELF_HEADER *, const ELF_SECTION_HEADER *, size_t *);
+
+/**
+ * @brief Classifies an ELF section by its type and flags
+ *
+ * @param[in] ELF_SECTION_HEADER Section header
+ *
+ * @return section_class
+ */
+section_class classify_elf_section(const ELF_SECTION_HEADER *);
+
+/**
+ * @brief Classifies a PE section by its characteristics
+ *
+ * @param[in] PE_SECTION_HEADER Section header
+ *
+ * @return section_class
+ */
+section_class classify_pe_section(const PE_SECTION_HEADER *);
 
 #endif /* program_size_h */
\ No newline at end of file
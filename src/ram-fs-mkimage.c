@@ -0,0 +1,627 @@
+/**
+ * @file ram-fs-mkimage.c
+ * @brief Generates a constant, pre-linked RAM-FS image from a manifest
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+
+/* System includes */
+#include <ctype.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Local includes */
+#include "ram-fs.h"
+#include "ram-fs-zone.h"
+
+#define MKFS_MAX_LINE 4096
+#define MKFS_MAX_DIRS 256
+#define MKFS_MAX_FILES 1024
+
+/* Nodes in the order they are emitted; root and log_cache are dirs 0 and 1 */
+static Directory *dirs[MKFS_MAX_DIRS];
+static int num_dirs;
+static File *files[MKFS_MAX_FILES];
+static int num_files;
+
+static const char *manifest_path;
+static int manifest_line;
+
+static void usage(const char *program)
+{
+    fprintf(stderr,
+            "Usage: %s [-o output.c] [-I include-prefix] [-n symbol] manifest\n"
+            "  -o  Write the image source to a file instead of stdout\n"
+            "  -I  Prefix of the ram-fs-zone.h include, relative to the generated file (default none)\n"
+            "  -n  Name of the struct ram_fs_image to define (default ram_fs_image)\n"
+            "Manifest lines, paths starting at root or log_cache:\n"
+            "  dir    <path>\n"
+            "  file   <path> <AVAILABLE|PROTECTED|RESTRICTED> \"<initial content>\"\n"
+            "  record <path> \"<record framed with the marker>\"\n"
+            "Strings take \\n, \\t, \\r, \\\" and \\\\ escapes; # starts a comment.\n",
+            program);
+}
+
+static void fail(const char *message, const char *detail)
+{
+    fprintf(stderr, "lmkfs: %s:%d: %s%s%s\n", manifest_path, manifest_line, message, detail != NULL ? ": " : "",
+            detail != NULL ? detail : "");
+    exit(1);
+}
+
+/* Cuts the next whitespace separated word out of the line */
+static char *next_word(char **cursor)
+{
+    char *word = *cursor;
+
+    while (isspace((unsigned char)*word))
+    {
+        word++;
+    }
+    if (*word == '\0')
+    {
+        return NULL;
+    }
+    char *end = word;
+    while (*end != '\0' && !isspace((unsigned char)*end))
+    {
+        end++;
+    }
+    if (*end != '\0')
+    {
+        *end++ = '\0';
+    }
+    *cursor = end;
+    return word;
+}
+
+/* Decodes the quoted string that ends the line, in place */
+static char *quoted_string(char *cursor)
+{
+    while (isspace((unsigned char)*cursor))
+    {
+        cursor++;
+    }
+    if (*cursor != '"')
+    {
+        fail("expected a quoted string", NULL);
+    }
+
+    char *text = ++cursor;
+    char *out = text;
+    for (;;)
+    {
+        char c = *cursor++;
+        if (c == '\0')
+        {
+            fail("unterminated string", NULL);
+        }
+        if (c == '"')
+        {
+            break;
+        }
+        if (c == '\\')
+        {
+            c = *cursor++;
+            switch (c)
+            {
+            case 'n':
+                c = '\n';
+                break;
+            case 't':
+                c = '\t';
+                break;
+            case 'r':
+                c = '\r';
+                break;
+            case '"':
+            case '\\':
+                break;
+            default:
+                fail("unknown escape in string", NULL);
+            }
+        }
+        *out++ = c;
+    }
+    while (isspace((unsigned char)*cursor))
+    {
+        cursor++;
+    }
+    if (*cursor != '\0' && *cursor != '#')
+    {
+        fail("unexpected text after the string", cursor);
+    }
+    *out = '\0';
+    return text;
+}
+
+/* Splits a path into its parent directory and last name; the parent must exist */
+static Directory *parent_of(const char *path, const char **name)
+{
+    char component[MAX_FILENAME_LENGTH];
+    Directory *dir = NULL;
+    const char *start = path;
+
+    for (;;)
+    {
+        const char *slash = strchr(start, '/');
+        if (slash == NULL)
+        {
+            break;
+        }
+        size_t length = (size_t)(slash - start);
+        if (length == 0 || length >= sizeof(component))
+        {
+            fail("bad path", path);
+        }
+        memcpy(component, start, length);
+        component[length] = '\0';
+
+        if (dir == NULL)
+        {
+            if (strcmp(component, "root") == 0)
+            {
+                dir = root_dir;
+            }
+            else if (strcmp(component, "log_cache") == 0)
+            {
+                dir = log_cache;
+            }
+            else
+            {
+                fail("paths start at root or log_cache", path);
+            }
+        }
+        else
+        {
+            Directory *below = NULL;
+            for (int i = 0; i < dir->num_subdirs && below == NULL; i++)
+            {
+                if (strcmp(dir->subdirs[i]->name, component) == 0)
+                {
+                    below = dir->subdirs[i];
+                }
+            }
+            if (below == NULL)
+            {
+                fail("no such directory", component);
+            }
+            dir = below;
+        }
+        start = slash + 1;
+    }
+    if (dir == NULL || *start == '\0' || strlen(start) >= MAX_FILENAME_LENGTH)
+    {
+        fail("bad path", path);
+    }
+    *name = start;
+    return dir;
+}
+
+static int name_taken(const Directory *dir, const char *name)
+{
+    for (int i = 0; i < dir->num_files; i++)
+    {
+        if (strcmp(dir->files[i]->name, name) == 0)
+        {
+            return 1;
+        }
+    }
+    for (int i = 0; i < dir->num_subdirs; i++)
+    {
+        if (strcmp(dir->subdirs[i]->name, name) == 0)
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static File *find_file(const char *path)
+{
+    const char *name;
+    Directory *dir = parent_of(path, &name);
+
+    for (int i = 0; i < dir->num_files; i++)
+    {
+        if (strcmp(dir->files[i]->name, name) == 0)
+        {
+            return dir->files[i];
+        }
+    }
+    fail("no such file", path);
+    return NULL;
+}
+
+static void add_dir(const char *path)
+{
+    const char *name;
+    Directory *parent = parent_of(path, &name);
+
+    if (name_taken(parent, name))
+    {
+        fail("name already in use", path);
+    }
+    if (parent->num_subdirs >= MAX_DIRS || num_dirs >= MKFS_MAX_DIRS)
+    {
+        fail("too many directories", path);
+    }
+    Directory *dir = create_directory(name);
+    parent->subdirs[parent->num_subdirs++] = dir;
+    dirs[num_dirs++] = dir;
+}
+
+static void add_file(const char *path, const char *permissions, const char *content)
+{
+    static const char *const names[] = {"AVAILABLE", "PROTECTED", "RESTRICTED"};
+    static const file_permissions values[] = {AVAILABLE, PROTECTED, RESTRICTED};
+    const char *name;
+    Directory *parent = parent_of(path, &name);
+    int kind = -1;
+
+    for (int i = 0; i < 3; i++)
+    {
+        if (strcmp(permissions, names[i]) == 0)
+        {
+            kind = i;
+        }
+    }
+    if (kind == -1)
+    {
+        fail("unknown permissions", permissions);
+    }
+    if (name_taken(parent, name))
+    {
+        fail("name already in use", path);
+    }
+    if (strlen(content) >= MAX_FILE_CONTENT_LENGTH - 1)
+    {
+        fail("content too long", path);
+    }
+    if (parent->num_files >= MAX_FILES || num_files >= MKFS_MAX_FILES)
+    {
+        fail("too many files", path);
+    }
+
+    /* Built exactly as create_file() would at runtime, newline included */
+    File *file = create_file(name, content, values[kind]);
+    append_to_dir(parent, file);
+    files[num_files++] = file;
+}
+
+static void add_record(const char *path, const char *record)
+{
+    File *file = find_file(path);
+
+    /* Restricted files only take records here, at build time */
+    file_permissions permissions = file->permissions;
+    file->permissions = AVAILABLE;
+    int result = insert_marker(file, record);
+    file->permissions = permissions;
+    if (result == -1)
+    {
+        fail("record does not fit or contains the marker", path);
+    }
+}
+
+static void read_manifest(FILE *input)
+{
+    char line[MKFS_MAX_LINE];
+
+    while (fgets(line, sizeof(line), input) != NULL)
+    {
+        manifest_line++;
+        if (strchr(line, '\n') == NULL && !feof(input))
+        {
+            fail("line too long", NULL);
+        }
+
+        char *cursor = line;
+        char *keyword = next_word(&cursor);
+        if (keyword == NULL || keyword[0] == '#')
+        {
+            continue;
+        }
+        char *path = next_word(&cursor);
+        if (path == NULL)
+        {
+            fail("missing path", keyword);
+        }
+
+        if (strcmp(keyword, "dir") == 0)
+        {
+            char *extra = next_word(&cursor);
+            if (extra != NULL && extra[0] != '#')
+            {
+                fail("unexpected text after the path", extra);
+            }
+            add_dir(path);
+        }
+        else if (strcmp(keyword, "file") == 0)
+        {
+            char *permissions = next_word(&cursor);
+            if (permissions == NULL)
+            {
+                fail("missing permissions", path);
+            }
+            add_file(path, permissions, quoted_string(cursor));
+        }
+        else if (strcmp(keyword, "record") == 0)
+        {
+            add_record(path, quoted_string(cursor));
+        }
+        else
+        {
+            fail("unknown keyword", keyword);
+        }
+    }
+}
+
+/* Writes bytes as one C string literal, split over lines; octal escapes are always three digits */
+static void emit_string(FILE *out, const char *data, size_t length, const char *indent)
+{
+    size_t column = 0;
+
+    fputc('"', out);
+    for (size_t i = 0; i < length; i++)
+    {
+        unsigned char c = (unsigned char)data[i];
+        if (column >= 72)
+        {
+            fprintf(out, "\"\n%s\"", indent);
+            column = 0;
+        }
+        if (c == '"' || c == '\\' || c == '?')
+        {
+            column += (size_t)fprintf(out, "\\%c", c);
+        }
+        else if (c == '\n')
+        {
+            column += (size_t)fprintf(out, "\\n");
+        }
+        else if (c >= 0x20 && c < 0x7f)
+        {
+            fputc(c, out);
+            column++;
+        }
+        else
+        {
+            column += (size_t)fprintf(out, "\\%03o", c);
+        }
+    }
+    fputc('"', out);
+}
+
+static int dir_number(const Directory *dir)
+{
+    for (int i = 0; i < num_dirs; i++)
+    {
+        if (dirs[i] == dir)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int file_number(const File *file)
+{
+    for (int i = 0; i < num_files; i++)
+    {
+        if (files[i] == file)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void emit_indexes(FILE *out)
+{
+    fprintf(out, "static const RecordIndex image_indexes[%d] RAM_FS_IMAGE = {\n", num_files > 0 ? num_files : 1);
+    for (int i = 0; i < num_files; i++)
+    {
+        const RecordIndex *index = files[i]->index;
+        fprintf(out, "    {.scanned = %u, .num_records = %u", (unsigned)index->scanned, (unsigned)index->num_records);
+        for (int record = 0; record < index->num_records; record++)
+        {
+            fprintf(out, "%s{%u, %u}", record > 0 ? ", " : ", .records = {", (unsigned)index->records[record].offset,
+                    (unsigned)index->records[record].length);
+        }
+        fprintf(out, "%s},\n", index->num_records > 0 ? "}" : "");
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static const struct zone_map image_zones[%d] RAM_FS_IMAGE = {\n", num_files > 0 ? num_files : 1);
+    for (int i = 0; i < num_files; i++)
+    {
+        const struct zone_map *map = files[i]->zones;
+        fprintf(out, "    {.covered_records = %u, .num_zones = %u", (unsigned)map->covered_records,
+                (unsigned)map->num_zones);
+        for (int zone = 0; zone < map->num_zones; zone++)
+        {
+            const Zone *entry = &map->zones[zone];
+            fprintf(out, "%s{", zone > 0 ? ", " : ", .zones = {");
+            if (entry->min_timestamp == UINT64_MAX)
+            {
+                fprintf(out, "UINT64_MAX, ");
+            }
+            else
+            {
+                fprintf(out, "UINT64_C(%" PRIu64 "), ", entry->min_timestamp);
+            }
+            fprintf(out, "UINT64_C(%" PRIu64 "), 0x%02x}", entry->max_timestamp, (unsigned)entry->levels);
+        }
+        fprintf(out, "%s},\n", map->num_zones > 0 ? "}" : "");
+    }
+    fprintf(out, "};\n\n");
+}
+
+static void emit_files(FILE *out)
+{
+    static const char *const permissions[] = {"", "AVAILABLE", "PROTECTED", "RESTRICTED"};
+
+    fprintf(out, "static const File image_files[%d] RAM_FS_IMAGE = {\n", num_files > 0 ? num_files : 1);
+    for (int i = 0; i < num_files; i++)
+    {
+        const File *file = files[i];
+        fprintf(out, "    {\n        .name = ");
+        emit_string(out, file->name, strlen(file->name), "                ");
+        fprintf(out, ",\n        .content = ");
+        emit_string(out, file->content, (size_t)file->size, "                   ");
+        fprintf(out, ",\n        .size = %d,\n        .permissions = %s,\n", file->size, permissions[file->permissions]);
+        fprintf(out, "        .index = (RecordIndex *)&image_indexes[%d],\n", i);
+        fprintf(out, "        .zones = (struct zone_map *)&image_zones[%d],\n    },\n", i);
+    }
+    fprintf(out, "};\n\n");
+}
+
+static void emit_dirs(FILE *out)
+{
+    fprintf(out, "static const Directory image_dirs[%d] RAM_FS_IMAGE = {\n", num_dirs);
+    for (int i = 0; i < num_dirs; i++)
+    {
+        const Directory *dir = dirs[i];
+        fprintf(out, "    {\n        .name = ");
+        emit_string(out, dir->name, strlen(dir->name), "                ");
+        fprintf(out, ",\n        .num_files = %d,\n", dir->num_files);
+        for (int file = 0; file < dir->num_files; file++)
+        {
+            fprintf(out, "%s(File *)&image_files[%d]", file > 0 ? ", " : "        .files = {",
+                    file_number(dir->files[file]));
+        }
+        fprintf(out, "%s        .num_subdirs = %d,\n", dir->num_files > 0 ? "},\n" : "", dir->num_subdirs);
+        for (int subdir = 0; subdir < dir->num_subdirs; subdir++)
+        {
+            fprintf(out, "%s(Directory *)&image_dirs[%d]", subdir > 0 ? ", " : "        .subdirs = {",
+                    dir_number(dir->subdirs[subdir]));
+        }
+        fprintf(out, "%s    },\n", dir->num_subdirs > 0 ? "},\n" : "");
+    }
+    fprintf(out, "};\n\n");
+}
+
+static void emit_image(FILE *out, const char *include_prefix, const char *symbol)
+{
+    size_t bytes = (size_t)num_dirs * sizeof(Directory) +
+                   (size_t)num_files * (sizeof(File) + sizeof(RecordIndex) + sizeof(struct zone_map));
+
+    fprintf(out, "/* RAM-FS image generated by lmkfs from %s; do not edit. */\n", manifest_path);
+    fprintf(out, "/* %d directories and %d files, %zu bytes of constant data */\n\n", num_dirs, num_files, bytes);
+    fprintf(out, "#include <stdint.h>\n\n#include \"%sram-fs-zone.h\"\n\n", include_prefix);
+    emit_indexes(out);
+    emit_files(out);
+    emit_dirs(out);
+    fprintf(out, "/* Promoted copies, filled in as the image is written */\n");
+    fprintf(out, "static File *promoted_files[%d];\n", num_files > 0 ? num_files : 1);
+    fprintf(out, "static Directory *promoted_dirs[%d];\n\n", num_dirs);
+    fprintf(out, "const struct ram_fs_image %s = {\n", symbol);
+    fprintf(out, "    .files = image_files,\n    .promoted_files = promoted_files,\n    .num_files = %d,\n", num_files);
+    fprintf(out, "    .dirs = image_dirs,\n    .promoted_dirs = promoted_dirs,\n    .num_dirs = %d,\n};\n", num_dirs);
+}
+
+int main(int argc, char **argv)
+{
+    const char *output = NULL;
+    const char *include_prefix = "";
+    const char *symbol = "ram_fs_image";
+    int option;
+
+    while ((option = getopt(argc, argv, "o:I:n:h")) != -1)
+    {
+        switch (option)
+        {
+        case 'o':
+            output = optarg;
+            break;
+        case 'I':
+            include_prefix = optarg;
+            break;
+        case 'n':
+            symbol = optarg;
+            break;
+        default:
+            usage(argv[0]);
+            return option == 'h' ? 0 : 1;
+        }
+    }
+    if (optind != argc - 1)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    manifest_path = argv[optind];
+    FILE *input = fopen(manifest_path, "r");
+    if (input == NULL)
+    {
+        fprintf(stderr, "lmkfs: could not open %s\n", manifest_path);
+        return 1;
+    }
+
+    /* The tree is built with the RAM-FS functions themselves, so the image matches a runtime build */
+    root_dir = create_directory("root");
+    log_cache = create_directory("log_cache");
+    dirs[num_dirs++] = root_dir;
+    dirs[num_dirs++] = log_cache;
+    read_manifest(input);
+    fclose(input);
+
+    /* Index every file now, so reading an unwritten image file never has to change it */
+    for (int i = 0; i < num_files; i++)
+    {
+        if (zone_map_update(files[i]) == -1)
+        {
+            return 1;
+        }
+    }
+
+    FILE *out = output != NULL ? fopen(output, "w") : stdout;
+    if (out == NULL)
+    {
+        fprintf(stderr, "lmkfs: could not create %s\n", output);
+        return 1;
+    }
+    emit_image(out, include_prefix, symbol);
+    if (out != stdout && fclose(out) != 0)
+    {
+        fprintf(stderr, "lmkfs: could not write %s\n", output);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,475 @@
+/**
+ * @file ram-fs-search.c
+ * @brief RAM-FS record search definitions
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifdef __linux__
+#define _GNU_SOURCE
+#endif
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+
+#include <pthread.h>
+
+#endif
+
+/* Local includes */
+#include "common/logger.h"
+#include "cpu-topology.h"
+#include "log-kernels.h"
+#include "ram-fs-search.h"
+
+/* Everything one search needs, shared read-only by the workers */
+struct search_job
+{
+    const struct ram_fs_query *query;
+    const char *pattern; /* query->pattern, or "" to match every record */
+    size_t pattern_length;
+    size_t level_length;
+    char module_tag[MAX_MODULE_NAME_LENGTH + 2]; /* "<module>:" */
+    size_t module_tag_length;
+    ram_fs_match_callback callback;
+    void *context;
+    File **files;
+    int num_files;
+    struct ram_fs_snapshot *snapshot; /* NULL searches the live tree */
+    int lost;                         /* A file could not be read as of the snapshot */
+#ifdef __linux__
+    int next_file; /* Claimed with an atomic increment */
+    pthread_mutex_t callback_lock;
+#endif
+};
+
+/* Counts of a directory in the searched view; -1 if it is not part of the snapshot */
+static int dir_counts(struct search_job *job, Directory *dir, int *num_files, int *num_subdirs)
+{
+    if (job->snapshot != NULL)
+    {
+        return ram_fs_snapshot_dir(job->snapshot, dir, num_files, num_subdirs);
+    }
+    dir = ram_fs_dir(dir);
+    *num_files = dir->num_files;
+    *num_subdirs = dir->num_subdirs;
+    return 0;
+}
+
+static int count_files(struct search_job *job, Directory *dir)
+{
+    int num_files;
+    int num_subdirs;
+
+    if (dir_counts(job, dir, &num_files, &num_subdirs) == -1)
+    {
+        return -1;
+    }
+    dir = ram_fs_dir(dir);
+    int count = num_files;
+    for (int i = 0; i < num_subdirs; i++)
+    {
+        int below = count_files(job, dir->subdirs[i]);
+        if (below == -1)
+        {
+            return -1;
+        }
+        count += below;
+    }
+    return count;
+}
+
+static int collect_files(struct search_job *job, Directory *dir, int count, size_t *bytes)
+{
+    int num_files;
+    int num_subdirs;
+
+    dir_counts(job, dir, &num_files, &num_subdirs); /* Frozen by count_files() already */
+    dir = ram_fs_dir(dir);
+    for (int i = 0; i < num_files; i++)
+    {
+        long size = job->snapshot != NULL ? ram_fs_snapshot_file(job->snapshot, dir->files[i])
+                                          : ram_fs_file(dir->files[i])->size;
+        job->files[count++] = dir->files[i];
+        *bytes += size > 0 ? (size_t)size : 0;
+    }
+    for (int i = 0; i < num_subdirs; i++)
+    {
+        count = collect_files(job, dir->subdirs[i], count, bytes);
+    }
+    return count;
+}
+
+static int record_passes(const struct search_job *job, const char *record, size_t length)
+{
+    if (job->level_length > 0 &&
+        (length < job->level_length || memcmp(record, job->query->level, job->level_length) != 0))
+    {
+        return 0;
+    }
+    if (job->module_tag_length > 0 &&
+        log_kernels->find_pattern(record, length, job->module_tag, job->module_tag_length) == length)
+    {
+        return 0;
+    }
+    return 1;
+}
+
+static void report(struct search_job *job, const File *file, const char *record, size_t length)
+{
+#ifdef __linux__
+    pthread_mutex_lock(&job->callback_lock);
+    job->callback(file, record, length, job->context);
+    pthread_mutex_unlock(&job->callback_lock);
+#else
+    job->callback(file, record, length, job->context);
+#endif
+}
+
+/* Finds the record holding offset; returns 0 when the offset is outside every record */
+static int locate_record(const char *content, size_t size, const RecordIndex *index, size_t offset, size_t span,
+                         size_t *start, size_t *end)
+{
+    if (index != NULL && index->num_records > 0)
+    {
+        int low = 0;
+        int high = index->num_records - 1;
+
+        /* Last record starting at or before offset */
+        while (low < high)
+        {
+            int middle = (low + high + 1) / 2;
+            if (index->records[middle].offset <= offset)
+            {
+                low = middle;
+            }
+            else
+            {
+                high = middle - 1;
+            }
+        }
+
+        const RecordSpan *record = &index->records[low];
+        if (offset < record->offset || offset + span > (size_t)record->offset + record->length)
+        {
+            return 0;
+        }
+        *start = record->offset;
+        *end = (size_t)record->offset + record->length;
+        return 1;
+    }
+
+    /* Unframed file: the line is the record */
+    size_t first = offset;
+    while (first > 0 && content[first - 1] != '\n')
+    {
+        first--;
+    }
+    const char *newline = memchr(content + offset, '\n', size - offset);
+    *start = first;
+    *end = newline == NULL ? size : (size_t)(newline - content) + 1;
+    return 1;
+}
+
+static long search_file(struct search_job *job, File *file)
+{
+    file = ram_fs_file(file);
+    const char *content = file->content;
+    const RecordIndex *index;
+    RecordIndex frozen;
+    size_t size;
+    size_t position = 0;
+    long matches = 0;
+
+    if (job->snapshot != NULL)
+    {
+        /* The file's own index belongs to the writers; the snapshot's records are indexed here */
+        long length = ram_fs_snapshot_index(job->snapshot, file, &frozen);
+        if (length == -1)
+        {
+            job->lost = 1;
+            return 0;
+        }
+        size = (size_t)length;
+        index = &frozen;
+    }
+    else
+    {
+        identify_marker(file);
+        size = (size_t)file->size;
+        index = file->index;
+    }
+
+    while (position < size)
+    {
+        size_t hit = position + log_kernels->find_pattern(content + position, size - position,
+                                                          job->pattern, job->pattern_length);
+        if (hit >= size)
+        {
+            break;
+        }
+
+        size_t start;
+        size_t end;
+        if (!locate_record(content, size, index, hit, job->pattern_length, &start, &end))
+        {
+            position = hit + 1;
+            continue;
+        }
+
+        if (record_passes(job, content + start, end - start))
+        {
+            report(job, file, content + start, end - start);
+            matches++;
+        }
+
+        /* One report per record, and an empty pattern must still make progress */
+        position = end > hit ? end : hit + 1;
+        if (index != NULL && index->num_records > 0)
+        {
+            position += MARKER_LENGTH;
+        }
+    }
+    return matches;
+}
+
+#ifdef __linux__
+
+struct search_worker
+{
+    pthread_t thread;
+    struct search_job *job;
+    long matches;
+};
+
+static void *search_worker_main(void *arg)
+{
+    struct search_worker *worker = arg;
+    struct search_job *job = worker->job;
+
+    for (;;)
+    {
+        int file = __atomic_fetch_add(&job->next_file, 1, __ATOMIC_RELAXED);
+        if (file >= job->num_files)
+        {
+            break;
+        }
+        worker->matches += search_file(job, job->files[file]);
+    }
+    return NULL;
+}
+
+static long search_parallel(struct search_job *job, size_t bytes)
+{
+    struct search_worker workers[RAM_FS_SEARCH_MAX_THREADS];
+    int num_threads = 1;
+
+    if (bytes >= RAM_FS_SEARCH_PARALLEL_BYTES)
+    {
+        num_threads = get_cpu_topology()->logical_cpus;
+        if (num_threads > RAM_FS_SEARCH_MAX_THREADS)
+        {
+            num_threads = RAM_FS_SEARCH_MAX_THREADS;
+        }
+        if (num_threads > job->num_files)
+        {
+            num_threads = job->num_files;
+        }
+    }
+
+    job->next_file = 0;
+
+    /* Worker 0 is the calling thread */
+    int started = 1;
+    for (int i = 0; i < num_threads; i++)
+    {
+        workers[i].job = job;
+        workers[i].matches = 0;
+    }
+    for (; started < num_threads; started++)
+    {
+        if (pthread_create(&workers[started].thread, NULL, search_worker_main, &workers[started]) != 0)
+        {
+            break;
+        }
+    }
+    search_worker_main(&workers[0]);
+
+    long matches = workers[0].matches;
+    for (int i = 1; i < started; i++)
+    {
+        pthread_join(workers[i].thread, NULL);
+        matches += workers[i].matches;
+    }
+    return matches;
+}
+
+#endif /* __linux__ */
+
+static long search(struct ram_fs_snapshot *snapshot, Directory *dir, const struct ram_fs_query *query,
+                   ram_fs_match_callback callback, void *context)
+{
+    struct search_job job;
+    Directory *tops[2];
+    int num_tops = 0;
+
+    if (query == NULL || callback == NULL)
+    {
+        fprintf(stderr, "Search query or callback missing.\n");
+        return -1;
+    }
+    if (dir != NULL)
+    {
+        tops[num_tops++] = dir;
+    }
+    else
+    {
+        if (root_dir != NULL)
+        {
+            tops[num_tops++] = root_dir;
+        }
+        if (log_cache != NULL)
+        {
+            tops[num_tops++] = log_cache;
+        }
+    }
+
+    job.query = query;
+    job.pattern = query->pattern == NULL ? "" : query->pattern;
+    job.pattern_length = strlen(job.pattern);
+    job.level_length = query->level == NULL ? 0 : strlen(query->level);
+    job.module_tag_length = 0;
+    job.callback = callback;
+    job.context = context;
+    job.snapshot = snapshot;
+    job.lost = 0;
+    if (query->module != NULL && query->module[0] != '\0')
+    {
+        job.module_tag_length = (size_t)snprintf(job.module_tag, sizeof(job.module_tag), "%s:", query->module);
+        if (job.module_tag_length >= sizeof(job.module_tag))
+        {
+            fprintf(stderr, "Module name too long.\n");
+            return -1;
+        }
+    }
+    int capacity = 0;
+    for (int i = 0; i < num_tops; i++)
+    {
+        int count = count_files(&job, tops[i]);
+        if (count == -1)
+        {
+            fprintf(stderr, "Directory not in the snapshot, or the snapshot was lost.\n");
+            return -1;
+        }
+        capacity += count;
+    }
+    if (capacity == 0)
+    {
+        return 0;
+    }
+
+    /* A reserved file system has its file list reserved too and searches on the calling thread */
+    int reserved = ram_fs_reserved();
+    if (reserved)
+    {
+        int reserved_capacity;
+        job.files = ram_fs_file_list(&reserved_capacity);
+        if (capacity > reserved_capacity)
+        {
+            fprintf(stderr, "More files than reserved.\n");
+            return -1;
+        }
+    }
+    else
+    {
+        job.files = (File **)malloc((size_t)capacity * sizeof(File *));
+    }
+    if (job.files == NULL)
+    {
+        fprintf(stderr, "Memory allocation failed.\n");
+        return -1;
+    }
+
+    size_t bytes = 0;
+    job.num_files = 0;
+    for (int i = 0; i < num_tops; i++)
+    {
+        job.num_files = collect_files(&job, tops[i], job.num_files, &bytes);
+    }
+
+    long matches = 0;
+#ifdef __linux__
+    /* report() takes the lock on the sequential path too */
+    pthread_mutex_init(&job.callback_lock, NULL);
+    if (!reserved)
+    {
+        matches = search_parallel(&job, bytes);
+    }
+    else
+#endif
+    {
+        for (int i = 0; i < job.num_files; i++)
+        {
+            matches += search_file(&job, job.files[i]);
+        }
+    }
+#ifdef __linux__
+    pthread_mutex_destroy(&job.callback_lock);
+#endif
+
+    if (!reserved)
+    {
+        free(job.files);
+    }
+    return job.lost ? -1 : matches;
+}
+
+long ram_fs_search(Directory *dir, const struct ram_fs_query *query, ram_fs_match_callback callback, void *context)
+{
+    return search(NULL, dir, query, callback, context);
+}
+
+long ram_fs_search_snapshot(struct ram_fs_snapshot *snapshot, Directory *dir, const struct ram_fs_query *query,
+                            ram_fs_match_callback callback, void *context)
+{
+    if (snapshot == NULL)
+    {
+        fprintf(stderr, "Snapshot not found.\n");
+        return -1;
+    }
+    return search(snapshot, dir, query, callback, context);
+}
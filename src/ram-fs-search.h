@@ -0,0 +1,106 @@
+/**
+ * @file ram-fs-search.h
+ * @brief RAM-FS record search declarations
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ram_fs_search_h_
+#define ram_fs_search_h_
+
+#include <stddef.h>
+
+#include "ram-fs.h"
+
+#define RAM_FS_SEARCH_MAX_THREADS 16
+#define RAM_FS_SEARCH_PARALLEL_BYTES (64 * 1024) /* Smaller trees are searched on the calling thread */
+
+/**
+ * @brief What to look for
+ *
+ * A record matches when it contains pattern and passes every filter that is set.
+ */
+struct ram_fs_query
+{
+    const char *pattern; /**< Substring to find; NULL or "" matches every record */
+    const char *level;   /**< Optional level label the record starts with, e.g. "CRITICAL" */
+    const char *module;  /**< Optional module name; the record must contain "<module>:" */
+};
+
+/**
+ * @brief Receives one matching record
+ *
+ * Calls are serialized, so the callback does not need to be thread safe. Records of one file arrive
+ * in file order; files may arrive in any order.
+ *
+ * @param[in] file    File holding the record
+ * @param[in] record  Start of the record inside file->content, not NUL terminated
+ * @param[in] length  Record length
+ * @param[in] context Pointer passed to ram_fs_search()
+ */
+typedef void (*ram_fs_match_callback)(const File *file, const char *record, size_t length, void *context);
+
+/**
+ * @brief Searches the records of every file below a directory
+ *
+ * Files framed with insert_marker() are searched record by record using their index; other files
+ * are searched line by line. The pattern is located with the log_kernels SIMD substring search, and
+ * only records that contain a hit are checked against the filters. On Linux, trees larger than
+ * RAM_FS_SEARCH_PARALLEL_BYTES are split across one thread per online CPU, unless ram_fs_reserve()
+ * is in effect: a reserved file system is searched on the calling thread without allocating.
+ *
+ * @param[in] dir      Directory to walk, including its subdirs; NULL walks root_dir and log_cache
+ * @param[in] query    Pattern and filters
+ * @param[in] callback Called for each match
+ * @param[in] context  Passed through to the callback
+ * @return long Number of matching records, -1 for failure
+ */
+RAM_FS long ram_fs_search(Directory *dir, const struct ram_fs_query *query, ram_fs_match_callback callback, void *context);
+
+/**
+ * @brief Searches a directory as it was when a snapshot was taken
+ *
+ * Works like ram_fs_search() on the files, sizes and records of the snapshot, while writers keep
+ * appending to the live tree. The records of each file are located in the snapshot's content
+ * rather than through the file's own index.
+ *
+ * @param[in] snapshot Snapshot from ram_fs_snapshot()
+ * @param[in] dir      Directory to walk, including its subdirs; NULL walks root_dir and log_cache
+ * @param[in] query    Pattern and filters
+ * @param[in] callback Called for each match
+ * @param[in] context  Passed through to the callback
+ * @return long Number of matching records, -1 for failure or a lost snapshot
+ */
+RAM_FS long ram_fs_search_snapshot(struct ram_fs_snapshot *snapshot, Directory *dir, const struct ram_fs_query *query,
+                                   ram_fs_match_callback callback, void *context);
+
+#endif /* ram_fs_search_h_ */
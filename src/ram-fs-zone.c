@@ -0,0 +1,269 @@
+/**
+ * @file ram-fs-zone.c
+ * @brief RAM-FS time and level zone map definitions
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* System includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Local includes */
+#include "log-kernels.h"
+#include "ram-fs-zone.h"
+
+/* Plain labels; RAM-FS content never carries color codes */
+static const char *const level_names[LOG_LEVEL_COUNT] = {"MESSAGE", "WARNING", "CRITICAL"};
+
+/* Splits "<timestamp> <LEVEL> <message>"; returns -1 for records in any other format */
+static int parse_record(const char *record, size_t length, uint64_t *timestamp, enum log_level *level,
+                        const char **message, size_t *message_length)
+{
+    size_t i = 0;
+    uint64_t value = 0;
+
+    while (i < length && record[i] >= '0' && record[i] <= '9')
+    {
+        value = value * 10 + (uint64_t)(record[i] - '0');
+        i++;
+    }
+    if (i == 0 || i == length || record[i] != ' ')
+    {
+        return -1;
+    }
+    i++;
+
+    for (int candidate = 0; candidate < LOG_LEVEL_COUNT; candidate++)
+    {
+        size_t name_length = strlen(level_names[candidate]);
+        if (length - i > name_length && memcmp(record + i, level_names[candidate], name_length) == 0 &&
+            record[i + name_length] == ' ')
+        {
+            *timestamp = value;
+            *level = (enum log_level)candidate;
+            *message = record + i + name_length + 1;
+            *message_length = length - i - name_length - 1;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+int zone_map_update(File *file)
+{
+    if (file == NULL)
+    {
+        fprintf(stderr, "File not found.\n");
+        return -1;
+    }
+    /* Files of an image come with their zones, so an unwritten one is never changed here */
+    file = ram_fs_file(file);
+    if (identify_marker(file) == -1)
+    {
+        return -1;
+    }
+
+    struct zone_map *map = file->zones;
+    if (map == NULL)
+    {
+        map = (struct zone_map *)ram_fs_alloc(RAM_FS_OBJECT_ZONE_MAP);
+        if (map == NULL)
+        {
+            fprintf(stderr, "Memory allocation failed.\n");
+            return -1;
+        }
+        map->covered_records = 0;
+        map->num_zones = 0;
+        file->zones = map;
+    }
+
+    const RecordIndex *index = file->index;
+    for (int record = map->covered_records; record < index->num_records; record++)
+    {
+        int zone_number = record / ZONE_MAP_BLOCK_RECORDS;
+        Zone *zone = &map->zones[zone_number];
+        if (zone_number == map->num_zones)
+        {
+            zone->min_timestamp = UINT64_MAX;
+            zone->max_timestamp = 0;
+            zone->levels = 0;
+            map->num_zones++;
+        }
+
+        const RecordSpan *span = &index->records[record];
+        uint64_t timestamp;
+        enum log_level level;
+        const char *message;
+        size_t message_length;
+        if (parse_record(file->content + span->offset, span->length, &timestamp, &level, &message,
+                         &message_length) == 0)
+        {
+            if (timestamp < zone->min_timestamp)
+            {
+                zone->min_timestamp = timestamp;
+            }
+            if (timestamp > zone->max_timestamp)
+            {
+                zone->max_timestamp = timestamp;
+            }
+            zone->levels |= (uint8_t)LOG_LEVEL_BIT(level);
+        }
+    }
+    if (map->covered_records != index->num_records)
+    {
+        map->covered_records = index->num_records;
+    }
+    return 0;
+}
+
+int append_log_record(File *file, enum log_level level, uint64_t timestamp, const char *message)
+{
+    char record[MAX_FILE_CONTENT_LENGTH];
+
+    if (file == NULL || message == NULL || (unsigned)level >= LOG_LEVEL_COUNT)
+    {
+        fprintf(stderr, "Invalid log record.\n");
+        return -1;
+    }
+
+    /* Index first, so insert_marker() extends an up to date index instead of leaving a rescan */
+    if (zone_map_update(file) == -1)
+    {
+        return -1;
+    }
+
+    size_t name_length = strlen(level_names[level]);
+    size_t message_length = strlen(message);
+    if (LOG_U64_MAX_DIGITS + name_length + message_length + 3 > sizeof(record))
+    {
+        return -1;
+    }
+
+    size_t length = log_kernels->format_u64(record, timestamp);
+    record[length++] = ' ';
+    memcpy(record + length, level_names[level], name_length);
+    length += name_length;
+    record[length++] = ' ';
+    memcpy(record + length, message, message_length + 1);
+
+    if (insert_marker(file, record) == -1)
+    {
+        return -1;
+    }
+    return zone_map_update(file);
+}
+
+long query_log_records(File *file, uint64_t from, uint64_t to, unsigned level_mask,
+                       log_record_callback callback, void *context)
+{
+    long reported = 0;
+
+    if (callback == NULL || zone_map_update(file) == -1)
+    {
+        return -1;
+    }
+    file = ram_fs_file(file);
+
+    const struct zone_map *map = file->zones;
+    const RecordIndex *index = file->index;
+    for (int zone_number = 0; zone_number < map->num_zones; zone_number++)
+    {
+        const Zone *zone = &map->zones[zone_number];
+        if (zone->max_timestamp < from || zone->min_timestamp > to || (zone->levels & level_mask) == 0)
+        {
+            continue;
+        }
+
+        int first = zone_number * ZONE_MAP_BLOCK_RECORDS;
+        int last = first + ZONE_MAP_BLOCK_RECORDS;
+        if (last > index->num_records)
+        {
+            last = index->num_records;
+        }
+        for (int record = first; record < last; record++)
+        {
+            const RecordSpan *span = &index->records[record];
+            uint64_t timestamp;
+            enum log_level level;
+            const char *message;
+            size_t message_length;
+            if (parse_record(file->content + span->offset, span->length, &timestamp, &level, &message,
+                             &message_length) == 0 &&
+                timestamp >= from && timestamp <= to && (LOG_LEVEL_BIT(level) & level_mask) != 0)
+            {
+                callback(file, timestamp, level, message, message_length, context);
+                reported++;
+            }
+        }
+    }
+    return reported;
+}
+
+static long query_dir(Directory *dir, uint64_t from, uint64_t to, unsigned level_mask,
+                      log_record_callback callback, void *context)
+{
+    long reported = 0;
+
+    dir = ram_fs_dir(dir);
+    for (int i = 0; i < dir->num_files; i++)
+    {
+        long count = query_log_records(dir->files[i], from, to, level_mask, callback, context);
+        if (count == -1)
+        {
+            return -1;
+        }
+        reported += count;
+    }
+    for (int i = 0; i < dir->num_subdirs; i++)
+    {
+        long count = query_dir(dir->subdirs[i], from, to, level_mask, callback, context);
+        if (count == -1)
+        {
+            return -1;
+        }
+        reported += count;
+    }
+    return reported;
+}
+
+long query_log_cache(uint64_t from, uint64_t to, unsigned level_mask, log_record_callback callback, void *context)
+{
+    if (log_cache == NULL)
+    {
+        fprintf(stderr, "File system not initialized.\n");
+        return -1;
+    }
+    return query_dir(log_cache, from, to, level_mask, callback, context);
+}
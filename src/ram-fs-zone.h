@@ -0,0 +1,133 @@
+/**
+ * @file ram-fs-zone.h
+ * @brief RAM-FS time and level zone map declarations
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef ram_fs_zone_h_
+#define ram_fs_zone_h_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common/logger.h"
+#include "ram-fs.h"
+
+#define ZONE_MAP_BLOCK_RECORDS 8 /* Records summarized by one zone */
+#define MAX_FILE_ZONES ((MAX_FILE_RECORDS + ZONE_MAP_BLOCK_RECORDS - 1) / ZONE_MAP_BLOCK_RECORDS)
+
+/**
+ * @brief Summary of one block of ZONE_MAP_BLOCK_RECORDS consecutive records
+ *
+ * A block whose time range or level bitmap cannot satisfy a query is skipped without reading its
+ * records. Records that are not in append_log_record() format leave the summary untouched.
+ */
+typedef struct
+{
+    uint64_t min_timestamp; /**< Oldest timestamp in the block, UINT64_MAX if none */
+    uint64_t max_timestamp; /**< Newest timestamp in the block, 0 if none */
+    uint8_t levels;         /**< LOG_LEVEL_BIT() of every level present */
+} PACKED Zone;
+
+/**
+ * @brief Sparse time and level index of a file, one Zone per block of records
+ */
+struct zone_map
+{
+    uint16_t covered_records; /**< Records of file->index folded into the zones so far */
+    uint16_t num_zones;       /**< Zones in use */
+    Zone zones[MAX_FILE_ZONES];
+} PACKED;
+
+/**
+ * @brief Receives one record of a range query
+ *
+ * @param[in] file      File holding the record
+ * @param[in] timestamp Record timestamp
+ * @param[in] level     Record level
+ * @param[in] message   Message text inside file->content, not NUL terminated
+ * @param[in] length    Message length
+ * @param[in] context   Pointer passed to the query
+ */
+typedef void (*log_record_callback)(const File *file, uint64_t timestamp, enum log_level level,
+                                    const char *message, size_t length, void *context);
+
+/**
+ * @brief Appends a timestamped record to a file and keeps its zone map current
+ *
+ * The record is framed with insert_marker() as "<timestamp> <LEVEL> <message>", where LEVEL is
+ * MESSAGE, WARNING or CRITICAL. Timestamps come from the caller, since the targets have no common
+ * clock; they only need to be monotonic per file for range queries to be exact.
+ *
+ * @param[in] file      File to append to, typically in log_cache
+ * @param[in] level     Record level
+ * @param[in] timestamp Record time in the caller's units
+ * @param[in] message   Message text
+ * @return 0 on success, -1 on failure
+ */
+RAM_FS int append_log_record(File *file, enum log_level level, uint64_t timestamp, const char *message);
+
+/**
+ * @brief Folds records appended since the last call into a file's zone map
+ *
+ * Called by append_log_record() and by the queries, so records written through insert_marker() or
+ * the RAM-FS sink are picked up as well.
+ *
+ * @param[in] file File to index
+ * @return 0 on success, -1 on failure
+ */
+RAM_FS int zone_map_update(File *file);
+
+/**
+ * @brief Streams the records of a file within [from, to] whose level is in level_mask
+ *
+ * @param[in] file       File to query
+ * @param[in] from       Oldest timestamp, inclusive
+ * @param[in] to         Newest timestamp, inclusive
+ * @param[in] level_mask LOG_LEVEL_BIT() of the levels wanted, LOG_LEVEL_ALL for any
+ * @param[in] callback   Called for each record in file order
+ * @param[in] context    Passed through to the callback
+ * @return long Number of records reported, -1 for failure
+ */
+RAM_FS long query_log_records(File *file, uint64_t from, uint64_t to, unsigned level_mask,
+                              log_record_callback callback, void *context);
+
+/**
+ * @brief Runs query_log_records() over every file in log_cache and its subdirs
+ *
+ * @return long Number of records reported, -1 for failure
+ */
+RAM_FS long query_log_cache(uint64_t from, uint64_t to, unsigned level_mask, log_record_callback callback,
+                            void *context);
+
+#endif /* ram_fs_zone_h_ */
@@ -37,16 +37,503 @@
 
 
 /* System includes */
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef __linux__
+
+#include <pthread.h>
+#include <sched.h>
+
+#endif
+
+#ifdef __ZEPHYR__
+
+#include <zephyr/sys/printk.h>
+
+#endif
+
 /* Local includes */
 #include "ram-fs.h"
+#include "ram-fs-zone.h"
 
 Directory *log_cache;
 Directory *root_dir;
 
+/* Fixed size objects carved out of the reservation, free ones chained through their first bytes */
+struct object_pool
+{
+    size_t size;
+    unsigned char *first;
+    unsigned char *last;
+    void *free;
+};
+
+static unsigned char *reservation;
+static struct object_pool pools[RAM_FS_OBJECTS];
+static File **file_list;
+static int file_list_capacity;
+
+#ifdef __linux__
+
+static pthread_mutex_t snapshot_lock = PTHREAD_MUTEX_INITIALIZER;
+#define SNAPSHOT_LOCK() pthread_mutex_lock(&snapshot_lock)
+#define SNAPSHOT_UNLOCK() pthread_mutex_unlock(&snapshot_lock)
+
+#else
+
+#define SNAPSHOT_LOCK()
+#define SNAPSHOT_UNLOCK()
+
+#endif
+
+enum node_kind
+{
+    NODE_FILE = 0,
+    NODE_DIRECTORY
+};
+
+/* Lengths of one node as seen by the snapshots with a generation in (from, upto] */
+struct ram_fs_version
+{
+    struct ram_fs_version *older; /* Next older version of the same node */
+    struct ram_fs_version *next;  /* Every version, walked by ram_fs_snapshot_release() */
+    void *node;
+    enum node_kind kind;
+    uint32_t from;
+    uint32_t upto;
+    unsigned refs;  /* Held snapshots in the range */
+    int lengths[2]; /* File size, or directory file and subdir counts */
+};
+
+struct ram_fs_snapshot
+{
+    uint32_t generation; /* 0 for a free slot */
+    int lost;            /* A version it needed could not be allocated */
+};
+
+/* Everything below is guarded by snapshot_lock; horizon is also read without it by writers */
+static struct ram_fs_snapshot snapshots[RAM_FS_MAX_SNAPSHOTS];
+static struct ram_fs_version *versions;
+static uint32_t generation; /* Of the newest snapshot taken */
+static uint32_t horizon;    /* Of the newest snapshot held, 0 with none */
+#ifdef __linux__
+static unsigned unlocked_writers; /* Writers that saw no snapshot and skipped the lock */
+#endif
+
+static const size_t object_sizes[RAM_FS_OBJECTS] = {sizeof(File),           sizeof(Directory),
+                                                     sizeof(RecordIndex),    sizeof(struct zone_map),
+                                                     sizeof(struct log_sink), sizeof(struct ram_fs_version)};
+
+#define ALIGN_UP(size, align) (((size) + (align) - 1) / (align) * (align))
+
+static const struct ram_fs_image *image; /* Image the tree was booted from, NULL if built at runtime */
+
+static void *pool_pop(struct object_pool *pool)
+{
+    void *block = pool->free;
+    if (block != NULL)
+    {
+        memcpy(&pool->free, block, sizeof(void *));
+    }
+    return block;
+}
+
+static void pool_push(struct object_pool *pool, void *block)
+{
+    memcpy(block, &pool->free, sizeof(void *));
+    pool->free = block;
+}
+
+int ram_fs_reserve(const struct ram_fs_limits *limits)
+{
+    if (limits == NULL || reservation != NULL)
+    {
+        fprintf(stderr, "RAM-FS already reserved.\n");
+        return -1;
+    }
+
+    /* Every pool starts, and every object is padded, to the strictest alignment the objects may need */
+    const size_t align = _Alignof(max_align_t);
+    const unsigned counts[RAM_FS_OBJECTS] = {limits->files, limits->directories, limits->files,
+                                             limits->files, limits->sinks,       limits->versions};
+    size_t strides[RAM_FS_OBJECTS];
+    size_t total = ALIGN_UP((size_t)limits->files * sizeof(File *), align);
+    for (int object = 0; object < RAM_FS_OBJECTS; object++)
+    {
+        strides[object] = ALIGN_UP(object_sizes[object], align);
+        total += counts[object] * strides[object];
+    }
+
+    reservation = (unsigned char *)malloc(total > 0 ? total : 1);
+    if (reservation == NULL)
+    {
+        fprintf(stderr, "Memory allocation failed.\n");
+        return -1;
+    }
+
+    unsigned char *next = reservation;
+    file_list = (File **)next;
+    file_list_capacity = limits->files;
+    next += ALIGN_UP((size_t)limits->files * sizeof(File *), align);
+    for (int object = 0; object < RAM_FS_OBJECTS; object++)
+    {
+        struct object_pool *pool = &pools[object];
+        pool->size = strides[object];
+        pool->first = next;
+        pool->last = next + counts[object] * strides[object];
+        pool->free = NULL;
+        /* Pushed back to front so objects are handed out in address order */
+        for (unsigned i = counts[object]; i-- > 0;)
+        {
+            pool_push(pool, next + i * strides[object]);
+        }
+        next = pool->last;
+    }
+    return 0;
+}
+
+int ram_fs_reserved(void)
+{
+    return reservation != NULL;
+}
+
+void *ram_fs_alloc(enum ram_fs_object object)
+{
+    if (reservation == NULL)
+    {
+        return crb_malloc(object_sizes[object]);
+    }
+    void *block = pool_pop(&pools[object]);
+    if (block == NULL)
+    {
+        fprintf(stderr, "RAM-FS pool of %u byte objects exhausted.\n", (unsigned)object_sizes[object]);
+    }
+    return block;
+}
+
+void ram_fs_free(void *block)
+{
+    if (block == NULL)
+    {
+        return;
+    }
+    for (int object = 0; reservation != NULL && object < RAM_FS_OBJECTS; object++)
+    {
+        struct object_pool *pool = &pools[object];
+        if ((unsigned char *)block >= pool->first && (unsigned char *)block < pool->last)
+        {
+            pool_push(pool, block);
+            return;
+        }
+    }
+    crb_free(block);
+}
+
+File **ram_fs_file_list(int *capacity)
+{
+    *capacity = file_list_capacity;
+    return file_list;
+}
+
+/* Writers skip the lock unless a snapshot is held; ram_fs_snapshot() waits out those already past the check */
+static int write_begin(void)
+{
+#ifdef __linux__
+    __atomic_add_fetch(&unlocked_writers, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&horizon, __ATOMIC_SEQ_CST) == 0)
+    {
+        return 0;
+    }
+    __atomic_sub_fetch(&unlocked_writers, 1, __ATOMIC_RELEASE);
+#else
+    if (horizon == 0)
+    {
+        return 0;
+    }
+#endif
+    SNAPSHOT_LOCK();
+    return 1;
+}
+
+static void write_end(int locked)
+{
+    if (locked)
+    {
+        SNAPSHOT_UNLOCK();
+        return;
+    }
+#ifdef __linux__
+    __atomic_sub_fetch(&unlocked_writers, 1, __ATOMIC_RELEASE);
+#endif
+}
+
+/* Lock held: freezes a node's lengths for the held snapshots that see them, the ones newer than stamp */
+static struct ram_fs_version *freeze(void *node, enum node_kind kind, struct ram_fs_version *newest, uint32_t stamp,
+                                     int first, int second)
+{
+    unsigned refs = 0;
+
+    for (int i = 0; i < RAM_FS_MAX_SNAPSHOTS; i++)
+    {
+        refs += snapshots[i].generation > stamp;
+    }
+    if (refs == 0)
+    {
+        return newest;
+    }
+
+    struct ram_fs_version *version = (struct ram_fs_version *)ram_fs_alloc(RAM_FS_OBJECT_VERSION);
+    if (version == NULL)
+    {
+        fprintf(stderr, "RAM-FS snapshot lost, no memory for a version.\n");
+        for (int i = 0; i < RAM_FS_MAX_SNAPSHOTS; i++)
+        {
+            if (snapshots[i].generation > stamp)
+            {
+                snapshots[i].lost = 1;
+            }
+        }
+        return newest;
+    }
+    version->older = newest;
+    version->next = versions;
+    version->node = node;
+    version->kind = kind;
+    version->from = stamp;
+    version->upto = generation;
+    version->refs = refs;
+    version->lengths[0] = first;
+    version->lengths[1] = second;
+    versions = version;
+    return version;
+}
+
+/* Lock held: called before a node changes, and by readers so they see it as of their snapshot only */
+static void preserve_file(File *file)
+{
+    if (horizon > file->stamp)
+    {
+        file->versions = freeze(file, NODE_FILE, file->versions, file->stamp, file->size, 0);
+        file->stamp = generation;
+    }
+}
+
+static void preserve_dir(Directory *dir)
+{
+    if (horizon > dir->stamp)
+    {
+        dir->versions = freeze(dir, NODE_DIRECTORY, dir->versions, dir->stamp, dir->num_files, dir->num_subdirs);
+        dir->stamp = generation;
+    }
+}
+
+/* Lock held: the version of a node a snapshot sees, NULL if the node is newer than the snapshot */
+static const struct ram_fs_version *resolve(const struct ram_fs_snapshot *snapshot,
+                                            const struct ram_fs_version *version)
+{
+    for (; version != NULL; version = version->older)
+    {
+        if (version->from < snapshot->generation && snapshot->generation <= version->upto)
+        {
+            return version;
+        }
+    }
+    return NULL;
+}
+
+static struct ram_fs_version *unlink_version(struct ram_fs_version *chain, struct ram_fs_version *version)
+{
+    if (chain == version)
+    {
+        return version->older;
+    }
+    for (struct ram_fs_version *newer = chain; newer != NULL; newer = newer->older)
+    {
+        if (newer->older == version)
+        {
+            newer->older = version->older;
+            break;
+        }
+    }
+    return chain;
+}
+
+static void set_horizon(uint32_t value)
+{
+#ifdef __linux__
+    __atomic_store_n(&horizon, value, __ATOMIC_SEQ_CST);
+#else
+    horizon = value;
+#endif
+}
+
+/* Position of a node in the image, -1 for nodes created at runtime */
+static long image_file_slot(const File *file)
+{
+    if (image == NULL || file < image->files || file >= image->files + image->num_files)
+    {
+        return -1;
+    }
+    return file - image->files;
+}
+
+static long image_dir_slot(const Directory *dir)
+{
+    if (image == NULL || dir < image->dirs || dir >= image->dirs + image->num_dirs)
+    {
+        return -1;
+    }
+    return dir - image->dirs;
+}
+
+/* Promotions are published once, fully copied, and read without the lock */
+static void *load_promoted(void **slot)
+{
+#ifdef __linux__
+    return __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+#else
+    return *slot;
+#endif
+}
+
+static void store_promoted(void **slot, void *copy)
+{
+#ifdef __linux__
+    __atomic_store_n(slot, copy, __ATOMIC_RELEASE);
+#else
+    *slot = copy;
+#endif
+}
+
+File *ram_fs_file(File *file)
+{
+    long slot = image_file_slot(file);
+    if (slot != -1)
+    {
+        File *copy = (File *)load_promoted((void **)&image->promoted_files[slot]);
+        if (copy != NULL)
+        {
+            return copy;
+        }
+    }
+    return file;
+}
+
+Directory *ram_fs_dir(Directory *dir)
+{
+    long slot = image_dir_slot(dir);
+    if (slot != -1)
+    {
+        Directory *copy = (Directory *)load_promoted((void **)&image->promoted_dirs[slot]);
+        if (copy != NULL)
+        {
+            return copy;
+        }
+    }
+    return dir;
+}
+
+/* Copies a file of the image to RAM before its first write; NULL if there is no memory for the copy */
+static File *promote_file(File *file)
+{
+    file = ram_fs_file(file);
+    long slot = image_file_slot(file);
+    if (slot == -1)
+    {
+        return file;
+    }
+
+    SNAPSHOT_LOCK();
+    File *copy = image->promoted_files[slot];
+    if (copy == NULL)
+    {
+        copy = (File *)ram_fs_alloc(RAM_FS_OBJECT_FILE);
+        RecordIndex *index = file->index != NULL ? (RecordIndex *)ram_fs_alloc(RAM_FS_OBJECT_INDEX) : NULL;
+        struct zone_map *zones = file->zones != NULL ? (struct zone_map *)ram_fs_alloc(RAM_FS_OBJECT_ZONE_MAP) : NULL;
+        if (copy == NULL || (file->index != NULL && index == NULL) || (file->zones != NULL && zones == NULL))
+        {
+            fprintf(stderr, "Memory allocation failed.\n");
+            ram_fs_free(copy);
+            ram_fs_free(index);
+            ram_fs_free(zones);
+            SNAPSHOT_UNLOCK();
+            return NULL;
+        }
+        memcpy(copy, file, sizeof(File));
+        if (index != NULL)
+        {
+            memcpy(index, file->index, sizeof(RecordIndex));
+        }
+        if (zones != NULL)
+        {
+            memcpy(zones, file->zones, sizeof(struct zone_map));
+        }
+        copy->index = index;
+        copy->zones = zones;
+        store_promoted((void **)&image->promoted_files[slot], copy);
+    }
+    SNAPSHOT_UNLOCK();
+    return copy;
+}
+
+static Directory *promote_dir(Directory *dir)
+{
+    dir = ram_fs_dir(dir);
+    long slot = image_dir_slot(dir);
+    if (slot == -1)
+    {
+        return dir;
+    }
+
+    SNAPSHOT_LOCK();
+    Directory *copy = image->promoted_dirs[slot];
+    if (copy == NULL)
+    {
+        copy = (Directory *)ram_fs_alloc(RAM_FS_OBJECT_DIRECTORY);
+        if (copy == NULL)
+        {
+            fprintf(stderr, "Memory allocation failed.\n");
+            SNAPSHOT_UNLOCK();
+            return NULL;
+        }
+        memcpy(copy, dir, sizeof(Directory));
+        store_promoted((void **)&image->promoted_dirs[slot], copy);
+    }
+    SNAPSHOT_UNLOCK();
+    return copy;
+}
+
+int init_filesystem_image(const struct ram_fs_image *boot_image)
+{
+    if (boot_image == NULL || boot_image->num_dirs < 2)
+    {
+        fprintf(stderr, "Invalid RAM-FS image.\n");
+        return -1;
+    }
+    if (root_dir != NULL || log_cache != NULL)
+    {
+        printk("Failed to initialize root directory\n");
+        return -1;
+    }
+    image = boot_image;
+    root_dir = (Directory *)&image->dirs[0];
+    log_cache = (Directory *)&image->dirs[1];
+    return 0;
+}
+
+int init_filesystem_reserved(const struct ram_fs_limits *limits)
+{
+    if (ram_fs_reserve(limits) == -1)
+    {
+        return -1;
+    }
+    init_filesystem();
+    return 0;
+}
+
 void init_filesystem(void)
 {
     if (root_dir == NULL)
@@ -73,16 +560,60 @@ void init_filesystem(void)
 
 void deinit_filesystem(void)
 {
+    if (image != NULL)
+    {
+        /* The image itself is constant; only the nodes promoted to RAM are released */
+        for (int i = 0; i < image->num_files; i++)
+        {
+            File *copy = image->promoted_files[i];
+            if (copy != NULL)
+            {
+                ram_fs_free(copy->index);
+                ram_fs_free(copy->zones);
+                ram_fs_free(copy);
+                image->promoted_files[i] = NULL;
+            }
+        }
+        for (int i = 0; i < image->num_dirs; i++)
+        {
+            ram_fs_free(image->promoted_dirs[i]);
+            image->promoted_dirs[i] = NULL;
+        }
+        image = NULL;
+        root_dir = NULL;
+        log_cache = NULL;
+    }
     if (root_dir != NULL)
     {
-        free(root_dir);
+        ram_fs_free(root_dir);
         root_dir = NULL;
     }
-    if (log_cache == NULL)
+    if (log_cache != NULL)
     {
-        free(log_cache);
+        ram_fs_free(log_cache);
         log_cache = NULL;
     }
+
+    /* Snapshots cannot outlive the tree they looked at */
+    SNAPSHOT_LOCK();
+    while (versions != NULL)
+    {
+        struct ram_fs_version *version = versions;
+        versions = version->next;
+        ram_fs_free(version);
+    }
+    memset(snapshots, 0, sizeof(snapshots));
+    set_horizon(0);
+    SNAPSHOT_UNLOCK();
+
+    if (reservation != NULL)
+    {
+        /* Every object still handed out lived in the reservation and goes with it */
+        free(reservation);
+        reservation = NULL;
+        file_list = NULL;
+        file_list_capacity = 0;
+    }
     return;
 }
 
@@ -98,16 +629,21 @@ void deinit_filesystem(void)
  */
 File *create_file(const char *name, const char *content, file_permissions permissions)
 {
-    File *file = (File *)crb_malloc(sizeof(File));
+    File *file = (File *)ram_fs_alloc(RAM_FS_OBJECT_FILE);
     if (file == NULL)
     {
         fprintf(stderr, "Memory allocation failed.\n");
         exit(1);
     }
     strncpy(file->name, name, MAX_FILENAME_LENGTH);
+    file->index = NULL;
+    file->zones = NULL;
+    file->versions = NULL;
+    SNAPSHOT_LOCK();
+    file->stamp = generation; /* Held snapshots are older and never see it */
+    SNAPSHOT_UNLOCK();
 
     // Copy content and insert \n character
-    insert_marker(content);
     strncpy(file->content, content, MAX_FILE_CONTENT_LENGTH);
     file->content[MAX_FILE_CONTENT_LENGTH - 1] = '\0'; // Ensure null-termination
     if (strlen(content) < MAX_FILE_CONTENT_LENGTH - 1)
@@ -145,7 +681,7 @@ File *create_file(const char *name, const char *content, file_permissions permis
  */
 Directory *create_directory(const char *name)
 {
-    Directory *dir = (Directory *)crb_malloc(sizeof(Directory));
+    Directory *dir = (Directory *)ram_fs_alloc(RAM_FS_OBJECT_DIRECTORY);
     if (dir == NULL)
     {
         fprintf(stderr, "Memory allocation failed.\n");
@@ -154,6 +690,10 @@ Directory *create_directory(const char *name)
     strncpy(dir->name, name, MAX_FILENAME_LENGTH);
     dir->num_files = 0;
     dir->num_subdirs = 0;
+    dir->versions = NULL;
+    SNAPSHOT_LOCK();
+    dir->stamp = generation;
+    SNAPSHOT_UNLOCK();
     return dir;
 }
 
@@ -168,14 +708,25 @@ Directory *create_directory(const char *name)
  */
 void append_to_dir(Directory *dir, File *file)
 {
+    dir = promote_dir(dir);
+    if (dir == NULL)
+    {
+        return;
+    }
+    int locked = write_begin();
     if (dir->num_files < MAX_FILES)
     {
+        if (locked)
+        {
+            preserve_dir(dir);
+        }
         dir->files[dir->num_files++] = file;
     }
     else
     {
         fprintf(stderr, "Directory is full, cannot add file.\n");
     }
+    write_end(locked);
 }
 
 /**
@@ -187,47 +738,532 @@ void append_to_dir(Directory *dir, File *file)
  */
 void ls_dir(Directory *root)
 {
+    root = ram_fs_dir(root);
+
     // Print header
-    printf("Files: \n");
+    log_printf("Files: \n");
 
     // Iterate through each file in the directory
     for (int i = 0; i < root->num_files; ++i)
     {
         // Print the name of the file
-        printf("%s\n", root->files[i]->name);
+        log_printf("%s\n", root->files[i]->name);
+    }
+}
+
+/* Appends raw bytes and keeps the content null-terminated */
+static int append_to_file(File *file, const char *data, size_t length)
+{
+    if (file == NULL || data == NULL)
+    {
+        fprintf(stderr, "File not found.\n");
+        return -1;
+    }
+    file = ram_fs_file(file);
+    if (file->permissions == RESTRICTED)
+    {
+        fprintf(stderr, "File %s is restricted.\n", file->name);
+        return -1;
+    }
+    if ((size_t)file->size + length > MAX_FILE_CONTENT_LENGTH - 1)
+    {
+        return -1;
+    }
+
+    file = promote_file(file);
+    if (file == NULL)
+    {
+        return -1;
+    }
+    int locked = write_begin();
+    if (locked)
+    {
+        preserve_file(file);
+    }
+    memcpy(file->content + file->size, data, length);
+    file->size += (int)length;
+    file->content[file->size] = '\0';
+    write_end(locked);
+    return 0;
+}
+
+int write_to_file(File *file, const char *data)
+{
+    return append_to_file(file, data, data == NULL ? 0 : strlen(data));
+}
+
+/* Frames one record in place: opening marker, content, closing marker */
+static int append_record(File *file, const char *data, size_t length)
+{
+    if (file == NULL || data == NULL)
+    {
+        fprintf(stderr, "File not found.\n");
+        return -1;
+    }
+    file = ram_fs_file(file);
+    if (file->permissions == RESTRICTED)
+    {
+        fprintf(stderr, "File %s is restricted.\n", file->name);
+        return -1;
+    }
+    if ((size_t)file->size + length + 2 * MARKER_LENGTH > MAX_FILE_CONTENT_LENGTH - 1)
+    {
+        return -1;
+    }
+    if (log_kernels->find_marker(data, length) != length)
+    {
+        return -1;
+    }
+
+    file = promote_file(file);
+    if (file == NULL)
+    {
+        return -1;
+    }
+    int locked = write_begin();
+    if (locked)
+    {
+        preserve_file(file);
+    }
+    char *cursor = file->content + file->size;
+    memcpy(cursor, MARKER, MARKER_LENGTH);
+    memcpy(cursor + MARKER_LENGTH, data, length);
+    memcpy(cursor + MARKER_LENGTH + length, MARKER, MARKER_LENGTH);
+
+    /* Keep an up to date index current instead of rescanning later */
+    RecordIndex *index = file->index;
+    if (index != NULL && index->scanned == file->size && index->num_records < MAX_FILE_RECORDS)
+    {
+        index->records[index->num_records].offset = (uint16_t)(file->size + MARKER_LENGTH);
+        index->records[index->num_records].length = (uint16_t)length;
+        index->num_records++;
+        index->scanned = (uint16_t)(file->size + length + 2 * MARKER_LENGTH);
+    }
+
+    file->size += (int)(length + 2 * MARKER_LENGTH);
+    file->content[file->size] = '\0';
+    write_end(locked);
+    return 0;
+}
+
+int insert_marker(File *file, const char *content)
+{
+    return append_record(file, content, content == NULL ? 0 : strlen(content));
+}
+
+/* Adds the complete records from position on to an index; returns where the next scan has to resume */
+static size_t scan_records(const char *content, size_t size, size_t position, RecordIndex *index)
+{
+    while (position < size && index->num_records < MAX_FILE_RECORDS)
+    {
+        size_t open = position + log_kernels->find_marker(content + position, size - position);
+        if (open == size)
+        {
+            /* No further markers; only the last bytes could still become the start of one */
+            if (size - position >= MARKER_LENGTH - 1)
+            {
+                position = size - (MARKER_LENGTH - 1);
+            }
+            break;
+        }
+
+        size_t start = open + MARKER_LENGTH;
+        size_t close = start + log_kernels->find_marker(content + start, size - start);
+        if (close == size)
+        {
+            /* Unterminated record; resume from its opening marker next time */
+            position = open;
+            break;
+        }
+
+        index->records[index->num_records].offset = (uint16_t)start;
+        index->records[index->num_records].length = (uint16_t)(close - start);
+        index->num_records++;
+        position = close + MARKER_LENGTH;
+    }
+    return position;
+}
+
+int identify_marker(File *file)
+{
+    if (file == NULL)
+    {
+        fprintf(stderr, "File not found.\n");
+        return -1;
+    }
+    /* Files of an image come indexed, so an unwritten one is never scanned again */
+    file = ram_fs_file(file);
+
+    RecordIndex *index = file->index;
+    if (index == NULL)
+    {
+        index = (RecordIndex *)ram_fs_alloc(RAM_FS_OBJECT_INDEX);
+        if (index == NULL)
+        {
+            fprintf(stderr, "Memory allocation failed.\n");
+            return -1;
+        }
+        index->scanned = 0;
+        index->num_records = 0;
+        file->index = index;
+    }
+
+    size_t position = scan_records(file->content, (size_t)file->size, index->scanned, index);
+
+    if (position > index->scanned)
+    {
+        index->scanned = (uint16_t)position;
+    }
+    return 0;
+}
+
+const char *file_record(File *file, int record, size_t *length)
+{
+    file = ram_fs_file(file);
+    if (file == NULL || file->index == NULL || record < 0 || record >= file->index->num_records)
+    {
+        return NULL;
+    }
+
+    const RecordSpan *span = &file->index->records[record];
+    *length = span->length;
+    return file->content + span->offset;
+}
+
+int insert_telemetry_block(File *file, const uint8_t *block, size_t length)
+{
+    char text[MAX_FILE_CONTENT_LENGTH]; /* A longer record could not fit in a file anyway */
+
+    if (block == NULL || telemetry_block_to_text(block, length, text, sizeof(text)) == 0)
+    {
+        fprintf(stderr, "Telemetry block too large.\n");
+        return -1;
+    }
+    return insert_marker(file, text);
+}
+
+long file_telemetry_block(File *file, int record, uint8_t *block, size_t capacity)
+{
+    size_t length;
+    const char *text = file_record(file, record, &length);
+
+    if (text == NULL)
+    {
+        return -1;
+    }
+    return telemetry_block_from_text(text, length, block, capacity);
+}
+
+static int ram_fs_sink_write(struct log_sink *sink, const char *data, size_t length)
+{
+    return append_record((File *)sink->context, data, length);
+}
+
+static void ram_fs_sink_close(struct log_sink *sink)
+{
+    ram_fs_free(sink);
+}
+
+struct log_sink *log_sink_ram_fs(File *file)
+{
+    if (file == NULL)
+    {
+        fprintf(stderr, "File not found.\n");
+        return NULL;
+    }
+
+    struct log_sink *sink = (struct log_sink *)ram_fs_alloc(RAM_FS_OBJECT_SINK);
+    if (sink == NULL)
+    {
+        fprintf(stderr, "Memory allocation failed.\n");
+        return NULL;
     }
+    sink->name = "ram-fs";
+    sink->write = ram_fs_sink_write;
+    sink->write_level = NULL;
+    sink->flush = NULL;
+    sink->close = ram_fs_sink_close;
+    sink->colorize = 0;
+    sink->context = file;
+    return sink;
 }
 
-void write_to_file(File *file, const char *data)
+struct ram_fs_snapshot *ram_fs_snapshot(void)
 {
+    struct ram_fs_snapshot *snapshot = NULL;
+
+    SNAPSHOT_LOCK();
+    for (int i = 0; i < RAM_FS_MAX_SNAPSHOTS && snapshot == NULL; i++)
+    {
+        if (snapshots[i].generation == 0)
+        {
+            snapshot = &snapshots[i];
+        }
+    }
+    if (snapshot != NULL)
+    {
+        snapshot->generation = ++generation;
+        snapshot->lost = 0;
+        set_horizon(generation);
+#ifdef __linux__
+        /* Writers that passed the check before the store finish unlocked; every later one takes the lock */
+        while (__atomic_load_n(&unlocked_writers, __ATOMIC_ACQUIRE) != 0)
+        {
+            sched_yield();
+        }
+#endif
+    }
+    SNAPSHOT_UNLOCK();
+
+    if (snapshot == NULL)
+    {
+        fprintf(stderr, "All %d RAM-FS snapshots are held.\n", RAM_FS_MAX_SNAPSHOTS);
+    }
+    return snapshot;
 }
 
-int insert_marker(const char *content)
+void ram_fs_snapshot_release(struct ram_fs_snapshot *snapshot)
 {
-    size_t original_length = strlen(content);
-    size_t prefix_length = strlen(MARKER);
-    size_t suffix_length = strlen(MARKER);
+    if (snapshot == NULL)
+    {
+        return;
+    }
+
+    SNAPSHOT_LOCK();
+    uint32_t released = snapshot->generation;
+    struct ram_fs_version **link = &versions;
+    while (*link != NULL)
+    {
+        struct ram_fs_version *version = *link;
+        if (version->from < released && released <= version->upto && --version->refs == 0)
+        {
+            *link = version->next;
+            if (version->kind == NODE_FILE)
+            {
+                File *file = (File *)version->node;
+                file->versions = unlink_version(file->versions, version);
+            }
+            else
+            {
+                Directory *dir = (Directory *)version->node;
+                dir->versions = unlink_version(dir->versions, version);
+            }
+            ram_fs_free(version);
+            continue;
+        }
+        link = &version->next;
+    }
+    snapshot->generation = 0;
 
-    char *combined_string = (char *)crb_malloc(original_length + prefix_length + suffix_length + 1);
+    uint32_t newest = 0;
+    for (int i = 0; i < RAM_FS_MAX_SNAPSHOTS; i++)
+    {
+        if (snapshots[i].generation > newest)
+        {
+            newest = snapshots[i].generation;
+        }
+    }
+    set_horizon(newest);
+    SNAPSHOT_UNLOCK();
+}
 
-    if (combined_string == NULL)
+int ram_fs_snapshot_dir(struct ram_fs_snapshot *snapshot, Directory *dir, int *num_files, int *num_subdirs)
+{
+    int status = -1;
+
+    if (snapshot == NULL || dir == NULL)
     {
-        fprintf(stderr, "Memory allocation failed");
+        fprintf(stderr, "Snapshot or directory not found.\n");
         return -1;
     }
-    // Copy the prefix to the combined string
-    strcpy(combined_string, MARKER);
 
-    // Append the original string to the combined string
-    strcat(combined_string, content);
+    SNAPSHOT_LOCK();
+    dir = ram_fs_dir(dir);
+    if (image_dir_slot(dir) != -1)
+    {
+        /* Never written, so every snapshot sees the image */
+        *num_files = dir->num_files;
+        *num_subdirs = dir->num_subdirs;
+        status = snapshot->lost ? -1 : 0;
+    }
+    else
+    {
+        preserve_dir(dir);
+        const struct ram_fs_version *version = resolve(snapshot, dir->versions);
+        if (version != NULL && !snapshot->lost)
+        {
+            *num_files = version->lengths[0];
+            *num_subdirs = version->lengths[1];
+            status = 0;
+        }
+    }
+    SNAPSHOT_UNLOCK();
+    return status;
+}
 
-    // Append the suffix to the combined string
-    strcat(combined_string, MARKER);
+long ram_fs_snapshot_file(struct ram_fs_snapshot *snapshot, File *file)
+{
+    long size = -1;
 
-    // Print the combined string
-    printf("%s\n", combined_string);
+    if (snapshot == NULL || file == NULL)
+    {
+        fprintf(stderr, "Snapshot or file not found.\n");
+        return -1;
+    }
 
-    return 0U;
+    SNAPSHOT_LOCK();
+    file = ram_fs_file(file);
+    if (image_file_slot(file) != -1)
+    {
+        size = snapshot->lost ? -1 : file->size;
+    }
+    else
+    {
+        preserve_file(file);
+        const struct ram_fs_version *version = resolve(snapshot, file->versions);
+        if (version != NULL && !snapshot->lost)
+        {
+            size = version->lengths[0];
+        }
+    }
+    SNAPSHOT_UNLOCK();
+    return size;
+}
+
+long ram_fs_snapshot_index(struct ram_fs_snapshot *snapshot, File *file, RecordIndex *index)
+{
+    long size = ram_fs_snapshot_file(snapshot, file);
+
+    if (size == -1 || index == NULL)
+    {
+        return -1;
+    }
+    index->num_records = 0;
+    index->scanned = (uint16_t)scan_records(ram_fs_file(file)->content, (size_t)size, 0, index);
+    return size;
+}
+
+/* Writes one record as a line; a record that already ends in a newline keeps just that one */
+static int export_record(struct log_sink *sink, const char *record, size_t length)
+{
+    if (length > 0 && record[length - 1] == '\n')
+    {
+        length--;
+    }
+    if (sink->write(sink, record, length) == -1 || sink->write(sink, "\n", 1) == -1)
+    {
+        return -1;
+    }
+    return 0;
+}
+
+static long export_file(struct ram_fs_snapshot *snapshot, File *file, struct log_sink *sink)
+{
+    RecordIndex index;
+    long size = ram_fs_snapshot_index(snapshot, file, &index);
+
+    if (size == -1)
+    {
+        return -1;
+    }
+    file = ram_fs_file(file);
+    if (index.num_records > 0)
+    {
+        for (int record = 0; record < index.num_records; record++)
+        {
+            if (export_record(sink, file->content + index.records[record].offset, index.records[record].length) == -1)
+            {
+                return -1;
+            }
+        }
+        return index.num_records;
+    }
+
+    /* Unframed file: each non-empty line is a record */
+    long written = 0;
+    size_t position = 0;
+    while (position < (size_t)size)
+    {
+        const char *newline = memchr(file->content + position, '\n', (size_t)size - position);
+        size_t end = newline == NULL ? (size_t)size : (size_t)(newline - file->content);
+        if (end > position)
+        {
+            if (export_record(sink, file->content + position, end - position) == -1)
+            {
+                return -1;
+            }
+            written++;
+        }
+        position = end + 1;
+    }
+    return written;
+}
+
+static long export_dir(struct ram_fs_snapshot *snapshot, Directory *dir, struct log_sink *sink)
+{
+    int num_files;
+    int num_subdirs;
+    long written = 0;
+
+    if (ram_fs_snapshot_dir(snapshot, dir, &num_files, &num_subdirs) == -1)
+    {
+        return -1;
+    }
+    dir = ram_fs_dir(dir);
+    for (int i = 0; i < num_files; i++)
+    {
+        long count = export_file(snapshot, dir->files[i], sink);
+        if (count == -1)
+        {
+            return -1;
+        }
+        written += count;
+    }
+    for (int i = 0; i < num_subdirs; i++)
+    {
+        long count = export_dir(snapshot, dir->subdirs[i], sink);
+        if (count == -1)
+        {
+            return -1;
+        }
+        written += count;
+    }
+    return written;
+}
+
+long ram_fs_snapshot_export(struct ram_fs_snapshot *snapshot, Directory *dir, struct log_sink *sink)
+{
+    Directory *tops[2] = {dir, NULL};
+    long written = 0;
+
+    if (snapshot == NULL || sink == NULL)
+    {
+        fprintf(stderr, "Snapshot or sink not found.\n");
+        return -1;
+    }
+    if (dir == NULL)
+    {
+        tops[0] = root_dir;
+        tops[1] = log_cache;
+    }
+    for (int i = 0; i < 2; i++)
+    {
+        if (tops[i] == NULL)
+        {
+            continue;
+        }
+        long count = export_dir(snapshot, tops[i], sink);
+        if (count == -1)
+        {
+            return -1;
+        }
+        written += count;
+    }
+    if (sink->flush != NULL)
+    {
+        sink->flush(sink);
+    }
+    return written;
 }
 
 /**
@@ -243,9 +1279,10 @@ void readfile(File *file)
         fprintf(stderr, "File not found.\n");
         return;
     }
+    file = ram_fs_file(file);
 
-    printf("Contents of file %s:\n", file->name);
-    printf("\n %s \n", file->content);
+    log_printf("Contents of file %s:\n", file->name);
+    log_printf("\n %s \n", file->content);
     return;
 }
 
@@ -292,10 +1329,17 @@ unsigned long long calculate_memory_usage(Directory *root)
 {
     size_t total_memory = 0;
 
+    root = ram_fs_dir(root);
+
     // Calculate memory used by files
     for (int i = 0; i < root->num_files; i++)
     {
-        total_memory += sizeof(File) + strlen(root->files[i]->name) + strlen(root->files[i]->content);
+        File *file = ram_fs_file(root->files[i]);
+        total_memory += sizeof(File) + strlen(file->name) + strlen(file->content);
+        if (file->index != NULL)
+        {
+            total_memory += sizeof(RecordIndex);
+        }
     }
 
     // Calculate memory used by subdirectories
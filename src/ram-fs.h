@@ -37,8 +37,22 @@
 #ifndef ram_fs_h_
 #define ram_fs_h_
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include "log-kernels.h"
+#include "log-sink.h"
+#include "log-telemetry.h"
+
 #define RAM_FS __attribute__((section(".RAM-FS")))
 
+/* Constant images from lmkfs; position independent builds relocate their pointers at load, and RELRO then makes them read only */
+#if defined(__PIC__)
+#define RAM_FS_IMAGE __attribute__((section(".data.rel.ro.RAM-FS")))
+#else
+#define RAM_FS_IMAGE __attribute__((section(".rodata.RAM-FS")))
+#endif
+
 #define PACKED __attribute__((packed))
 
 #define MAX_FILENAME_LENGTH 100
@@ -46,7 +60,23 @@
 #define MAX_FILES 100
 #define MAX_DIRS 100
 
-#define MARKER "[*]"
+#define MARKER LOG_MARKER
+#define MARKER_LENGTH LOG_MARKER_LENGTH
+#define MAX_FILE_RECORDS (MAX_FILE_CONTENT_LENGTH / (2 * MARKER_LENGTH)) /* An empty record is two markers */
+#define RAM_FS_MAX_SNAPSHOTS 8 /* Snapshots that can be held at the same time */
+
+#ifndef __ZEPHYR__
+/* printk is Zephyr's console output; hosted builds print through stdio */
+#define printk printf
+#endif
+
+/* Heap behind ram_fs_alloc() and ram_fs_free() while no ram_fs_reserve() reservation is in place */
+#ifndef crb_malloc
+#define crb_malloc malloc
+#endif
+#ifndef crb_free
+#define crb_free free
+#endif
 
 
 /**
@@ -59,6 +89,29 @@ typedef enum file_permissions
     RESTRICTED = 3 /**< Cannot edit */
 } PACKED file_permissions;
 
+/**
+ * @brief Location of one framed record inside a file's content
+ */
+typedef struct
+{
+    uint16_t offset; /**< First byte after the opening MARKER */
+    uint16_t length; /**< Bytes up to the closing MARKER */
+} PACKED RecordSpan;
+
+/**
+ * @brief Offsets of the framed records in a file, built by identify_marker()
+ */
+typedef struct
+{
+    uint16_t scanned;                        /**< Content before this offset has been parsed */
+    uint16_t num_records;                    /**< Valid entries in records */
+    RecordSpan records[MAX_FILE_RECORDS];    /**< Records in content order */
+} PACKED RecordIndex;
+
+struct zone_map; /* Time and level index, see ram-fs-zone.h */
+struct ram_fs_version; /* Lengths of a node frozen for older snapshots, private to ram-fs.c */
+struct ram_fs_snapshot; /* Handle from ram_fs_snapshot() */
+
 /**
  * @brief Structure to represent a file
  */
@@ -68,6 +121,10 @@ typedef struct
     char content[MAX_FILE_CONTENT_LENGTH]; /**< Content of the file */
     int size;                              /**< Size of the file content */
     file_permissions permissions;          /**< Permissions of given file content | Default permissions of a file is AVAILABLE */
+    RecordIndex *index;                    /**< Record offsets, NULL until identify_marker() runs */
+    struct zone_map *zones;                /**< Time and level index, NULL until zone_map_update() runs */
+    uint32_t stamp;                        /**< Snapshot generation the current size belongs to */
+    struct ram_fs_version *versions;       /**< Sizes frozen for older snapshots, newest first */
 } PACKED File;
 
 /**
@@ -80,8 +137,104 @@ typedef struct Directory
     File *files[MAX_FILES];              /**< Array of pointers to files in the directory */
     int num_subdirs;                     /**< Number of subdirectories in the directory */
     struct Directory *subdirs[MAX_DIRS]; /**< Array of pointers to subdirectories in the directory */
+    uint32_t stamp;                      /**< Snapshot generation the current counts belong to */
+    struct ram_fs_version *versions;     /**< Counts frozen for older snapshots, newest first */
 } PACKED Directory;
 
+/**
+ * @brief Classes of RAM-FS object, each with its own pool under ram_fs_reserve()
+ */
+enum ram_fs_object
+{
+    RAM_FS_OBJECT_FILE = 0,  /**< File */
+    RAM_FS_OBJECT_DIRECTORY, /**< Directory */
+    RAM_FS_OBJECT_INDEX,     /**< RecordIndex */
+    RAM_FS_OBJECT_ZONE_MAP,  /**< struct zone_map */
+    RAM_FS_OBJECT_SINK,      /**< RAM-FS log sink */
+    RAM_FS_OBJECT_VERSION,   /**< Snapshot version of a node */
+    RAM_FS_OBJECTS
+};
+
+/**
+ * @brief Number of each RAM-FS object reserved by ram_fs_reserve()
+ */
+struct ram_fs_limits
+{
+    uint16_t files;       /**< Files; each also gets a RecordIndex and a zone map */
+    uint16_t directories; /**< Directories, including root and log_cache */
+    uint16_t sinks;       /**< log_sink_ram_fs() sinks */
+    uint16_t versions;    /**< Nodes frozen for snapshots; each snapshot needs one per node changed or read */
+};
+
+/**
+ * @brief File system image generated at build time by lmkfs
+ *
+ * Every node of the image is constant and lives in .rodata (see RAM_FS_IMAGE), already linked together: directories
+ * point at their files and subdirs, and each file carries its record index and zone map. Index 0 of
+ * dirs is root and index 1 is log_cache. Writing to an image node promotes it to a RAM copy, recorded
+ * in promoted_files or promoted_dirs, which start out zero in .bss.
+ */
+struct ram_fs_image
+{
+    const File *files;            /**< Every file of the image */
+    File **promoted_files;        /**< RAM copy of each file once it has been written, else NULL */
+    uint16_t num_files;           /**< Entries in files and promoted_files */
+    const Directory *dirs;        /**< Every directory of the image, root and log_cache first */
+    Directory **promoted_dirs;    /**< RAM copy of each directory once it has been written, else NULL */
+    uint16_t num_dirs;            /**< Entries in dirs and promoted_dirs */
+};
+
+/**
+ * @brief Reserves every RAM-FS object up front, so the file system never touches the heap again
+ *
+ * One block is allocated here and carved into fixed pools of files, directories, record indexes,
+ * zone maps and sinks; ram_fs_alloc() and ram_fs_free() then only take from and return to those pools.
+ * An exhausted pool fails the allocation instead of falling back to the heap. While a reservation is
+ * in place ram_fs_search() runs on the calling thread, from a file list reserved here as well.
+ *
+ * @param[in] limits Objects to reserve
+ * @return int | 0 for success -1 for failure
+ */
+RAM_FS int ram_fs_reserve(const struct ram_fs_limits *limits);
+
+/**
+ * @brief Returns non-zero while a ram_fs_reserve() reservation is in place
+ *
+ * @return int
+ */
+RAM_FS int ram_fs_reserved(void);
+
+/**
+ * @brief Allocates one RAM-FS object, from the reserved pool of its class when there is one
+ *
+ * @param[in] object Object class
+ * @return void* NULL on failure
+ */
+RAM_FS void *ram_fs_alloc(enum ram_fs_object object);
+
+/**
+ * @brief Releases an object from ram_fs_alloc()
+ *
+ * @param[in] block Object, may be NULL
+ */
+RAM_FS void ram_fs_free(void *block);
+
+/**
+ * @brief Reserved list with room for a pointer to every reserved file, NULL without a reservation
+ *
+ * @param[out] capacity Number of entries
+ * @return File**
+ */
+RAM_FS File **ram_fs_file_list(int *capacity);
+
+/**
+ * @brief Reserves the RAM-FS pools and then initializes the file system
+ *
+ * @param[in] limits Objects to reserve
+ * @return int | 0 for success -1 for failure
+ */
+RAM_FS int init_filesystem_reserved(const struct ram_fs_limits *limits);
+
 /**
  * @brief Initializes the Random Access Memory(RAM) filesystem
  * And creates two directories log_cache and root
@@ -89,6 +242,39 @@ typedef struct Directory
  */
 RAM_FS void init_filesystem(void);
 
+/**
+ * @brief Initializes the file system from an image generated by lmkfs
+ *
+ * root_dir and log_cache are pointed at the image and nothing is allocated or copied, so a device
+ * waking from sleep is logging right away. The first write to a file or directory of the image copies
+ * that one node to RAM, with ram_fs_alloc(), and the copy is used from then on; handles to the image
+ * node stay valid, since every RAM-FS function resolves them through ram_fs_file() and ram_fs_dir().
+ * A reserved file system must leave room in its files and directories pools for those copies.
+ *
+ * @param[in] image Image from the generated source
+ * @return int | 0 for success -1 for failure
+ */
+RAM_FS int init_filesystem_image(const struct ram_fs_image *image);
+
+/**
+ * @brief Returns the current copy of a file
+ *
+ * For a file of the image that has been written this is its RAM copy, otherwise the file itself.
+ * Code reading a File directly, rather than through RAM-FS functions, should read it through this.
+ *
+ * @param[in] file File handle
+ * @return File*
+ */
+RAM_FS File *ram_fs_file(File *file);
+
+/**
+ * @brief Returns the current copy of a directory, see ram_fs_file()
+ *
+ * @param[in] dir Directory handle
+ * @return Directory*
+ */
+RAM_FS Directory *ram_fs_dir(Directory *dir);
+
 /**
  * @brief Deinitializes the Random Access Memory(RAM) filesystem
  * And deletes the main directories log_cache and root
@@ -130,29 +316,161 @@ RAM_FS void append_to_dir(Directory *dir, File *file);
 RAM_FS void ls_dir(Directory *root);
 
 /**
- * @brief Writes to a specific file
+ * @brief Appends data to the end of a file
+ *
+ * Files with RESTRICTED permissions cannot be written. Data that does not fit in
+ * MAX_FILE_CONTENT_LENGTH is rejected as a whole rather than truncated.
  *
  * @param[in] file
  * @param[in] data
+ * @return 0 on success, -1 on failure
  */
-RAM_FS void write_to_file(File *file, const char *data);
+RAM_FS int write_to_file(File *file, const char *data);
 
 /**
- * @brief Inserts specific marker to parse content
+ * @brief Opens a log sink that appends records to a RAM-FS file
+ *
+ * Typically a file created in log_cache. Each record is framed with insert_marker(). Records that
+ * no longer fit in the file are dropped.
  *
- * @param content
- * @return RAM_FS
+ * @param[in] file File to append to
+ * @return struct log_sink* NULL on failure
  */
-RAM_FS int insert_marker(const char *content);
+RAM_FS struct log_sink *log_sink_ram_fs(File *file);
 
 /**
- * @brief Identifies the [*] marker for parsing
- * 
- * @param[in] file File to identify marker
+ * @brief Appends content to a file as one record framed by MARKER
+ *
+ * The markers and the content are copied straight into the file, with no intermediate buffer. If the
+ * file's index is up to date, the new record is added to it as well. Content that itself contains
+ * MARKER is rejected, since it could not be parsed back.
+ *
+ * @param[in] file    File to append to
+ * @param[in] content Record content
+ * @return 0 on success, -1 on failure
+ */
+RAM_FS int insert_marker(File *file, const char *content);
+
+/**
+ * @brief Identifies the [*] markers in a file and indexes its records
+ *
+ * Scans with the log_kernels marker kernel (SSE2/AVX2/NEON where available). Only content appended
+ * since the last call is scanned. Bytes outside a complete MARKER pair are skipped.
+ *
+ * @param[in] file File to index
  * @return 0 on success, -1 on failure
  */
 RAM_FS int identify_marker(File *file);
 
+/**
+ * @brief Returns one record of an indexed file
+ *
+ * @param[in] file    File indexed by identify_marker()
+ * @param[in] record  Record number, from 0 to file->index->num_records - 1
+ * @param[out] length Record length
+ * @return const char* Start of the record inside file->content, NULL if out of range
+ */
+RAM_FS const char *file_record(File *file, int record, size_t *length);
+
+/**
+ * @brief Stores a telemetry block as one base64 record
+ *
+ * RAM-FS content is text, so the block is base64 encoded; a TELEMETRY_BLOCK_BYTES block takes
+ * TELEMETRY_TEXT_LENGTH(TELEMETRY_BLOCK_BYTES) characters plus the markers.
+ *
+ * @param[in] file   File to append to
+ * @param[in] block  Block from telemetry_encoder_finish()
+ * @param[in] length Block length
+ * @return 0 on success, -1 on failure
+ */
+RAM_FS int insert_telemetry_block(File *file, const uint8_t *block, size_t length);
+
+/**
+ * @brief Decodes a record stored with insert_telemetry_block() back into a block
+ *
+ * @param[in]  file     File indexed by identify_marker()
+ * @param[in]  record   Record number
+ * @param[out] block    Output, ready for telemetry_decoder_init()
+ * @param[in]  capacity Size of block
+ * @return long Block length, -1 if the record is missing or is not a telemetry block
+ */
+RAM_FS long file_telemetry_block(File *file, int record, uint8_t *block, size_t capacity);
+
+/**
+ * @brief Takes a consistent view of the whole file system in O(1)
+ *
+ * Nothing is copied up front. RAM-FS only ever appends: file content, record indexes and directory
+ * slots below their current length never change again, so those bytes are shared between the live
+ * tree and every snapshot. The only state a writer touches is the length of a node, and that is what
+ * is copied on write: the first change to a file or directory after a snapshot freezes its old length
+ * in a small reference counted version, shared by all snapshots that saw it. Readers of a snapshot
+ * freeze the nodes they visit the same way, so they see one point in time however long they take.
+ *
+ * Writers never wait for readers. While a snapshot is held, writes take a short lock around the
+ * length update; with none held they run exactly as before. Versions come from the versions pool of a
+ * reservation; if it runs dry the snapshots needing the version are marked lost and their reads fail.
+ *
+ * @return struct ram_fs_snapshot* NULL if RAM_FS_MAX_SNAPSHOTS are held already
+ */
+RAM_FS struct ram_fs_snapshot *ram_fs_snapshot(void);
+
+/**
+ * @brief Releases a snapshot and every version only it still needed
+ *
+ * @param[in] snapshot Snapshot from ram_fs_snapshot(), may be NULL
+ */
+RAM_FS void ram_fs_snapshot_release(struct ram_fs_snapshot *snapshot);
+
+/**
+ * @brief Returns the counts of a directory as of a snapshot
+ *
+ * dir->files and dir->subdirs below the returned counts may be read without further locking.
+ *
+ * @param[in]  snapshot    Snapshot to read
+ * @param[in]  dir         Directory that existed when the snapshot was taken
+ * @param[out] num_files   Files in the directory
+ * @param[out] num_subdirs Subdirectories in the directory
+ * @return int | 0 for success -1 if the directory is not in the snapshot or the snapshot was lost
+ */
+RAM_FS int ram_fs_snapshot_dir(struct ram_fs_snapshot *snapshot, Directory *dir, int *num_files, int *num_subdirs);
+
+/**
+ * @brief Returns the size of a file as of a snapshot
+ *
+ * file->content below the returned size does not change while the snapshot is held.
+ *
+ * @param[in] snapshot Snapshot to read
+ * @param[in] file     File that existed when the snapshot was taken
+ * @return long Size of the content, -1 if the file is not in the snapshot or the snapshot was lost
+ */
+RAM_FS long ram_fs_snapshot_file(struct ram_fs_snapshot *snapshot, File *file);
+
+/**
+ * @brief Indexes the framed records of a file as of a snapshot
+ *
+ * The records are located in the snapshot's content into a caller owned index, leaving file->index
+ * to the writers.
+ *
+ * @param[in]  snapshot Snapshot to read
+ * @param[in]  file     File that existed when the snapshot was taken
+ * @param[out] index    Records of the file, with offsets into file->content
+ * @return long Size of the content, -1 if the file is not in the snapshot or the snapshot was lost
+ */
+RAM_FS long ram_fs_snapshot_index(struct ram_fs_snapshot *snapshot, File *file, RecordIndex *index);
+
+/**
+ * @brief Writes every record below a directory, as of a snapshot, to a log sink
+ *
+ * Framed files are written record by record and other files line by line, each ending in a newline.
+ * The live tree keeps taking appends while the export runs.
+ *
+ * @param[in] snapshot Snapshot to read
+ * @param[in] dir      Directory to walk, including its subdirs; NULL walks root_dir and log_cache
+ * @param[in] sink     Destination, e.g. from log_sink_file()
+ * @return long Number of records written, -1 for failure
+ */
+RAM_FS long ram_fs_snapshot_export(struct ram_fs_snapshot *snapshot, Directory *dir, struct log_sink *sink);
+
 /**
  * @brief Reads from a file
  *
@@ -0,0 +1,202 @@
+/**
+ * @file shm-collector.c
+ * @brief Collector that drains the shared memory log ring into a sink
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+
+/* System includes */
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Local includes */
+#include "log-shm.h"
+#include "log-sink.h"
+
+static volatile sig_atomic_t stop_requested;
+
+static void request_stop(int signal_number)
+{
+    (void)signal_number;
+    stop_requested = 1;
+}
+
+static void usage(const char *program)
+{
+    fprintf(stderr,
+            "Usage: %s [-n shm-name] [-o output-file] [-s slots] [-p poll-ms] [-u]\n"
+            "  -n  Shared memory segment to drain (default %s)\n"
+            "  -o  Append to a file instead of writing to stdout\n"
+            "  -s  INFO lane slots when the segment is created here (default %d)\n"
+            "  -p  Sleep between polls of an empty ring (default 1 ms)\n"
+            "  -u  Remove the segment on exit\n",
+            program, LOG_SHM_DEFAULT_NAME, LOG_SHM_DEFAULT_SLOTS);
+}
+
+/* Writes everything currently published; returns the number of records drained */
+static unsigned long drain(struct log_shm *shm)
+{
+    struct log_shm_slot slot;
+    unsigned long count = 0;
+
+    while (log_shm_consume(shm, &slot))
+    {
+        log_printf_level((enum log_level)slot.level, "[%u] %.*s", (unsigned)slot.pid, (int)slot.length, slot.data);
+        count++;
+    }
+    return count;
+}
+
+static void report_drops(struct log_shm *shm, uint64_t *reported, uint64_t *reported_diverted)
+{
+    uint64_t dropped = __atomic_load_n(&shm->header->dropped, __ATOMIC_RELAXED);
+    uint64_t diverted = __atomic_load_n(&shm->header->diverted, __ATOMIC_RELAXED);
+
+    if (dropped != *reported)
+    {
+        log_printf("lcollect: %llu records dropped by producers (%llu total)\n",
+                   (unsigned long long)(dropped - *reported), (unsigned long long)dropped);
+        *reported = dropped;
+    }
+    if (diverted != *reported_diverted)
+    {
+        log_printf_level(LOG_LEVEL_CRITICAL, "lcollect: %llu CRITICAL records went to producers' stderr (%llu total)\n",
+                         (unsigned long long)(diverted - *reported_diverted), (unsigned long long)diverted);
+        *reported_diverted = diverted;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    const char *name = LOG_SHM_DEFAULT_NAME;
+    const char *output = NULL;
+    unsigned slots = LOG_SHM_DEFAULT_SLOTS;
+    long poll_ms = 1;
+    int unlink_on_exit = 0;
+    int option;
+
+    while ((option = getopt(argc, argv, "n:o:s:p:uh")) != -1)
+    {
+        switch (option)
+        {
+        case 'n':
+            name = optarg;
+            break;
+        case 'o':
+            output = optarg;
+            break;
+        case 's':
+            slots = (unsigned)strtoul(optarg, NULL, 0);
+            break;
+        case 'p':
+            poll_ms = strtol(optarg, NULL, 0);
+            break;
+        case 'u':
+            unlink_on_exit = 1;
+            break;
+        default:
+            usage(argv[0]);
+            return option == 'h' ? 0 : 1;
+        }
+    }
+
+    struct log_shm shm;
+    if (log_shm_attach(name, slots, &shm) == -1)
+    {
+        return 1;
+    }
+
+    struct log_sink *sink = NULL;
+    if (output != NULL)
+    {
+        sink = log_sink_file(output);
+        if (sink == NULL)
+        {
+            log_shm_detach(&shm);
+            return 1;
+        }
+        log_set_sink(sink);
+    }
+
+    /* CRITICAL records are drained first and reach the output before the next one is taken */
+    log_set_sync_level(LOG_LEVEL_CRITICAL);
+
+    struct sigaction action = {.sa_handler = request_stop};
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    __atomic_store_n(&shm.header->collector_pid, (uint32_t)getpid(), __ATOMIC_RELAXED);
+    fprintf(stderr, "lcollect: draining %s (%u INFO, %u WARNING, %u CRITICAL slots)\n", name,
+            (unsigned)shm.header->lanes[LOG_LEVEL_INFO].slot_count, (unsigned)shm.header->lanes[LOG_LEVEL_WARNING].slot_count,
+            (unsigned)shm.header->lanes[LOG_LEVEL_CRITICAL].slot_count);
+
+    struct timespec pause = {.tv_sec = poll_ms / 1000, .tv_nsec = (poll_ms % 1000) * 1000000L};
+    uint64_t reported = __atomic_load_n(&shm.header->dropped, __ATOMIC_RELAXED);
+    uint64_t reported_diverted = __atomic_load_n(&shm.header->diverted, __ATOMIC_RELAXED);
+    unsigned long total = 0;
+
+    while (!stop_requested)
+    {
+        unsigned long count = drain(&shm);
+        total += count;
+        report_drops(&shm, &reported, &reported_diverted);
+        if (count == 0)
+        {
+            log_flush();
+            nanosleep(&pause, NULL);
+        }
+    }
+
+    total += drain(&shm);
+    report_drops(&shm, &reported, &reported_diverted);
+    log_flush();
+
+    __atomic_store_n(&shm.header->collector_pid, 0, __ATOMIC_RELAXED);
+    fprintf(stderr, "lcollect: %lu records collected, %llu dropped, %llu CRITICAL diverted\n", total,
+            (unsigned long long)reported, (unsigned long long)reported_diverted);
+
+    log_set_sink(NULL);
+    log_sink_close(sink);
+    log_shm_detach(&shm);
+    if (unlink_on_exit)
+    {
+        log_shm_unlink(name);
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file trace-replay.c
+ * @brief Replays a captured trace through the logger and reports its cost
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+
+/* System includes */
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Local includes */
+#include "log-sink.h"
+#include "log-trace.h"
+
+static void usage(const char *program)
+{
+    fprintf(stderr,
+            "Usage: %s [-s speed] [-o output-file] trace\n"
+            "  -s  Replay speed: 1 keeps the recorded timing, 0 is as fast as possible (default 0)\n"
+            "  -o  Write the replayed records to a file instead of stdout\n"
+            "Statistics go to stderr, so the replayed output of two builds can be compared with cmp.\n"
+            "Events that differ from the recorded ones are counted; the exit status is 1 only for an unreadable trace.\n",
+            program);
+}
+
+int main(int argc, char **argv)
+{
+    const char *output = NULL;
+    double speed = 0.0;
+    int option;
+
+    while ((option = getopt(argc, argv, "s:o:h")) != -1)
+    {
+        switch (option)
+        {
+        case 's':
+            speed = strtod(optarg, NULL);
+            break;
+        case 'o':
+            output = optarg;
+            break;
+        default:
+            usage(argv[0]);
+            return option == 'h' ? 0 : 1;
+        }
+    }
+    if (optind != argc - 1 || speed < 0)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    struct log_sink *sink = NULL;
+    if (output != NULL)
+    {
+        /* The sink appends, so a replay always starts from an empty file */
+        if (unlink(output) == -1 && errno != ENOENT)
+        {
+            fprintf(stderr, "lreplay: could not replace %s\n", output);
+            return 1;
+        }
+        sink = log_sink_file(output);
+        if (sink == NULL)
+        {
+            return 1;
+        }
+        log_set_sink(sink);
+    }
+
+    struct log_trace_stats stats;
+    int result = log_trace_replay(argv[optind], speed, &stats);
+    log_flush();
+    log_set_sink(NULL);
+    log_sink_close(sink);
+
+    fprintf(stderr, "lreplay: %llu inputs in %.3f ms wall, %.3f ms CPU (%.0f ns CPU per input)\n",
+            (unsigned long long)stats.inputs, stats.wall_ns / 1e6, stats.cpu_ns / 1e6,
+            stats.inputs > 0 ? (double)stats.cpu_ns / stats.inputs : 0.0);
+    fprintf(stderr, "lreplay: %llu recorded events: %llu matched, %llu differ, %llu missing, %llu extra\n",
+            (unsigned long long)stats.events, (unsigned long long)stats.matched, (unsigned long long)stats.mismatched,
+            (unsigned long long)stats.missing, (unsigned long long)stats.extra);
+    return result == -1 ? 1 : 0;
+}
@@ -0,0 +1,37 @@
+#include "../../../src/common/logger.h"
+#include "../../../src/dwt-profile.h"
+
+#define MODULE_NAME "EATL-KERNEL"
+#define ITERATIONS 100
+
+void call_custom_callback(const char *message);
+
+int main(void)
+{
+    struct log_module module =
+        {
+            .module_name = MODULE_NAME,
+            .callback = call_custom_callback,
+        };
+
+    dwt_profile_init();
+
+    for (int i = 0; i < ITERATIONS; i++)
+    {
+        LOG_MSG(INFO, "Example of LOG MESSAGE macro");
+        LOG_WARNING(WARNING, "Example of LOG WARNING macro");
+        LOG_ERROR(CRITICAL, "Example of LOG ERROR macro");
+
+        perform_calculation(&module, 250000, 500000); /* Exceeds the maximum threshold */
+        perform_calculation(&module, 1, 11);          /* Within both thresholds */
+    }
+
+    dwt_profile_report();
+
+    return 0x000;
+}
+
+void call_custom_callback(const char *message)
+{
+    printf("%s: Callback message: %s\n", MODULE_NAME, message);
+}
@@ -0,0 +1,380 @@
+/**
+ * @file alloc-audit.c
+ * @brief Fails when logging or RAM-FS allocates after init
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+
+/* System includes */
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Local includes */
+#include "../../src/common/logger.h"
+#include "../../src/log-aggregate.h"
+#include "../../src/log-sample.h"
+#include "../../src/log-stage.h"
+#include "../../src/log-telemetry.h"
+#include "../../src/ram-fs.h"
+#include "../../src/ram-fs-search.h"
+#include "../../src/ram-fs-zone.h"
+
+#define AUDIT_THREADS 4
+#define AUDIT_ITERATIONS 2000
+#define AUDIT_RECORDS 32
+#define AUDIT_SINK_RECORDS 8
+#define MODULE_NAME "ALLOC-AUDIT"
+
+/* glibc's own allocator, which the interposed functions below forward to */
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *block, size_t size);
+extern void *__libc_memalign(size_t alignment, size_t size);
+extern void __libc_free(void *block);
+
+static volatile int armed;
+static unsigned long allocations;
+
+/* Reports an allocation made while armed; write() since stdio itself may allocate */
+static void audit_allocation(const char *function, size_t size)
+{
+    char line[96];
+    char digits[24];
+    size_t length = 0;
+    int count = 0;
+
+    if (!armed)
+    {
+        return;
+    }
+    __atomic_add_fetch(&allocations, 1, __ATOMIC_RELAXED);
+    do
+    {
+        digits[count++] = (char)('0' + size % 10);
+        size /= 10;
+    } while (size > 0);
+
+    length = strlen(function);
+    memcpy(line, "alloc-audit: ", 13);
+    memcpy(line + 13, function, length);
+    length += 13;
+    memcpy(line + length, "(", 1);
+    length++;
+    while (count > 0)
+    {
+        line[length++] = digits[--count];
+    }
+    memcpy(line + length, ") after init\n", 13);
+    length += 13;
+    if (write(STDERR_FILENO, line, length) < 0)
+    {
+        return;
+    }
+}
+
+void *malloc(size_t size)
+{
+    audit_allocation("malloc", size);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size)
+{
+    audit_allocation("calloc", count * size);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *block, size_t size)
+{
+    audit_allocation("realloc", size);
+    return __libc_realloc(block, size);
+}
+
+void *memalign(size_t alignment, size_t size)
+{
+    audit_allocation("memalign", size);
+    return __libc_memalign(alignment, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size)
+{
+    audit_allocation("aligned_alloc", size);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **block, size_t alignment, size_t size)
+{
+    audit_allocation("posix_memalign", size);
+    *block = __libc_memalign(alignment, size);
+    return *block == NULL ? 12 /* ENOMEM */ : 0;
+}
+
+void *valloc(size_t size)
+{
+    audit_allocation("valloc", size);
+    return __libc_memalign((size_t)sysconf(_SC_PAGESIZE), size);
+}
+
+void *pvalloc(size_t size)
+{
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+
+    audit_allocation("pvalloc", size);
+    return __libc_memalign(page, (size + page - 1) & ~(page - 1));
+}
+
+void free(void *block)
+{
+    __libc_free(block);
+}
+
+static pthread_barrier_t start_barrier;
+
+static void count_event(const char *message)
+{
+    (void)message;
+}
+
+static void count_match(const File *file, const char *record, size_t length, void *context)
+{
+    (void)file;
+    (void)record;
+    (void)length;
+    (*(long *)context)++;
+}
+
+static void count_record(const File *file, uint64_t timestamp, enum log_level level, const char *message,
+                         size_t length, void *context)
+{
+    (void)file;
+    (void)timestamp;
+    (void)level;
+    (void)message;
+    (void)length;
+    (*(long *)context)++;
+}
+
+static void drop_block(const uint8_t *block, size_t length, void *context)
+{
+    (void)block;
+    *(size_t *)context += length;
+}
+
+/* Worker threads are created during init, since pthread_create allocates, and log once armed */
+static void *stage_worker(void *argument)
+{
+    unsigned id = (unsigned)(uintptr_t)argument;
+
+    pthread_barrier_wait(&start_barrier);
+    for (int i = 0; i < AUDIT_ITERATIONS; i++)
+    {
+        log_printf("worker %u record %d\n", id, i);
+    }
+    pthread_barrier_wait(&start_barrier);
+    return NULL;
+}
+
+int main(void)
+{
+    /* Odd counts, so that unpadded pools would leave the later ones misaligned */
+    const struct ram_fs_limits limits = {
+        .files = 3,
+        .directories = 3,
+        .sinks = 1,
+        .versions = 3,
+    };
+    pthread_t workers[AUDIT_THREADS];
+
+    /* Init: everything that may allocate happens here */
+    /* One thread short, so one of them logs without a staging buffer rather than allocating one */
+    if (log_init_reserved(AUDIT_THREADS) == -1 || init_filesystem_reserved(&limits) == -1)
+    {
+        fprintf(stderr, "alloc-audit: init failed\n");
+        return 1;
+    }
+    log_sample_configure(100, 100, NULL, 0);
+    pthread_barrier_init(&start_barrier, NULL, AUDIT_THREADS + 1);
+    for (unsigned i = 0; i < AUDIT_THREADS; i++)
+    {
+        if (pthread_create(&workers[i], NULL, stage_worker, (void *)(uintptr_t)i) != 0)
+        {
+            fprintf(stderr, "alloc-audit: could not start worker %u\n", i);
+            return 1;
+        }
+    }
+    if (log_stage_start(10) == -1)
+    {
+        return 1;
+    }
+
+    struct log_aggregate aggregate;
+    struct log_thresholds thresholds;
+    struct log_module module = {
+        .module_name = MODULE_NAME,
+        .callback = count_event,
+    };
+    struct telemetry_channel channel;
+    size_t telemetry_bytes = 0;
+    if (log_aggregate_init(&aggregate, 64, 0, NULL, NULL, NULL) == -1 ||
+        log_thresholds_init(&thresholds, CALCULATION_MINIMUM, CALCULATION_MAXIMUM, 100, LOG_TRIGGER_EDGE) == -1 ||
+        telemetry_channel_init(&channel, TELEMETRY_INTEGER, drop_block, &telemetry_bytes) == -1)
+    {
+        return 1;
+    }
+
+    /* Steady state: nothing below may touch the heap */
+    armed = 1;
+
+    pthread_barrier_wait(&start_barrier);
+    for (int i = 0; i < AUDIT_ITERATIONS; i++)
+    {
+        LOG_MSG(MODULE_NAME, "steady state message");
+        LOG_WARNING(MODULE_NAME, "steady state warning");
+        log_printf("main record %d of %d\n", i, AUDIT_ITERATIONS);
+
+        module.aggregate = &aggregate;
+        perform_calculation(&module, i, i);
+        module.aggregate = NULL;
+        module.thresholds = &thresholds;
+        perform_calculation(&module, CALCULATION_MAXIMUM + (i % 2 ? 200 : -200), 1);
+        module.thresholds = NULL;
+        module.sample_budget = 10;
+        perform_calculation(&module, CALCULATION_MAXIMUM, 2);
+        module.sample_budget = 0;
+
+        telemetry_log_integer(&channel, (uint64_t)i, i * 3);
+    }
+    pthread_barrier_wait(&start_barrier);
+    log_aggregate_flush(&module);
+    telemetry_channel_flush(&channel);
+    LOG_ERROR(MODULE_NAME, "steady state error");
+    log_stage_flush();
+
+    File *file = create_file("audit.log", "", AVAILABLE);
+    if (file == NULL)
+    {
+        armed = 0;
+        return 1;
+    }
+    append_to_dir(log_cache, file);
+    struct ram_fs_snapshot *snapshot = NULL;
+    for (int i = 0; i < AUDIT_RECORDS; i++)
+    {
+        if (i == 24)
+        {
+            snapshot = ram_fs_snapshot();
+        }
+        append_log_record(file, i % 4 ? LOG_LEVEL_INFO : LOG_LEVEL_CRITICAL, (uint64_t)i, "audited record");
+    }
+    long records = 0;
+    query_log_cache(0, UINT64_MAX, LOG_LEVEL_BIT(LOG_LEVEL_CRITICAL), count_record, &records);
+
+    const struct ram_fs_query query = {
+        .pattern = "audited",
+        .level = NULL,
+        .module = NULL,
+    };
+    long matches = 0;
+    ram_fs_search(NULL, &query, count_match, &matches);
+
+    /* The snapshot taken after 24 records still sees only those */
+    long frozen = 0;
+    if (ram_fs_search_snapshot(snapshot, log_cache, &query, count_match, &frozen) != 24)
+    {
+        fprintf(stderr, "alloc-audit: snapshot saw %ld records\n", frozen);
+        armed = 0;
+        return 1;
+    }
+    ram_fs_snapshot_release(snapshot);
+
+    File *sink_file = create_file("sink.log", "", AVAILABLE);
+    struct log_sink *sink = sink_file != NULL ? log_sink_ram_fs(sink_file) : NULL;
+    if ((uintptr_t)file % _Alignof(max_align_t) != 0 || (uintptr_t)file->index % _Alignof(max_align_t) != 0 ||
+        (uintptr_t)file->zones % _Alignof(max_align_t) != 0 || (uintptr_t)sink % _Alignof(max_align_t) != 0)
+    {
+        fprintf(stderr, "alloc-audit: misaligned RAM-FS object\n");
+        armed = 0;
+        return 1;
+    }
+    if (sink != NULL)
+    {
+        append_to_dir(log_cache, sink_file);
+        log_set_sink(sink);
+        for (int i = 0; i < AUDIT_SINK_RECORDS; i++)
+        {
+            LOG_MSG(MODULE_NAME, "into the RAM-FS sink");
+        }
+        log_stage_flush();
+        log_set_sink(NULL);
+        log_sink_close(sink);
+    }
+    /* Staged records reach the sink one write each, so each stays its own RAM-FS record */
+    const struct ram_fs_query sink_query = {
+        .pattern = "into the RAM-FS sink",
+        .level = NULL,
+        .module = NULL,
+    };
+    long sunk = 0;
+    ram_fs_search(NULL, &sink_query, count_match, &sunk);
+
+    armed = 0;
+
+    for (unsigned i = 0; i < AUDIT_THREADS; i++)
+    {
+        pthread_join(workers[i], NULL);
+    }
+    log_stage_stop();
+    printf("alloc-audit: %ld critical records, %ld search matches, %zu telemetry bytes\n", records, matches,
+           telemetry_bytes);
+    if (allocations > 0)
+    {
+        printf("alloc-audit: FAILED, %lu allocations after init\n", allocations);
+        return 1;
+    }
+    if (records != AUDIT_RECORDS / 4 || matches != AUDIT_RECORDS || sunk != AUDIT_SINK_RECORDS)
+    {
+        printf("alloc-audit: FAILED, expected %d critical records, %d search matches and %d sink records\n",
+               AUDIT_RECORDS / 4, AUDIT_RECORDS, AUDIT_SINK_RECORDS);
+        return 1;
+    }
+    printf("alloc-audit: passed, no allocations after init\n");
+    deinit_filesystem();
+    return 0;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file sample-check.c
+ * @brief Checks that modules sampled on one thread keep their own rate, colliding or not
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* System includes */
+#include <stdint.h>
+#include <stdio.h>
+
+/* Local includes */
+#include "../../src/log-sample.h"
+
+#define CHECK_CALLS 2000000 /* Calls per module */
+#define CHECK_BUDGET 100    /* Records per second per module */
+#define CHECK_CALL_NS 1000  /* Simulated time between two calls */
+#define CHECK_LIMIT 2000    /* A run of two modules simulates 4 s, so about 400 records each within budget */
+
+/* Module keys 256 bytes apart, so they land on the same home site */
+static unsigned char modules[LOG_SAMPLE_MODULE_SITES + 1][256];
+
+static uint64_t now_ns;
+
+/* Deterministic clock, advanced by the checks rather than by the wall */
+static uint64_t check_clock(void)
+{
+    return now_ns;
+}
+
+/* Interleaves calls from the given modules and returns how many of them were emitted in total */
+static unsigned long run_modules(unsigned first, unsigned count, unsigned long emitted[])
+{
+    unsigned long total = 0;
+
+    for (unsigned i = 0; i < count; i++)
+    {
+        emitted[i] = 0;
+    }
+    for (unsigned long call = 0; call < CHECK_CALLS; call++)
+    {
+        for (unsigned i = 0; i < count; i++)
+        {
+            now_ns += CHECK_CALL_NS;
+            if (log_sample(log_sample_module_site(modules[first + i]), CHECK_BUDGET) > 0)
+            {
+                emitted[i]++;
+                total++;
+            }
+        }
+    }
+    return total;
+}
+
+int main(void)
+{
+    unsigned long emitted[2];
+    int failed = 0;
+
+    now_ns = 1;
+    if (log_sample_configure(CHECK_BUDGET, LOG_SAMPLE_DEFAULT_WINDOW_MS, check_clock, 1000000000ULL) == -1)
+    {
+        return 1;
+    }
+
+    /* Two colliding modules logging alternately each get their own site */
+    if (log_sample_module_site(modules[0]) == log_sample_module_site(modules[1]))
+    {
+        printf("sample-check: FAILED, colliding modules share a site while the table has room\n");
+        failed = 1;
+    }
+    run_modules(0, 2, emitted);
+    for (unsigned i = 0; i < 2; i++)
+    {
+        printf("sample-check: colliding module %u emitted %lu of %d calls\n", i, emitted[i], CHECK_CALLS);
+        if (emitted[i] == 0 || emitted[i] > CHECK_LIMIT)
+        {
+            printf("sample-check: FAILED, expected 1 to %d\n", CHECK_LIMIT);
+            failed = 1;
+        }
+    }
+
+    /* With every site taken, a further module shares one and is still sampled */
+    for (unsigned i = 2; i < LOG_SAMPLE_MODULE_SITES; i++)
+    {
+        log_sample_module_site(modules[i]);
+    }
+    run_modules(0, 2, emitted);
+    unsigned long shared = run_modules(LOG_SAMPLE_MODULE_SITES - 1, 2, emitted);
+    printf("sample-check: modules sharing a site emitted %lu of %d calls\n", shared, 2 * CHECK_CALLS);
+    if (shared == 0 || shared > CHECK_LIMIT)
+    {
+        printf("sample-check: FAILED, expected 1 to %d\n", CHECK_LIMIT);
+        failed = 1;
+    }
+
+    if (failed)
+    {
+        return 1;
+    }
+    printf("sample-check: passed\n");
+    return 0;
+}
@@ -0,0 +1,245 @@
+/**
+ * @file logger-cpp.cpp
+ * @brief Checks the C++ front end against snprintf and through a sink
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* System includes */
+#include <cstdio>
+#include <cstring>
+
+/* Local includes */
+#include "../../src/common/logger.hpp"
+
+/* Bounds and lengths are constant expressions, so these are checked by the compiler */
+static_assert(eatl::record_bound<"x=%d\n", int> == 3 + 11);
+static_assert(eatl::record_bound<"%08x", unsigned> == 8);
+static_assert(eatl::record_bound<"%lld", long long> == 21);
+static_assert(eatl::record_bound<"[%.3s]", const char *> == 5);
+static_assert(eatl::record_bound<"%s", const char *> == 0);
+static_assert(eatl::record_bound<"%-12c|", char> == 13);
+static_assert(eatl::record_size<"x=%d\n">(42) == 5);
+static_assert(eatl::record_size<"%5d|%-5u|">(-7, 7u) == 12);
+static_assert(eatl::record_size<"%s and %.2s %%">("abc", "defg") == 12);
+static_assert(eatl::record_size<"%llx">(0xFFFFFFFFFFULL) == 10);
+
+#ifdef EATL_CPP_BAD_FORMAT
+/* Only built to check that it fails to: %d does not take a string */
+static std::size_t bad_format = eatl::record_size<"%d">("text");
+#endif
+
+static int failures;
+
+/* The front end must produce exactly what snprintf produces for the same format and arguments */
+template <eatl::format_string Format, typename... Args>
+static void check_format(const Args &...args)
+{
+    char expected[256];
+    char actual[256];
+
+    int expected_length = std::snprintf(expected, sizeof(expected), Format.text, args...);
+    std::size_t length = eatl::format_to<Format>(actual, sizeof(actual), args...);
+    std::size_t size = eatl::record_size<Format>(args...);
+    constexpr std::size_t bound = eatl::record_bound<Format, Args...>;
+
+    if (length != (std::size_t)expected_length || size != length || std::memcmp(actual, expected, length) != 0 ||
+        (bound > 0 && length > bound))
+    {
+        std::printf("logger-cpp: \"%s\" gave \"%.*s\" (%zu bytes), snprintf \"%s\"\n", Format.text, (int)length,
+                    actual, length, expected);
+        failures++;
+    }
+}
+
+/* Sink that keeps every record, with its level, in a buffer */
+struct capture
+{
+    char data[1024];
+    std::size_t used;
+    int records;
+    log_level last_level;
+};
+
+static int capture_write_level(struct log_sink *sink, enum log_level level, const char *data, std::size_t length)
+{
+    capture *kept = static_cast<capture *>(sink->context);
+
+    if (kept->used + length > sizeof(kept->data))
+    {
+        return -1;
+    }
+    std::memcpy(kept->data + kept->used, data, length);
+    kept->used += length;
+    kept->records++;
+    kept->last_level = level;
+    return 0;
+}
+
+static int capture_write(struct log_sink *sink, const char *data, std::size_t length)
+{
+    return capture_write_level(sink, LOG_LEVEL_INFO, data, length);
+}
+
+static int capture_flush(struct log_sink *sink)
+{
+    (void)sink;
+    return 0;
+}
+
+static void expect_record(const capture &kept, std::size_t from, const char *record, log_level level)
+{
+    std::size_t length = std::strlen(record);
+
+    if (kept.used - from != length || std::memcmp(kept.data + from, record, length) != 0 || kept.last_level != level)
+    {
+        std::printf("logger-cpp: sink got \"%.*s\" at level %d, expected \"%s\" at level %d\n",
+                    (int)(kept.used - from), kept.data + from, (int)kept.last_level, record, (int)level);
+        failures++;
+    }
+}
+
+static char event_text[MAX_LOG_MESSAGE_LENGTH];
+static long events;
+static long sampled_events;
+
+static void keep_event(const char *message)
+{
+    std::snprintf(event_text, sizeof(event_text), "%s", message);
+    events++;
+    if (std::strstr(message, " [sampled 1/") != nullptr)
+    {
+        sampled_events++;
+    }
+}
+
+int main()
+{
+    int value = -1234;
+    const void *pointer = &value;
+
+    check_format<"plain text\n">();
+    check_format<"%d %i %u">(value, 42, 42u);
+    check_format<"%5d|%-5d|%05d">(value, 7, -7);
+    check_format<"%x %X %08x %-8X|">(0xBEEFu, 0xBEEFu, 0x1Fu, 0xABu);
+    check_format<"%hhd %hd %ld %lld %zu">((signed char)-5, (short)-300, -70000L, -9000000000LL, sizeof(capture));
+    check_format<"%hhu %hu %lu %llu %llx">((unsigned char)250, (unsigned short)65000, 4000000000UL,
+                                           18446744073709551615ULL, 18446744073709551615ULL);
+    check_format<"%f %.2f %10.3f %-10.1f| %010.4f">(3.14159, -2.5, 1e6, 0.05, -1.5);
+    check_format<"%s|%.2s|%8s|%-8s|%.0s">("sensor", "sensor", "abc", "abc", "gone");
+    check_format<"%c%c %3c %-3c|">('o', 'k', 'x', 'y');
+    check_format<"%p">(pointer);
+    check_format<"100%% %d%%">(99);
+
+    /* Truncation keeps counting, so the full length is still returned */
+    char small[8];
+    std::size_t length = eatl::format_to<"value %d\n">(small, sizeof(small), 123456);
+    if (length != 13 || std::memcmp(small, "value 1", 7) != 0)
+    {
+        std::printf("logger-cpp: truncated format_to returned %zu\n", length);
+        failures++;
+    }
+
+    capture kept{};
+    struct log_sink sink = {
+        .name = "capture",
+        .write = capture_write,
+        .write_level = capture_write_level,
+        .flush = capture_flush,
+        .close = nullptr,
+        .colorize = 1,
+        .context = &kept,
+    };
+    log_set_sink(&sink);
+
+    std::size_t from = kept.used;
+    eatl::log<"sensor %s read %.2f after %u retries\n">("temp", 21.5, 3u);
+    expect_record(kept, from, "sensor temp read 21.50 after 3 retries\n", LOG_LEVEL_INFO);
+
+    from = kept.used;
+    eatl::message<"x=%d">("CPP", 7);
+    expect_record(kept, from, "CPP " BBLU "LOG" RESET_TEXT ": " BWHT "x=7" RESET_TEXT "\n", LOG_LEVEL_INFO);
+
+    from = kept.used;
+    eatl::warning<"%s">("CPP", "hot");
+    expect_record(kept, from, "CPP " BYEL "LOG" RESET_TEXT ": " BWHT "hot" RESET_TEXT "\n", LOG_LEVEL_WARNING);
+
+    from = kept.used;
+    eatl::error<"%03d">("CPP", 5);
+    expect_record(kept, from, "CPP " BRED "LOG" RESET_TEXT ": " BWHT "005" RESET_TEXT "\n", LOG_LEVEL_CRITICAL);
+
+    /* Events go to the module's callback, or are logged with the module name without one */
+    struct log_module module = {};
+    module.module_name = "CPP-MODULE";
+    module.callback = keep_event;
+    eatl::event<"reading %d out of range\n">(&module, 900);
+    if (std::strcmp(event_text, "reading 900 out of range\n") != 0)
+    {
+        std::printf("logger-cpp: callback got \"%s\"\n", event_text);
+        failures++;
+    }
+
+    /* A module over its sample budget gets 1 in N events, tagged like those of perform_calculation() */
+    module.sample_budget = 10;
+    events = 0;
+    long calls = 0;
+    while (sampled_events == 0 && calls < 10000000)
+    {
+        eatl::event<"burst %ld\n">(&module, calls++);
+    }
+    module.sample_budget = 0;
+    if (sampled_events == 0 || events > calls / 100)
+    {
+        std::printf("logger-cpp: %ld of %ld events delivered, %ld tagged as sampled\n", events, calls, sampled_events);
+        failures++;
+    }
+
+    module.callback = nullptr;
+    from = kept.used;
+    eatl::event<"unseen %d\n">(&module, 1);
+    expect_record(kept, from, "CPP-MODULE: An event occured \n", LOG_LEVEL_INFO);
+
+    log_set_sink(nullptr);
+    if (kept.records != 5)
+    {
+        std::printf("logger-cpp: sink got %d records, expected 5\n", kept.records);
+        failures++;
+    }
+    if (failures > 0)
+    {
+        std::printf("logger-cpp: FAILED, %d checks\n", failures);
+        return 1;
+    }
+    std::printf("logger-cpp: passed\n");
+    return 0;
+}
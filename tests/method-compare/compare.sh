@@ -0,0 +1,100 @@
+#!/bin/sh
+#
+# Builds every logging method in release configuration and compares them on one workload:
+# code and data size per section (lsize -s), peak RSS (return_linux_memory_usage()) and
+# per-message latency and throughput. Run through `make compare`, which passes the source lists.
+#
+# METHODS    Methods to compare; each is a build of method-bench.c with -DEATL_BENCH_<METHOD>
+# MESSAGES   Messages per run (default 200000)
+# RUNS       Runs per method, the fastest is kept (default 3)
+# BUILD      Output directory (default tests/method-compare/build)
+
+set -eu
+
+: "${MACRO_SRCS:?run through make compare}"
+: "${EVT_SRCS:?run through make compare}"
+: "${BENCH_SRCS:?run through make compare}"
+: "${LSIZE_SRCS:?run through make compare}"
+
+CC=${CC:-gcc}
+RELEASE_CFLAGS=${RELEASE_CFLAGS:-"-O2 -DNDEBUG -std=c11"}
+# Benches link the whole library; unreferenced functions and data are dropped so the sizes are the method's
+SECTION_GC="-ffunction-sections -fdata-sections -Wl,--gc-sections"
+METHODS=${METHODS:-"macro event staged"}
+MESSAGES=${MESSAGES:-200000}
+RUNS=${RUNS:-3}
+BUILD=${BUILD:-tests/method-compare/build}
+REPORT=$BUILD/report.txt
+HERE=$(dirname "$0")
+
+mkdir -p "$BUILD"
+
+# Release builds, kept apart from the debug objects of the other targets
+$CC $RELEASE_CFLAGS $LSIZE_SRCS -o "$BUILD/lsize"
+$CC $RELEASE_CFLAGS $MACRO_SRCS -o "$BUILD/LIN_nrf-generic" -lpthread
+$CC $RELEASE_CFLAGS $EVT_SRCS -o "$BUILD/LIN_nrf-event-driven" -lpthread
+for method in $METHODS; do
+    define=$(echo "$method" | tr '[:lower:]' '[:upper:]')
+    $CC $RELEASE_CFLAGS $SECTION_GC "-DEATL_BENCH_$define" "$HERE/method-bench.c" $BENCH_SRCS -o "$BUILD/bench-$method" \
+        -lpthread
+done
+
+# Value of one class from the "Totals:" line of lsize -s
+class_size() {
+    "$BUILD/lsize" -s "$1" | sed -n "s/^Totals:.* $2 \([0-9]*\).*/\1/p"
+}
+
+# Value of a key=value line of a bench run
+bench_value() {
+    sed -n "s/^$2=//p" "$1"
+}
+
+{
+    echo "Logging method comparison, $MESSAGES messages per run, best of $RUNS, built with $RELEASE_CFLAGS"
+    echo "Host: $(uname -srm)"
+    echo
+    printf '%-8s %8s %8s %7s %7s %8s %11s %8s %8s %9s %10s\n' method code rodata data bss rss_kb msgs/s \
+        p50_ns p99_ns p99.9_ns max_ns
+    for method in $METHODS; do
+        binary=$BUILD/bench-$method
+        best=""
+        run=0
+        while [ "$run" -lt "$RUNS" ]; do
+            "$binary" "$MESSAGES" > "$BUILD/run-$method.txt"
+            throughput=$(bench_value "$BUILD/run-$method.txt" throughput)
+            if [ -z "$best" ] || [ "$throughput" -gt "$(bench_value "$BUILD/best-$method.txt" throughput)" ]; then
+                cp "$BUILD/run-$method.txt" "$BUILD/best-$method.txt"
+                best=$throughput
+            fi
+            run=$((run + 1))
+        done
+        result=$BUILD/best-$method.txt
+        rss=$(sed -n 's/^Maximum resident set size: \([0-9]*\).*/\1/p' "$result")
+        printf '%-8s %8s %8s %7s %7s %8s %11s %8s %8s %9s %10s\n' "$method" \
+            "$(class_size "$binary" code)" "$(class_size "$binary" rodata)" \
+            "$(class_size "$binary" data)" "$(class_size "$binary" bss)" "$rss" \
+            "$(bench_value "$result" throughput)" "$(bench_value "$result" latency_p50_ns)" \
+            "$(bench_value "$result" latency_p99_ns)" "$(bench_value "$result" latency_p999_ns)" \
+            "$(bench_value "$result" latency_max_ns)"
+    done
+    echo
+    echo "Every method writes the same records; staged ones reach the sink grouped by severity."
+    echo "Bench sizes are linked with --gc-sections, so only the code and data a method reaches count."
+    echo "Latencies are the lower bound of their log-linear bucket (within 25%)."
+    echo
+    echo "Example programs:"
+    for program in LIN_nrf-generic LIN_nrf-event-driven; do
+        printf '  %-22s code %s, rodata %s, data %s, bss %s bytes\n' "$program" \
+            "$(class_size "$BUILD/$program" code)" "$(class_size "$BUILD/$program" rodata)" \
+            "$(class_size "$BUILD/$program" data)" "$(class_size "$BUILD/$program" bss)"
+    done
+    echo
+    for method in $METHODS; do
+        "$BUILD/lsize" -s "$BUILD/bench-$method"
+        echo
+    done
+} > "$REPORT"
+
+# The table goes to the terminal, the per-section listings only to the report
+sed -n '1,/^Example programs:/p' "$REPORT" | sed '$d'
+echo "Full report with every section: $REPORT"
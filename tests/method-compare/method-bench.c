@@ -0,0 +1,209 @@
+/**
+ * @file method-bench.c
+ * @brief Runs one logging method over the shared comparison workload
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+
+/* System includes */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Local includes */
+#include "../../src/common/logger.h"
+#include "../../src/log-aggregate.h"
+#include "../../src/log-stage.h"
+
+/* One method per build: EATL_BENCH_MACRO, EATL_BENCH_EVENT or EATL_BENCH_STAGED */
+#if defined(EATL_BENCH_MACRO)
+#define BENCH_METHOD "macro"
+#elif defined(EATL_BENCH_EVENT)
+#define BENCH_METHOD "event"
+#elif defined(EATL_BENCH_STAGED)
+#define BENCH_METHOD "staged"
+#else
+#error "Define EATL_BENCH_MACRO, EATL_BENCH_EVENT or EATL_BENCH_STAGED"
+#endif
+
+#define MODULE_NAME "EATL-BENCH"
+#define DEFAULT_MESSAGES 200000
+
+static uint64_t now_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+/* Both methods write one record per calculation, formatted by the same macros for the same band */
+static void log_band(const char *band)
+{
+    if (strcmp(band, "Calculation exceeds threshold\n") == 0)
+    {
+        LOG_WARNING(MODULE_NAME, "Calculation exceeds threshold");
+    }
+    else if (strcmp(band, "Calculation falls below threshold\n") == 0)
+    {
+        LOG_ERROR(MODULE_NAME, "Calculation falls below threshold");
+    }
+    else
+    {
+        LOG_MSG(MODULE_NAME, "Calculation falls between both thresholds");
+    }
+}
+
+#ifdef EATL_BENCH_EVENT
+
+/* The event method gets the band from perform_calculation() */
+static void bench_callback(const char *message)
+{
+    log_band(message);
+}
+
+#else
+
+/* The macro method checks the thresholds at the call site, as perform_calculation() does */
+static void log_calculation(long long a, long long b)
+{
+    long long result = a * b;
+
+    if (result > CALCULATION_MAXIMUM)
+    {
+        log_band("Calculation exceeds threshold\n");
+    }
+    else if (result < CALCULATION_MINIMUM)
+    {
+        log_band("Calculation falls below threshold\n");
+    }
+    else if (result > CALCULATION_MINIMUM && result < CALCULATION_MAXIMUM)
+    {
+        log_band("Calculation falls between both thresholds\n");
+    }
+    else
+    {
+        /* A result on a threshold is not an event; perform_calculation() logs it directly */
+        log_printf("Result is within both thresholds (result: %lld)\n", result);
+    }
+}
+
+#endif
+
+int main(int argc, char **argv)
+{
+    long messages = argc > 1 ? strtol(argv[1], NULL, 10) : DEFAULT_MESSAGES;
+    const char *output = argc > 2 ? argv[2] : "/dev/null";
+    struct log_aggregate_summary latency = {0};
+    uint64_t random = 0x9E3779B97F4A7C15ULL;
+
+    if (messages <= 0)
+    {
+        fprintf(stderr, "Usage: %s [messages] [output]\n", argv[0]);
+        return 1;
+    }
+
+    /* Every method writes the same records, byte for byte, to the same kind of sink */
+    struct log_sink *sink = log_sink_file(output);
+    if (sink == NULL)
+    {
+        return 1;
+    }
+    log_set_sink(sink);
+#ifdef EATL_BENCH_STAGED
+    if (log_stage_start(10) == -1)
+    {
+        return 1;
+    }
+#endif
+#ifdef EATL_BENCH_EVENT
+    struct log_module module = {
+        .module_name = MODULE_NAME,
+        .callback = bench_callback,
+    };
+#endif
+
+    uint64_t start = now_ns();
+    for (long i = 0; i < messages; i++)
+    {
+        /* The same sequence for every method: mostly in range, some above and below the thresholds */
+        random ^= random << 13;
+        random ^= random >> 7;
+        random ^= random << 17;
+        long long a = (long long)(random % 1000);
+        long long b = (long long)((random >> 20) % 150);
+
+        uint64_t before = now_ns();
+#ifdef EATL_BENCH_EVENT
+        perform_calculation(&module, a, b);
+#else
+        log_calculation(a, b);
+#endif
+        long long elapsed = (long long)(now_ns() - before);
+
+        if (latency.count == 0 || elapsed < latency.min)
+        {
+            latency.min = elapsed;
+        }
+        if (elapsed > latency.max)
+        {
+            latency.max = elapsed;
+        }
+        latency.count++;
+        latency.histogram[log_aggregate_bucket(elapsed)]++;
+    }
+#ifdef EATL_BENCH_STAGED
+    /* Staged records only count once they have reached the sink */
+    log_stage_stop();
+#endif
+    log_flush();
+    uint64_t total = now_ns() - start;
+
+    log_set_sink(NULL);
+    log_sink_close(sink);
+
+    printf("method=%s\n", BENCH_METHOD);
+    printf("messages=%ld\n", messages);
+    printf("elapsed_ns=%llu\n", (unsigned long long)total);
+    printf("throughput=%.0f\n", (double)messages * 1e9 / (double)total);
+    printf("latency_p50_ns=%lld\n", log_aggregate_percentile(&latency, 50.0));
+    printf("latency_p99_ns=%lld\n", log_aggregate_percentile(&latency, 99.0));
+    printf("latency_p999_ns=%lld\n", log_aggregate_percentile(&latency, 99.9));
+    printf("latency_max_ns=%lld\n", latency.max);
+    return_linux_memory_usage();
+    return 0;
+}
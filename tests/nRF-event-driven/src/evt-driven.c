@@ -1,5 +1,9 @@
 #include "../../../src/common/logger.h"
+#include "../../../src/log-aggregate.h"
+#include "../../../src/log-telemetry.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -7,19 +11,71 @@
 #endif
 #ifdef __linux__
 #include <sys/resource.h>
+#include <unistd.h>
+#include "../../../src/log-ring.h"
+#include "../../../src/log-shm.h"
+#include "../../../src/log-stage.h"
+#include "../../../src/log-trace.h"
+#include "load-gen.h"
 #endif
 
 #define MODULE_NAME "EATL-KERNEL"
 
 void call_custom_callback(const char *message);
+static void print_telemetry_block(const uint8_t *block, size_t length, void *context);
+
+static void print_telemetry_block(const uint8_t *block, size_t length, void *context)
+{
+    struct telemetry_decoder decoder;
+    uint64_t timestamp;
+    union telemetry_value value;
+
+    (void)context;
+    if (telemetry_decoder_init(&decoder, block, length) == -1)
+    {
+        return;
+    }
+    printf("Telemetry block: %u results in %u bytes:", (unsigned)decoder.count, (unsigned)length);
+    while (telemetry_decoder_next(&decoder, &timestamp, &value) == 1)
+    {
+        printf(" %lld", value.int_data);
+    }
+    printf("\n");
+}
+
+#ifdef __linux__
+static void print_recovered(uint64_t sequence, const char *data, size_t length, void *context);
+#endif
 
 extern long long get_cpu_info();
 extern long long get_program_size();
 
+#ifdef __linux__
+int main(int argc, char **argv)
+#else
 int main(void)
+#endif
 {
     double double_data = 55.00;
 
+#ifdef __linux__
+    /* EATL_LOG_TRACE=<file> records every calculation and event for lreplay */
+    const char *trace_path = getenv("EATL_LOG_TRACE");
+    if (trace_path != NULL && log_trace_start(trace_path) == -1)
+    {
+        return 1;
+    }
+
+    /* --load [options] runs the sensor load generator instead of the demo, see load-gen.h */
+    if (argc > 1 && strcmp(argv[1], "--load") == 0)
+    {
+        struct load_config load;
+        int result = load_gen_parse(&load, argc - 2, argv + 2) == 0 && load_gen_run(&load) == 0 ? 0 : 1;
+        log_trace_stop();
+        return result;
+    }
+#endif
+
     struct log_module module =
         {
             .module_name = MODULE_NAME,
@@ -43,29 +99,116 @@ int main(void)
     //get_cpu_info();
 #endif
 #ifdef __linux__
+    /* EATL_LOG_RING=<file> logs into a crash-safe ring after printing what the last run left there */
+    struct log_sink *ring = NULL;
+    const char *ring_path = getenv("EATL_LOG_RING");
+    if (ring_path != NULL)
+    {
+        if (access(ring_path, F_OK) == 0)
+        {
+            log_ring_recover(ring_path, print_recovered, NULL);
+        }
+        ring = log_sink_mmap_ring(ring_path, 1024 * 1024);
+        log_set_sink(ring);
+    }
+
+    /* EATL_LOG_SHM=<name> publishes into the machine wide ring drained by lcollect */
+    struct log_sink *shm_sink = NULL;
+    const char *shm_name = getenv("EATL_LOG_SHM");
+    if (shm_name != NULL && (shm_sink = log_sink_shm(shm_name)) != NULL)
+    {
+        log_set_sink(shm_sink);
+    }
+
+    /* EATL_LOG_STAGE=cpu stages records in per-CPU shards, EATL_LOG_STAGE=thread in per-thread buffers */
+    const char *stage = getenv("EATL_LOG_STAGE");
+    if (stage != NULL && strcmp(stage, "cpu") == 0)
+    {
+        log_stage_start_sharded(10);
+    }
+    else if (stage != NULL && strcmp(stage, "thread") == 0)
+    {
+        log_stage_start(10);
+    }
+
     return_linux_memory_usage();
     get_program_size();
     get_cpu_info();
 #endif
 
+    /* Calculation results go to a compressed telemetry series; the sample number is the timestamp */
+    struct telemetry_channel results;
+    telemetry_channel_init(&results, TELEMETRY_INTEGER, print_telemetry_block, NULL);
+
     int a = 250000;
     int b = 500000;
 
-    perform_calculation(&module, a, b); /* This very obviously exceeds the maximum threshold */
+    telemetry_log_integer(&results, 0, perform_calculation(&module, a, b)); /* This very obviously exceeds the maximum threshold */
 
     a = 1;
     b = 11;
 
-    perform_calculation(&module, a, b); /* This should be within the two thresholds */
+    telemetry_log_integer(&results, 1, perform_calculation(&module, a, b)); /* This should be within the two thresholds */
 
     a = 0;
     b = 1;
 
-    perform_calculation(&module, a, b); /* This should fall below the minimum threshold */
+    telemetry_log_integer(&results, 2, perform_calculation(&module, a, b)); /* This should fall below the minimum threshold */
+
+    telemetry_channel_flush(&results);
+
+    /* A burst of samples is summarized per window instead of raising an event for each one */
+    struct log_aggregate aggregate;
+    if (log_aggregate_init(&aggregate, 500, 0, NULL, NULL, NULL) == 0)
+    {
+        module.aggregate = &aggregate;
+        for (long long sample = 0; sample < 1000; sample++)
+        {
+            perform_calculation(&module, sample, sample);
+        }
+        log_aggregate_flush(&module);
+        module.aggregate = NULL;
+    }
+
+    /* A noisy signal on the maximum raises one edge triggered event instead of one per sample */
+    struct log_thresholds limits;
+    if (log_thresholds_init(&limits, CALCULATION_MINIMUM, CALCULATION_MAXIMUM, 1000, LOG_TRIGGER_EDGE) == 0)
+    {
+        module.thresholds = &limits;
+        for (int sample = 0; sample < 100; sample++)
+        {
+            perform_calculation(&module, CALCULATION_MAXIMUM + (sample % 2 ? 200 : -200), 1);
+        }
+        module.thresholds = NULL;
+    }
+
+    /* A hot path beyond the maximum delivers about 100 events per second, each tagged with its 1/N */
+    module.sample_budget = 100;
+    for (long sample = 0; sample < 2000000; sample++)
+    {
+        perform_calculation(&module, CALCULATION_MAXIMUM, 2);
+    }
+    module.sample_budget = 0;
+
+#ifdef __linux__
+    log_trace_stop();
+    log_stage_stop();
+    log_set_sink(NULL);
+    log_sink_close(shm_sink);
+    log_sink_close(ring);
+#endif
 
     return 0x000;
 }
 
+#ifdef __linux__
+static void print_recovered(uint64_t sequence, const char *data, size_t length, void *context)
+{
+    (void)context;
+    printf("[recovered %llu] %.*s", (unsigned long long)sequence, (int)length, data);
+}
+#endif
+
 void call_custom_callback(const char *message)
 {
     printf("%s: Callback message: %s\n", MODULE_NAME, message);
@@ -0,0 +1,405 @@
+/**
+ * @file load-gen.c
+ * @brief Simulated sensor load with latency and throughput histograms
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#define _GNU_SOURCE
+
+/* System includes */
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Local includes */
+#include "../../../src/log-aggregate.h"
+#include "load-gen.h"
+
+#define NS_PER_SECOND 1000000000ull
+
+/* One simulated sensor and everything measured on its thread */
+struct load_sensor
+{
+    struct log_module module;
+    char name[MAX_MODULE_NAME_LENGTH];
+    const struct load_config *config;
+    pthread_t thread;
+    uint64_t random;                      /* xorshift64* state */
+    uint64_t due;                         /* When the sample being delivered was due */
+    uint64_t samples;
+    uint64_t late;                        /* Samples drawn after the next one was already due */
+    double latency_sum;
+    struct log_aggregate_summary latency; /* Due time to callback return, in ns */
+    uint32_t *slots;                      /* Callbacks returned in each LOAD_GEN_SLOT_MS slot */
+};
+
+static __thread struct load_sensor *current_sensor;
+static uint64_t load_start;
+static uint64_t load_end;
+static unsigned load_slots;
+
+static const char *const distribution_names[] = {"uniform", "normal", "spike"};
+
+static uint64_t next_random(struct load_sensor *sensor)
+{
+    sensor->random ^= sensor->random >> 12;
+    sensor->random ^= sensor->random << 25;
+    sensor->random ^= sensor->random >> 27;
+    return sensor->random * 0x2545F4914F6CDD1Dull;
+}
+
+static long long draw_value(struct load_sensor *sensor)
+{
+    switch (sensor->config->distribution)
+    {
+    case LOAD_NORMAL:
+    {
+        /* Sum of four uniforms, close enough to a bell without libm */
+        long long value = 0;
+        for (int i = 0; i < 4; i++)
+        {
+            value += (long long)(next_random(sensor) % (CALCULATION_MAXIMUM / 4 + 1));
+        }
+        return value;
+    }
+    case LOAD_SPIKE:
+        if (next_random(sensor) % 100 == 0)
+        {
+            return CALCULATION_MAXIMUM * 10LL;
+        }
+        return CALCULATION_MINIMUM + 1 +
+               (long long)(next_random(sensor) % (CALCULATION_MAXIMUM - CALCULATION_MINIMUM - 1));
+    case LOAD_UNIFORM:
+    default:
+        return (long long)(next_random(sensor) % (2 * CALCULATION_MAXIMUM + 1));
+    }
+}
+
+static void record_latency(struct log_aggregate_summary *summary, long long latency)
+{
+    if (summary->count == 0 || latency < summary->min)
+    {
+        summary->min = latency;
+    }
+    if (summary->count == 0 || latency > summary->max)
+    {
+        summary->max = latency;
+    }
+    summary->count++;
+    summary->histogram[log_aggregate_bucket(latency)]++;
+}
+
+/* Delivery of an event: the record is written, then the sample's latency is taken */
+static void sensor_callback(const char *message)
+{
+    struct load_sensor *sensor = current_sensor;
+
+    log_printf("%s: Callback message: %s", sensor->module.module_name, message);
+
+    uint64_t now = log_aggregate_clock_ns();
+    long long latency = now > sensor->due ? (long long)(now - sensor->due) : 0;
+    record_latency(&sensor->latency, latency);
+    sensor->latency_sum += (double)latency;
+    if (now >= load_start && now < load_end)
+    {
+        sensor->slots[(now - load_start) / (LOAD_GEN_SLOT_MS * 1000000ull)]++;
+    }
+}
+
+static void *sensor_main(void *arg)
+{
+    struct load_sensor *sensor = arg;
+    uint64_t interval = sensor->config->rate > 0 ? NS_PER_SECOND / sensor->config->rate : 0;
+
+    current_sensor = sensor;
+
+    /* Sensors start out of phase, as they would in the field */
+    uint64_t due = load_start + (interval > 0 ? next_random(sensor) % interval : 0);
+    for (;;)
+    {
+        uint64_t now = log_aggregate_clock_ns();
+        if (interval == 0)
+        {
+            due = now;
+        }
+        else if (now < due)
+        {
+            struct timespec wake = {
+                .tv_sec = (time_t)(due / NS_PER_SECOND),
+                .tv_nsec = (long)(due % NS_PER_SECOND),
+            };
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL);
+        }
+        else if (now - due >= interval)
+        {
+            sensor->late++;
+        }
+        if (due >= load_end)
+        {
+            break;
+        }
+
+        sensor->due = due;
+        perform_calculation(&sensor->module, draw_value(sensor), 1);
+        sensor->samples++;
+        due += interval;
+    }
+    return NULL;
+}
+
+/* Prints the occupied buckets of a histogram, each with a bar scaled to the fullest one */
+static void print_histogram(const struct log_aggregate_summary *summary, const char *unit)
+{
+    uint32_t fullest = 0;
+
+    for (int bucket = 0; bucket < LOG_AGGREGATE_BUCKETS; bucket++)
+    {
+        if (summary->histogram[bucket] > fullest)
+        {
+            fullest = summary->histogram[bucket];
+        }
+    }
+    for (int bucket = 0; bucket < LOG_AGGREGATE_BUCKETS && fullest > 0; bucket++)
+    {
+        if (summary->histogram[bucket] == 0)
+        {
+            continue;
+        }
+        int width = (int)(40ull * summary->histogram[bucket] / fullest);
+        printf("  %12lld %-6s %10u |%.*s\n", log_aggregate_bucket_floor(bucket), unit, summary->histogram[bucket],
+               width > 0 ? width : 1, "########################################");
+    }
+}
+
+static void print_percentiles(const struct log_aggregate_summary *summary, const char *unit)
+{
+    printf("  min %lld, p50 %lld, p90 %lld, p99 %lld, p99.9 %lld, max %lld %s\n", summary->min,
+           log_aggregate_percentile(summary, 50.0), log_aggregate_percentile(summary, 90.0),
+           log_aggregate_percentile(summary, 99.0), log_aggregate_percentile(summary, 99.9), summary->max, unit);
+}
+
+static void print_report(const struct load_config *config, struct load_sensor *sensors)
+{
+    struct log_aggregate_summary latency;
+    struct log_aggregate_summary throughput;
+    uint64_t samples = 0;
+    uint64_t late = 0;
+    double latency_sum = 0.0;
+
+    memset(&latency, 0, sizeof(latency));
+    memset(&throughput, 0, sizeof(throughput));
+    for (unsigned i = 0; i < config->modules; i++)
+    {
+        const struct log_aggregate_summary *own = &sensors[i].latency;
+        if (own->count > 0)
+        {
+            if (latency.count == 0 || own->min < latency.min)
+            {
+                latency.min = own->min;
+            }
+            if (latency.count == 0 || own->max > latency.max)
+            {
+                latency.max = own->max;
+            }
+        }
+        latency.count += own->count;
+        for (int bucket = 0; bucket < LOG_AGGREGATE_BUCKETS; bucket++)
+        {
+            latency.histogram[bucket] += own->histogram[bucket];
+        }
+        samples += sensors[i].samples;
+        late += sensors[i].late;
+        latency_sum += sensors[i].latency_sum;
+    }
+
+    /* Throughput of every slot, scaled to events per second */
+    uint64_t delivered = 0;
+    for (unsigned slot = 0; slot < load_slots; slot++)
+    {
+        uint64_t events = 0;
+        for (unsigned i = 0; i < config->modules; i++)
+        {
+            events += sensors[i].slots[slot];
+        }
+        delivered += events;
+        record_latency(&throughput, (long long)(events * 1000 / LOAD_GEN_SLOT_MS));
+    }
+
+    printf("Load: %u sensors at %u Hz each, %s values, %u s\n", config->modules, config->rate,
+           distribution_names[config->distribution], config->seconds);
+    printf("Samples: %llu, callbacks: %llu, late samples: %llu\n", (unsigned long long)samples,
+           (unsigned long long)latency.count, (unsigned long long)late);
+    printf("Sustained throughput: %.0f events/s\n", (double)delivered / config->seconds);
+
+    printf("Latency, sample due to callback return (mean %.0f ns):\n",
+           latency.count > 0 ? latency_sum / latency.count : 0.0);
+    print_percentiles(&latency, "ns");
+    print_histogram(&latency, "ns");
+
+    printf("Throughput per %u ms slot, in events/s:\n", LOAD_GEN_SLOT_MS);
+    print_percentiles(&throughput, "events/s");
+    print_histogram(&throughput, "ev/s");
+}
+
+int load_gen_parse(struct load_config *config, int argc, char **argv)
+{
+    config->modules = 4;
+    config->rate = 1000;
+    config->seconds = 5;
+    config->distribution = LOAD_UNIFORM;
+    config->sink = "null";
+
+    for (int i = 0; i < argc; i++)
+    {
+        const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+        if (value == NULL)
+        {
+            fprintf(stderr, "Missing value for %s\n", argv[i]);
+            return -1;
+        }
+        if (strcmp(argv[i], "--modules") == 0)
+        {
+            config->modules = (unsigned)strtoul(value, NULL, 10);
+        }
+        else if (strcmp(argv[i], "--rate") == 0)
+        {
+            config->rate = (unsigned)strtoul(value, NULL, 10);
+        }
+        else if (strcmp(argv[i], "--seconds") == 0)
+        {
+            config->seconds = (unsigned)strtoul(value, NULL, 10);
+        }
+        else if (strcmp(argv[i], "--distribution") == 0)
+        {
+            unsigned kind = 0;
+            while (kind < sizeof(distribution_names) / sizeof(distribution_names[0]) &&
+                   strcmp(value, distribution_names[kind]) != 0)
+            {
+                kind++;
+            }
+            if (kind == sizeof(distribution_names) / sizeof(distribution_names[0]))
+            {
+                fprintf(stderr, "Unknown distribution %s\n", value);
+                return -1;
+            }
+            config->distribution = (enum load_distribution)kind;
+        }
+        else if (strcmp(argv[i], "--sink") == 0)
+        {
+            config->sink = value;
+        }
+        else
+        {
+            fprintf(stderr, "Unknown load option %s\n", argv[i]);
+            return -1;
+        }
+        i++;
+    }
+    if (config->modules == 0 || config->modules > LOAD_GEN_MAX_MODULES || config->seconds == 0)
+    {
+        fprintf(stderr, "Load needs 1 to %d modules and at least one second\n", LOAD_GEN_MAX_MODULES);
+        return -1;
+    }
+    return 0;
+}
+
+int load_gen_run(const struct load_config *config)
+{
+    struct log_sink *sink = NULL;
+    int result = -1;
+
+    if (strcmp(config->sink, "stdout") != 0)
+    {
+        sink = log_sink_file(strcmp(config->sink, "null") == 0 ? "/dev/null" : config->sink);
+        if (sink == NULL)
+        {
+            return -1;
+        }
+        log_set_sink(sink);
+    }
+
+    load_slots = config->seconds * (1000 / LOAD_GEN_SLOT_MS);
+    struct load_sensor *sensors = calloc(config->modules, sizeof(*sensors));
+    uint32_t *slots = calloc((size_t)config->modules * load_slots, sizeof(*slots));
+    if (sensors == NULL || slots == NULL)
+    {
+        fprintf(stderr, "Memory allocation failed.\n");
+        goto out;
+    }
+
+    /* The clock starts after a lead long enough for every sensor thread to be up */
+    load_start = log_aggregate_clock_ns() + 50000000ull;
+    load_end = load_start + config->seconds * NS_PER_SECOND;
+
+    unsigned started = 0;
+    for (; started < config->modules; started++)
+    {
+        struct load_sensor *sensor = &sensors[started];
+        snprintf(sensor->name, sizeof(sensor->name), "SENSOR-%02u", started);
+        sensor->module.module_name = sensor->name;
+        sensor->module.callback = sensor_callback;
+        sensor->config = config;
+        sensor->random = 0x9E3779B97F4A7C15ull * (started + 1);
+        sensor->slots = &slots[(size_t)started * load_slots];
+        if (pthread_create(&sensor->thread, NULL, sensor_main, sensor) != 0)
+        {
+            fprintf(stderr, "Could not start sensor %u\n", started);
+            break;
+        }
+    }
+    for (unsigned i = 0; i < started; i++)
+    {
+        pthread_join(sensors[i].thread, NULL);
+    }
+    if (started == config->modules)
+    {
+        result = 0;
+    }
+
+    if (result == 0)
+    {
+        log_flush();
+        print_report(config, sensors);
+    }
+
+out:
+    log_set_sink(NULL);
+    log_sink_close(sink);
+    free(slots);
+    free(sensors);
+    return result;
+}
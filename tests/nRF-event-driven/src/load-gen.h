@@ -0,0 +1,91 @@
+/**
+ * @file load-gen.h
+ * @brief Sensor load generator declarations
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef load_gen_h_
+#define load_gen_h_
+
+#include "../../../src/common/logger.h"
+
+#define LOAD_GEN_MAX_MODULES 64
+#define LOAD_GEN_SLOT_MS 100 /* Throughput is sampled over slots of this length */
+
+/**
+ * @brief How the simulated sensor values are drawn
+ */
+enum load_distribution
+{
+    LOAD_UNIFORM = 0, /* Flat over [0, 2 * CALCULATION_MAXIMUM] */
+    LOAD_NORMAL,      /* Bell around CALCULATION_MAXIMUM / 2, rarely beyond a threshold */
+    LOAD_SPIKE        /* Within both thresholds, with 1% of samples far above the maximum */
+};
+
+/**
+ * @brief Load to generate, parsed from the command line by load_gen_parse()
+ */
+struct load_config
+{
+    unsigned modules;                   /* Simulated sensors, one thread and log_module each */
+    unsigned rate;                      /* Samples per second per sensor, 0 for as fast as possible */
+    unsigned seconds;                   /* Run time */
+    enum load_distribution distribution;
+    const char *sink;                   /* "null" (default), "stdout" or a file path for the records */
+};
+
+/**
+ * @brief Parses the load generator options following --load
+ *
+ * --modules N, --rate HZ, --seconds S, --distribution uniform|normal|spike, --sink null|stdout|<path>
+ *
+ * @param[out] config Options, defaults for any not given
+ * @param[in]  argc   Argument count
+ * @param[in]  argv   Arguments, starting after --load
+ * @return int | 0 for success -1 for failure
+ */
+int load_gen_parse(struct load_config *config, int argc, char **argv);
+
+/**
+ * @brief Runs the simulated sensors and prints their latency and throughput histograms
+ *
+ * Every sensor feeds its own log_module through perform_calculation() on its own thread, at a fixed
+ * rate. Latency runs from the time a sample was due to the return of the module's callback, so a
+ * sensor that falls behind its schedule is charged for the wait as well.
+ *
+ * @param[in] config Load to generate
+ * @return int | 0 for success -1 for failure
+ */
+int load_gen_run(const struct load_config *config);
+
+#endif /* load_gen_h_ */
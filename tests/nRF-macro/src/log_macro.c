@@ -6,6 +6,7 @@
 #endif
 #ifdef __linux__
 #include <sys/resource.h>
+#include "../../../src/log-shm.h"
 #endif
 
 int main(void)
@@ -16,6 +17,14 @@ int main(void)
     return_windows_memory_usage();
 #endif
 #ifdef __linux__
+    /* EATL_LOG_SHM=<name> publishes into the machine wide ring drained by lcollect */
+    struct log_sink *shm_sink = NULL;
+    const char *shm_name = getenv("EATL_LOG_SHM");
+    if (shm_name != NULL && (shm_sink = log_sink_shm(shm_name)) != NULL)
+    {
+        log_set_sink(shm_sink);
+    }
+
     return_linux_memory_usage();
 #endif
 
@@ -23,5 +32,10 @@ int main(void)
     LOG_WARNING(WARNING, "Example of LOG WARNING macro");
     LOG_ERROR(CRITICAL, "Example of LOG ERROR macro");
 
+#ifdef __linux__
+    log_set_sink(NULL);
+    log_sink_close(shm_sink);
+#endif
+
     return 0x000;
 }
\ No newline at end of file
@@ -0,0 +1,132 @@
+/**
+ * @file boot.c
+ * @brief Boots RAM-FS from an image generated at build time and logs into it
+ *
+ * @date October 18th, 2026
+ *
+ * @copyright Copyright (c) 2026 Lukas R. Jackson
+ *
+ * @author Lukas R. Jackson (LukasJacksonEG@gmail.com) | (LukeTheEngineer)
+ *
+ * @license BSD-3-Clause License
+ *          Redistribution and use in source and binary forms, with or without
+ *          modification, are permitted provided that the following conditions are met:
+ *
+ *          1. Redistributions of source code must retain the above copyright notice,
+ *             this list of conditions and the following disclaimer.
+ *
+ *          2. Redistributions in binary form must reproduce the above copyright notice,
+ *             this list of conditions and the following disclaimer in the documentation
+ *             and/or other materials provided with the distribution.
+ *
+ *          3. Neither the name of the copyright holder nor the names of its
+ *             contributors may be used to endorse or promote products derived from
+ *             this software without specific prior written permission.
+ *
+ *          THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *          AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *          IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *          DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ *          FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ *          DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ *          SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *          CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ *          OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *          OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* System includes */
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Local includes */
+#include "../../src/ram-fs.h"
+#include "../../src/ram-fs-zone.h"
+
+extern const struct ram_fs_image ram_fs_image; /* Generated by lmkfs from image.manifest */
+
+static Directory *find_dir(Directory *dir, const char *name)
+{
+    dir = ram_fs_dir(dir);
+    for (int i = 0; i < dir->num_subdirs; i++)
+    {
+        if (strcmp(ram_fs_dir(dir->subdirs[i])->name, name) == 0)
+        {
+            return dir->subdirs[i];
+        }
+    }
+    return NULL;
+}
+
+static File *find_file(Directory *dir, const char *name)
+{
+    dir = ram_fs_dir(dir);
+    for (int i = 0; dir != NULL && i < dir->num_files; i++)
+    {
+        if (strcmp(ram_fs_file(dir->files[i])->name, name) == 0)
+        {
+            return dir->files[i];
+        }
+    }
+    return NULL;
+}
+
+static void print_record(const File *file, uint64_t timestamp, enum log_level level, const char *message,
+                         size_t length, void *context)
+{
+    (void)level;
+    printf("%s: %" PRIu64 " %.*s\n", file->name, timestamp, (int)length, message);
+    (*(long *)context)++;
+}
+
+static int promoted_files(void)
+{
+    int count = 0;
+
+    for (int i = 0; i < ram_fs_image.num_files; i++)
+    {
+        count += ram_fs_image.promoted_files[i] != NULL;
+    }
+    return count;
+}
+
+int main(void)
+{
+    /* Boot: the tree is already linked in .rodata, so nothing is built, copied or allocated */
+    if (init_filesystem_image(&ram_fs_image) == -1)
+    {
+        return 1;
+    }
+
+    File *boot = find_file(log_cache, "boot.log");
+    File *serial = find_file(find_dir(root_dir, "config"), "serial");
+    if (boot == NULL || serial == NULL)
+    {
+        fprintf(stderr, "ram-fs-image: image is missing boot.log or config/serial\n");
+        return 1;
+    }
+    ls_dir(log_cache);
+
+    /* Reading the image leaves it in .rodata */
+    long before = 0;
+    query_log_cache(0, UINT64_MAX, LOG_LEVEL_ALL, print_record, &before);
+
+    /* The first write promotes boot.log alone to RAM; the handle from the image keeps working */
+    if (append_log_record(boot, LOG_LEVEL_INFO, 1, "woke up") == -1)
+    {
+        return 1;
+    }
+    long after = 0;
+    query_log_records(boot, 0, UINT64_MAX, LOG_LEVEL_ALL, print_record, &after);
+
+    /* Restricted files stay in the image */
+    int refused = write_to_file(serial, "tampered") == -1;
+
+    printf("ram-fs-image: %ld records at boot, %ld after waking, %d of %d files promoted\n", before, after,
+           promoted_files(), ram_fs_image.num_files);
+    int passed = before == 1 && after == 2 && refused && promoted_files() == 1 && ram_fs_file(boot) != boot;
+    deinit_filesystem();
+    printf("ram-fs-image: %s\n", passed ? "passed" : "FAILED");
+    return passed ? 0 : 1;
+}